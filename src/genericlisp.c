@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <sysexits.h>
+#include <unistd.h>
 #endif
 
 
@@ -22,9 +23,18 @@ LISP_EXTERN int genericlisp_main(int argc, char **argv);
 
 static int genericlisp_done = 0;
 
+/** The size of the heap of each virtual machine, unless a batch is given another. */
+#define GENERICLISP_HEAP_SIZE (1024 * 1024)
+
+/** The smallest heap a batch can be given, which has room for the root environment. */
+#define GENERICLISP_MINIMUM_HEAP_SIZE (256 * 1024)
+
 static void lisp_print_banner(lisp_object_t environment);
 static void lisp_print_prompt(lisp_object_t environment);
 static void lisp_run_repl(lisp_object_t environment);
+#if LISP_USE_STDLIB
+static int genericlisp_run_batch(int argc, char **argv);
+#endif
 
 /* Cached string to represent a newline. */
 static lisp_object_t lisp_string_newline = NULL;
@@ -32,18 +42,22 @@ static lisp_object_t lisp_string_newline = NULL;
 
 int main(int argc, char **argv)
 {
-    /* Do not use any Lisp objects at all before this point. */
+#if LISP_USE_STDLIB
+    /* Given any arguments, evaluate a batch instead of running the REPL. */
+    if (argc > 1) {
+        return genericlisp_run_batch(argc, argv);
+    }
+#endif
 
-    lisp_heap_initialize(1024 * 1024);
+    /* Do not use any Lisp objects at all before this point. */
 
     /*
-     At this point there is a Lisp heap, but not a Lisp environment. Only
-     certain things can be done in this state. In particular, nothing must
-     *care about* references to T or NIL until the root environment is
-     established.
+     The virtual machine has its own Lisp heap and root environment, and
+     stays current for the rest of the program.
      */
 
-    lisp_object_t root_environment = lisp_environment_create_root();
+    lisp_vm_t vm = lisp_vm_create(GENERICLISP_HEAP_SIZE);
+    lisp_object_t root_environment = lisp_vm_get_environment(vm);
 
     /* Create a child environment for non-root bindings to go into. */
 
@@ -72,10 +86,11 @@ int main(int argc, char **argv)
      */
 
     lisp_environment_dispose(environment);
+    lisp_vm_dispose(vm);
 
     /*
-     No more Lisp references once again after this point, as the root
-     environment is no longer available.
+     No more Lisp references once again after this point, as the virtual
+     machine is no longer available.
      */
 
     return EX_OK;
@@ -130,3 +145,87 @@ void lisp_run_repl(lisp_object_t environment)
 
     lisp_print(environment, lisp_T, eval_obj);
 }
+
+
+#if LISP_USE_STDLIB
+
+/**
+ Evaluate the files named on the command line as a batch, spread across
+ worker threads, writing their output in order to standard output:
+
+     genericlisp [-j workers] [-m heap-bytes] [-f] [-l shared-file] file ...
+
+ By default each file is a job, there's a worker per processor, and each
+ virtual machine has a heap of `GENERICLISP_HEAP_SIZE` bytes. With
+ `-f` there must be only one file, and each of its top-level forms is a
+ job whose value is printed after its output. With `-l`, the shared file
+ is loaded first into a virtual machine that's frozen and shared by every
+ worker, so what it defines is available to every job without a copy per
+ worker.
+ */
+int genericlisp_run_batch(int argc, char **argv)
+{
+    lisp_batch_mode_t mode = lisp_batch_mode_files;
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned long long heap_size = GENERICLISP_HEAP_SIZE;
+    const char *shared_path = NULL;
+
+    int option;
+    while ((option = getopt(argc, argv, "fj:l:m:")) != -1) {
+        switch (option) {
+            case 'f':
+                mode = lisp_batch_mode_forms;
+                break;
+
+            case 'j':
+                workers = strtol(optarg, NULL, 10);
+                break;
+
+            case 'l':
+                shared_path = optarg;
+                break;
+
+            case 'm':
+                heap_size = strtoull(optarg, NULL, 10);
+                break;
+
+            default:
+                workers = 0;
+                break;
+        }
+    }
+
+    const int path_count = argc - optind;
+    if ((workers < 1) || (heap_size < GENERICLISP_MINIMUM_HEAP_SIZE) || (heap_size > UINTPTR_MAX)
+        || (path_count < 1) || ((mode == lisp_batch_mode_forms) && (path_count != 1)))
+    {
+        fprintf(stderr, "usage: genericlisp [-j workers] [-m heap-bytes] [-f] [-l shared-file] file ...\n");
+        return EX_USAGE;
+    }
+
+    lisp_vm_t shared = NULL;
+    if (shared_path != NULL) {
+        shared = lisp_batch_load_shared(shared_path, (uintptr_t)heap_size);
+        if (shared == NULL) {
+            fprintf(stderr, "%s: can't be read\n", shared_path);
+            return EX_NOINPUT;
+        }
+    }
+
+    uintptr_t failures = lisp_batch_evaluate(mode,
+                                             (const char * const *)&argv[optind],
+                                             (uintptr_t)path_count,
+                                             (uintptr_t)workers,
+                                             (uintptr_t)heap_size,
+                                             shared,
+                                             stdout,
+                                             stderr);
+
+    if (shared != NULL) {
+        lisp_vm_dispose(shared);
+    }
+
+    return (failures == 0) ? EX_OK : EX_NOINPUT;
+}
+
+#endif /* LISP_USE_STDLIB */
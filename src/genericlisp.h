@@ -13,11 +13,16 @@
 #include "lisp_types.h"
 #include "lisp_utilities.h"
 
+#include "lisp_array.h"
 #include "lisp_atom.h"
+#include "lisp_batch.h"
+#include "lisp_binary.h"
 #include "lisp_cell.h"
 #include "lisp_environment.h"
 #include "lisp_evaluation.h"
 #include "lisp_fixnum.h"
+#include "lisp_hash_table.h"
+#include "lisp_image.h"
 #include "lisp_interior.h"
 #include "lisp_memory.h"
 #include "lisp_plist.h"
@@ -27,7 +32,9 @@
 #include "lisp_string.h"
 #include "lisp_struct.h"
 #include "lisp_subr.h"
+#include "lisp_symbol_table.h"
 #include "lisp_vector.h"
+#include "lisp_vm.h"
 
 
 #endif /* __genericlisp__ */
@@ -0,0 +1,307 @@
+/*
+    File:       lisp_array.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include "lisp_array.h"
+
+#include "lisp_atom.h"
+#include "lisp_environment.h"
+#include "lisp_interior.h"
+#include "lisp_string.h"
+#include "lisp_struct.h"
+
+#if LISP_USE_STDLIB
+#include <stdio.h>
+#include <string.h>
+#endif
+
+
+/** Get the size in bytes of one element of the given type. */
+static uintptr_t lisp_array_element_size(lisp_array_type_t type)
+{
+    switch (type) {
+        case lisp_array_type_u8:  return sizeof(uint8_t);
+        case lisp_array_type_i32: return sizeof(int32_t);
+        case lisp_array_type_i64: return sizeof(int64_t);
+        case lisp_array_type_f64: return sizeof(double);
+    }
+    return 0;
+}
+
+/** Get the name of the given type, as its keyword. */
+static const char *lisp_array_type_name(lisp_array_type_t type)
+{
+    switch (type) {
+        case lisp_array_type_u8:  return ":U8";
+        case lisp_array_type_i32: return ":I32";
+        case lisp_array_type_i64: return ":I64";
+        case lisp_array_type_f64: return ":F64";
+    }
+    return "";
+}
+
+
+lisp_object_t lisp_array_create(lisp_array_type_t type,
+                                uintptr_t count)
+{
+    const uintptr_t element_size = lisp_array_element_size(type);
+    const uintptr_t size = element_size * count;
+
+    /* Always allocate at least one element so the storage is distinct. */
+    void *elements;
+    lisp_interior_create((size > 0) ? size : element_size, &elements);
+    memset(elements, 0, size);
+
+    return lisp_struct_create(elements, size, (uintptr_t) type);
+}
+
+
+lisp_array_type_t lisp_array_type_for_keyword(lisp_object_t keyword)
+{
+    if (lisp_atomp(keyword) == lisp_NIL) {
+        return 0;
+    }
+
+    const char *name = lisp_atom_get_value(keyword);
+    const lisp_array_type_t types[] = {
+        lisp_array_type_u8,
+        lisp_array_type_i32,
+        lisp_array_type_i64,
+        lisp_array_type_f64,
+    };
+    for (uintptr_t i = 0; i < (sizeof(types) / sizeof(types[0])); i++) {
+        if (strcmp(name, lisp_array_type_name(types[i])) == 0) {
+            return types[i];
+        }
+    }
+
+    return 0;
+}
+
+
+lisp_object_t lisp_arrayp(lisp_object_t object)
+{
+    if (lisp_structp(object) == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    lisp_struct_t struct_value = lisp_struct_get_value(object);
+    if (lisp_array_element_size((lisp_array_type_t) struct_value->type) == 0) {
+        return lisp_NIL;
+    }
+
+    return lisp_T;
+}
+
+
+lisp_array_type_t lisp_array_get_type(lisp_object_t array)
+{
+    lisp_struct_t struct_value = lisp_struct_get_value(array);
+    return (lisp_array_type_t) struct_value->type;
+}
+
+
+uintptr_t lisp_array_count(lisp_object_t array)
+{
+    lisp_struct_t struct_value = lisp_struct_get_value(array);
+    return struct_value->size / lisp_array_element_size((lisp_array_type_t) struct_value->type);
+}
+
+
+lisp_object_t lisp_array_ref(lisp_object_t array,
+                             uintptr_t index)
+{
+    if (index >= lisp_array_count(array)) {
+        return lisp_NIL;
+    }
+
+    lisp_struct_t struct_value = lisp_struct_get_value(array);
+    lisp_fixnum_t value = 0;
+    switch ((lisp_array_type_t) struct_value->type) {
+        case lisp_array_type_u8:  value = ((uint8_t *)struct_value->value)[index]; break;
+        case lisp_array_type_i32: value = ((int32_t *)struct_value->value)[index]; break;
+        case lisp_array_type_i64: value = (lisp_fixnum_t) ((int64_t *)struct_value->value)[index]; break;
+        case lisp_array_type_f64: value = (lisp_fixnum_t) ((double *)struct_value->value)[index]; break;
+    }
+
+    return lisp_fixnum_create(value);
+}
+
+
+lisp_object_t lisp_array_set(lisp_object_t array,
+                             uintptr_t index,
+                             lisp_object_t value)
+{
+    if ((index >= lisp_array_count(array)) || (lisp_fixnump(value) == lisp_NIL)) {
+        return lisp_NIL;
+    }
+
+    lisp_struct_t struct_value = lisp_struct_get_value(array);
+    lisp_fixnum_t fixnum_value = lisp_fixnum_get_value(value);
+    switch ((lisp_array_type_t) struct_value->type) {
+        case lisp_array_type_u8:  ((uint8_t *)struct_value->value)[index] = (uint8_t) fixnum_value; break;
+        case lisp_array_type_i32: ((int32_t *)struct_value->value)[index] = (int32_t) fixnum_value; break;
+        case lisp_array_type_i64: ((int64_t *)struct_value->value)[index] = (int64_t) fixnum_value; break;
+        case lisp_array_type_f64: ((double *)struct_value->value)[index] = (double) fixnum_value; break;
+    }
+
+    return value;
+}
+
+
+/*
+ The bulk operations below are written as simple loops over one element
+ type at a time, without aliasing, so that the compiler can vectorize
+ them.
+ */
+
+/** Fill `count` elements of type `element_t` at `elements` with `value`. */
+#define LISP_ARRAY_FILL(element_t, elements, count, value) \
+    do { \
+        element_t *restrict e = (element_t *) (elements); \
+        const element_t v = (element_t) (value); \
+        for (uintptr_t i = 0; i < (count); i++) { \
+            e[i] = v; \
+        } \
+    } while (0)
+
+void lisp_array_fill(lisp_object_t array,
+                     lisp_fixnum_t value)
+{
+    lisp_struct_t struct_value = lisp_struct_get_value(array);
+    const uintptr_t count = lisp_array_count(array);
+
+    switch ((lisp_array_type_t) struct_value->type) {
+        case lisp_array_type_u8:  LISP_ARRAY_FILL(uint8_t, struct_value->value, count, value); break;
+        case lisp_array_type_i32: LISP_ARRAY_FILL(int32_t, struct_value->value, count, value); break;
+        case lisp_array_type_i64: LISP_ARRAY_FILL(int64_t, struct_value->value, count, value); break;
+        case lisp_array_type_f64: LISP_ARRAY_FILL(double, struct_value->value, count, value); break;
+    }
+}
+
+
+uintptr_t lisp_array_replace(lisp_object_t destination,
+                             lisp_object_t source)
+{
+    lisp_struct_t destination_value = lisp_struct_get_value(destination);
+    lisp_struct_t source_value = lisp_struct_get_value(source);
+    if (destination_value->type != source_value->type) {
+        return 0;
+    }
+
+    /* The arrays may be the same, so allow for overlap. */
+    const uintptr_t size = ((destination_value->size < source_value->size)
+                            ? destination_value->size
+                            : source_value->size);
+    memmove(destination_value->value, source_value->value, size);
+
+    return size / lisp_array_element_size((lisp_array_type_t) destination_value->type);
+}
+
+
+/** Sum `count` elements of type `element_t` at `elements` into `sum`. */
+#define LISP_ARRAY_SUM(element_t, sum_t, elements, count, sum) \
+    do { \
+        const element_t *restrict e = (const element_t *) (elements); \
+        sum_t s = 0; \
+        for (uintptr_t i = 0; i < (count); i++) { \
+            s += (sum_t) e[i]; \
+        } \
+        (sum) = (lisp_fixnum_t) s; \
+    } while (0)
+
+lisp_fixnum_t lisp_array_sum(lisp_object_t array)
+{
+    lisp_struct_t struct_value = lisp_struct_get_value(array);
+    const uintptr_t count = lisp_array_count(array);
+
+    /* Integers are summed as unsigned so that overflow wraps. */
+    lisp_fixnum_t sum = 0;
+    switch ((lisp_array_type_t) struct_value->type) {
+        case lisp_array_type_u8:  LISP_ARRAY_SUM(uint8_t, uint64_t, struct_value->value, count, sum); break;
+        case lisp_array_type_i32: LISP_ARRAY_SUM(int32_t, uint64_t, struct_value->value, count, sum); break;
+        case lisp_array_type_i64: LISP_ARRAY_SUM(int64_t, uint64_t, struct_value->value, count, sum); break;
+        case lisp_array_type_f64: LISP_ARRAY_SUM(double, double, struct_value->value, count, sum); break;
+    }
+
+    return sum;
+}
+
+
+/**
+ Combine `count` elements of type `element_t` at `a` and `b` into
+ `result` using `op`, doing arithmetic in `arithmetic_t`.
+ */
+#define LISP_ARRAY_MAP(element_t, arithmetic_t, op, result, a, b, count) \
+    do { \
+        element_t *restrict r = (element_t *) (result); \
+        const element_t *restrict x = (const element_t *) (a); \
+        const element_t *restrict y = (const element_t *) (b); \
+        for (uintptr_t i = 0; i < (count); i++) { \
+            r[i] = (element_t) ((arithmetic_t) x[i] op (arithmetic_t) y[i]); \
+        } \
+    } while (0)
+
+/** Combine arrays of all types using `op`. */
+#define LISP_ARRAY_MAP_TYPES(type, op, result, a, b, count) \
+    switch (type) { \
+        case lisp_array_type_u8:  LISP_ARRAY_MAP(uint8_t, uint32_t, op, result, a, b, count); break; \
+        case lisp_array_type_i32: LISP_ARRAY_MAP(int32_t, uint32_t, op, result, a, b, count); break; \
+        case lisp_array_type_i64: LISP_ARRAY_MAP(int64_t, uint64_t, op, result, a, b, count); break; \
+        case lisp_array_type_f64: LISP_ARRAY_MAP(double, double, op, result, a, b, count); break; \
+    }
+
+lisp_object_t lisp_array_map(lisp_array_operation_t operation,
+                             lisp_object_t a,
+                             lisp_object_t b)
+{
+    lisp_struct_t a_value = lisp_struct_get_value(a);
+    lisp_struct_t b_value = lisp_struct_get_value(b);
+    if (a_value->type != b_value->type) {
+        return lisp_NIL;
+    }
+
+    const lisp_array_type_t type = (lisp_array_type_t) a_value->type;
+    const uintptr_t a_count = lisp_array_count(a);
+    const uintptr_t b_count = lisp_array_count(b);
+    const uintptr_t count = (a_count < b_count) ? a_count : b_count;
+
+    lisp_object_t result = lisp_array_create(type, count);
+    lisp_struct_t result_value = lisp_struct_get_value(result);
+
+    switch (operation) {
+        case lisp_array_operation_add:
+            LISP_ARRAY_MAP_TYPES(type, +, result_value->value, a_value->value, b_value->value, count);
+            break;
+
+        case lisp_array_operation_subtract:
+            LISP_ARRAY_MAP_TYPES(type, -, result_value->value, a_value->value, b_value->value, count);
+            break;
+
+        case lisp_array_operation_multiply:
+            LISP_ARRAY_MAP_TYPES(type, *, result_value->value, a_value->value, b_value->value, count);
+            break;
+    }
+
+    return result;
+}
+
+
+lisp_object_t lisp_array_print(lisp_object_t stream,
+                               lisp_object_t array)
+{
+    /*
+     Print an array as #<ARRAY :TYPE COUNT>, our typical syntax for
+     anything that cannot be directly read.
+     */
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "#<ARRAY %s %llu>",
+             lisp_array_type_name(lisp_array_get_type(array)),
+             (unsigned long long) lisp_array_count(array));
+    lisp_object_t buffer_string = lisp_string_create_c(buffer);
+    lisp_string_t buffer_string_value = lisp_string_get_value(buffer_string);
+    return lisp_string_print_quoted(stream, buffer_string_value, lisp_NIL);
+}
@@ -0,0 +1,131 @@
+/*
+    File:       lisp_array.h
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#ifndef __lisp_array__
+#define __lisp_array__ 1
+
+
+#include "lisp_types.h"
+#include "lisp_fixnum.h"
+
+
+/**
+ A Lisp typed array represents a contiguous memory array of raw machine
+ numbers, all of the same type.
+
+ Unlike a vector, whose values are tagged Lisp objects, a typed array
+ holds unboxed numbers in an interior pointer. Its contents therefore
+ contain no references and are *not* subject to garbage collection, and
+ operations over them can run as tight loops over dense storage.
+
+ Typed arrays are represented as structs, whose type is the type of
+ their elements and whose size is the total size of their elements in
+ bytes.
+
+ Elements are converted to and from fixnums at the boundary with Lisp;
+ since there is no floating-point type, `f64` elements are truncated
+ when they're converted to fixnums.
+ */
+typedef enum lisp_array_type {
+    /** Unsigned 8-bit integers, `:U8`. */
+    lisp_array_type_u8  = 0x41525201,
+
+    /** Signed 32-bit integers, `:I32`. */
+    lisp_array_type_i32 = 0x41525202,
+
+    /** Signed 64-bit integers, `:I64`. */
+    lisp_array_type_i64 = 0x41525203,
+
+    /** 64-bit IEEE floating point numbers, `:F64`. */
+    lisp_array_type_f64 = 0x41525204,
+} lisp_array_type_t;
+
+/** An element-wise operation on typed arrays. */
+typedef enum lisp_array_operation {
+    lisp_array_operation_add,
+    lisp_array_operation_subtract,
+    lisp_array_operation_multiply,
+} lisp_array_operation_t;
+
+
+/**
+ Create a typed array of the given type holding the given number of
+ elements, all of which are zero.
+ */
+LISP_EXTERN lisp_object_t lisp_array_create(lisp_array_type_t type,
+                                            uintptr_t count);
+
+/**
+ Get the array type named by the given keyword (`:U8`, `:I32`, `:I64`,
+ or `:F64`).
+
+ - Returns: The type, or `0` if the keyword doesn't name one.
+ */
+LISP_EXTERN lisp_array_type_t lisp_array_type_for_keyword(lisp_object_t keyword);
+
+/** Indicate whether the given object is a typed array, `T` or `NIL`. */
+LISP_EXTERN lisp_object_t lisp_arrayp(lisp_object_t object);
+
+/** Get the type of the elements of the given typed array. */
+LISP_EXTERN lisp_array_type_t lisp_array_get_type(lisp_object_t array);
+
+/** Get the number of elements in the given typed array. */
+LISP_EXTERN uintptr_t lisp_array_count(lisp_object_t array);
+
+/**
+ Get the element at the given index in the typed array, as a fixnum.
+
+ - Returns: The element, or `NIL` if the index is out of range.
+ */
+LISP_EXTERN lisp_object_t lisp_array_ref(lisp_object_t array,
+                                         uintptr_t index);
+
+/**
+ Set the element at the given index in the typed array from a fixnum,
+ converting it to the array's element type.
+
+ - Returns: The value, or `NIL` if the index is out of range or the
+            value isn't a fixnum.
+ */
+LISP_EXTERN lisp_object_t lisp_array_set(lisp_object_t array,
+                                         uintptr_t index,
+                                         lisp_object_t value);
+
+/** Set every element in the typed array to the given value. */
+LISP_EXTERN void lisp_array_fill(lisp_object_t array,
+                                 lisp_fixnum_t value);
+
+/**
+ Copy as many elements as fit from one typed array to another of the
+ same type.
+
+ - Returns: The number of elements copied, which is `0` if the arrays
+            are of different types.
+ */
+LISP_EXTERN uintptr_t lisp_array_replace(lisp_object_t destination,
+                                         lisp_object_t source);
+
+/** Sum the elements in the typed array. */
+LISP_EXTERN lisp_fixnum_t lisp_array_sum(lisp_object_t array);
+
+/**
+ Apply an operation element-wise to two typed arrays of the same type,
+ producing a new array of that type as long as the shorter of the two.
+
+ - Returns: The new array, or `NIL` if the arrays are of different
+            types.
+ */
+LISP_EXTERN lisp_object_t lisp_array_map(lisp_array_operation_t operation,
+                                         lisp_object_t a,
+                                         lisp_object_t b);
+
+/** Prints the typed array to the given output stream. */
+LISP_EXTERN lisp_object_t lisp_array_print(lisp_object_t stream,
+                                           lisp_object_t array);
+
+
+#endif  /* __lisp_array__ */
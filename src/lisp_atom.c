@@ -10,6 +10,7 @@
 #include "lisp_environment.h"
 #include "lisp_interior.h"
 #include "lisp_memory.h"
+#include "lisp_stream.h"
 #include "lisp_string.h"
 
 #if LISP_USE_STDLIB
@@ -50,23 +51,30 @@ lisp_object_t lisp_atom_create(lisp_object_t atom_name)
 
 
 lisp_object_t lisp_atom_create_c(const char *atom_name)
+{
+    return lisp_atom_create_bytes(atom_name, (uintptr_t) strlen(atom_name));
+}
+
+
+lisp_object_t lisp_atom_create_bytes(const char *bytes, uintptr_t length)
 {
     /* Size of heap buffer including terminator, not length of string. */
-    const uintptr_t atom_name_size = strlen(atom_name) + 1;
+    const uintptr_t atom_name_size = length + 1;
 
     /* Create a buffer that's large enough. */
     lisp_atom_t atom_value;
     lisp_object_t object = lisp_object_allocate(lisp_tag_atom, sizeof(char) * atom_name_size, (void **)&atom_value);
 
     /* Copy the name to the heap buffer, uppercasing any lower-case characters. */
-    for (uintptr_t i = 0; i < atom_name_size; i++) {
-        char ch = atom_name[i];
+    for (uintptr_t i = 0; i < length; i++) {
+        char ch = bytes[i];
         if (isalpha(ch) && !isupper(ch)) {
             atom_value[i] = toupper(ch);
         } else {
             atom_value[i] = ch;
         }
     }
+    atom_value[length] = '\0';
 
     return object;
 }
@@ -81,9 +89,10 @@ lisp_atom_t lisp_atom_get_value(lisp_object_t object)
 
 lisp_object_t lisp_atom_print(lisp_object_t stream, const lisp_atom_t atom_value)
 {
-    lisp_object_t name_value = lisp_string_create_c(atom_value);
-    lisp_string_t name_string = lisp_string_get_value(name_value);
-    return lisp_string_print_quoted(stream, name_string, lisp_NIL);
+    /* Write the name directly, without making a string of it. */
+    const char *name = (const char *)atom_value;
+    lisp_stream_write_bytes(stream, (const unsigned char *)name, (uintptr_t)strlen(name));
+    return lisp_T;
 }
 
 
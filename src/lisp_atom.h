@@ -31,6 +31,9 @@ LISP_EXTERN lisp_object_t lisp_atom_create(lisp_object_t atom_name);
 /** Creates a Lisp atom with the given name as a C string. */
 LISP_EXTERN lisp_object_t lisp_atom_create_c(const char *name);
 
+/** Creates a Lisp atom with the given name as a span of bytes. */
+LISP_EXTERN lisp_object_t lisp_atom_create_bytes(const char *bytes, uintptr_t length);
+
 /**  Gets the atom value of the given Lisp object. */
 LISP_EXTERN lisp_atom_t lisp_atom_get_value(lisp_object_t object);
 
@@ -15,5 +15,11 @@
 #define LISP_EXTERN extern
 #endif
 
+#if defined(__cplusplus) || defined(cplusplus)
+#define LISP_THREAD_LOCAL thread_local
+#else
+#define LISP_THREAD_LOCAL _Thread_local
+#endif
+
 
 #endif  /* __lisp_base__ */
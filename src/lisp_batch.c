@@ -0,0 +1,549 @@
+/*
+    File:       lisp_batch.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include "lisp_batch.h"
+
+#include "lisp_environment.h"
+#include "lisp_evaluation.h"
+#include "lisp_memory.h"
+#include "lisp_printing.h"
+#include "lisp_reading.h"
+#include "lisp_stream.h"
+#include "lisp_string.h"
+#include "lisp_vm.h"
+
+#include "lisp_built_in_streams.h"
+
+#if LISP_USE_STDLIB
+#include <pthread.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#endif
+
+
+#if LISP_USE_STDLIB
+
+/** The output of a job, or what kept it from having any. */
+struct lisp_batch_result {
+    char *bytes;
+    uintptr_t length;
+    const char *problem;
+    int finished;
+};
+
+/** Where one top-level form is in the text of a file. */
+struct lisp_batch_form {
+    uintptr_t start;
+    uintptr_t length;
+};
+
+/** The state the workers evaluating a batch share. */
+struct lisp_batch {
+    lisp_batch_mode_t mode;
+    const char * const *paths;
+    uintptr_t heap_size;
+    lisp_vm_t shared;
+
+    /* The text of the file and the form each job is, in forms mode. */
+    char *text;
+    struct lisp_batch_form *forms;
+
+    /* The next job to claim and each job's result, guarded by the lock. */
+    uintptr_t job_count;
+    uintptr_t next_job;
+    struct lisp_batch_result *results;
+
+    pthread_mutex_t lock;
+    pthread_cond_t finished;
+};
+
+
+/** Claim the next job for a worker, returning `0` if there are none left. */
+static int lisp_batch_claim(struct lisp_batch *batch, uintptr_t *job)
+{
+    pthread_mutex_lock(&batch->lock);
+    int claimed = (batch->next_job < batch->job_count);
+    if (claimed) {
+        *job = batch->next_job;
+        batch->next_job = batch->next_job + 1;
+    }
+    pthread_mutex_unlock(&batch->lock);
+    return claimed;
+}
+
+/** Finish a job with its output, or with what kept it from having any. */
+static void lisp_batch_record(struct lisp_batch *batch, uintptr_t job, char *bytes, uintptr_t length, const char *problem)
+{
+    pthread_mutex_lock(&batch->lock);
+    batch->results[job].bytes = bytes;
+    batch->results[job].length = length;
+    batch->results[job].problem = problem;
+    batch->results[job].finished = 1;
+    pthread_cond_broadcast(&batch->finished);
+    pthread_mutex_unlock(&batch->lock);
+}
+
+/**
+ Finish a job with everything written to its output stream, which is
+ copied out of the worker's heap, or with `NIL` if its file couldn't be
+ read.
+ */
+static void lisp_batch_finish(struct lisp_batch *batch, uintptr_t job, lisp_object_t output)
+{
+    char *bytes = NULL;
+    uintptr_t length = 0;
+    const char *problem = NULL;
+    if (output == lisp_NIL) {
+        problem = "can't be read";
+    } else {
+        lisp_object_t string = lisp_stream_get_output_string(output);
+        length = lisp_string_get_value(string)->length;
+        bytes = malloc(length + 1);
+        if (bytes == NULL) {
+            problem = "out of memory for its output";
+            length = 0;
+        } else {
+            lisp_string_get_c(string, bytes, length + 1);
+        }
+    }
+
+    lisp_batch_record(batch, job, bytes, length, problem);
+}
+
+/**
+ Create the environment for a job, a child of the given environment in
+ which `*STANDARD-OUTPUT*` is a new string output stream.
+ */
+static lisp_object_t lisp_batch_job_environment(lisp_object_t parent, lisp_object_t *output)
+{
+    lisp_object_t environment = lisp_environment_create(parent);
+    *output = lisp_stream_create_string_output();
+    lisp_environment_set_symbol_value(environment, lisp_STANDARD_OUTPUT, lisp_APVAL, *output, lisp_NIL);
+    return environment;
+}
+
+static lisp_object_t lisp_batch_open(const char *path)
+{
+    return lisp_stream_open_file(lisp_string_create_c(path), lisp_NIL);
+}
+
+/**
+ Evaluate a file as a job, as by `LOAD`. The file is kept in the given
+ place while it's open, so it can be closed if the job can't finish.
+ */
+static void lisp_batch_evaluate_file(struct lisp_batch *batch, uintptr_t job,
+                                     lisp_object_t environment, lisp_object_t output,
+                                     lisp_object_t volatile *input)
+{
+    *input = lisp_batch_open(batch->paths[job]);
+    if (*input == lisp_NIL) {
+        lisp_batch_finish(batch, job, lisp_NIL);
+        return;
+    }
+
+    while (lisp_read_finishedp(environment, *input) == lisp_NIL) {
+        lisp_object_t form = lisp_read(environment, *input, lisp_NIL);
+        lisp_eval(environment, form);
+    }
+    lisp_stream_close(*input);
+    *input = lisp_NIL;
+    lisp_batch_finish(batch, job, output);
+}
+
+/**
+ Evaluate a form as a job. Each job reads just its own form from the
+ text of the file, so nothing is left over from one job to take up room
+ in the heap of the next.
+ */
+static void lisp_batch_evaluate_form(struct lisp_batch *batch, uintptr_t job,
+                                     lisp_object_t environment, lisp_object_t output)
+{
+    const struct lisp_batch_form *form = &batch->forms[job];
+    lisp_object_t text = lisp_string_create_bytes(batch->text + form->start, form->length);
+    lisp_object_t stream = lisp_stream_create_string_input(text);
+
+    lisp_object_t value = lisp_eval(environment, lisp_read(environment, stream, lisp_NIL));
+    lisp_print(environment, output, value);
+    lisp_stream_write_char(output, lisp_char_create('\n'));
+    lisp_batch_finish(batch, job, output);
+}
+
+/**
+ Evaluate a job in a new virtual machine. If its heap runs out, the job
+ fails and the virtual machine is disposed of with everything in it, so
+ the rest of the batch can carry on.
+ */
+static void lisp_batch_run(struct lisp_batch *batch, uintptr_t job)
+{
+    lisp_vm_t vm = lisp_vm_create_sharing(batch->heap_size, batch->shared);
+    if (vm == NULL) {
+        lisp_batch_record(batch, job, NULL, 0, "out of memory");
+        return;
+    }
+
+    lisp_object_t volatile input = lisp_NIL;
+    jmp_buf out_of_memory;
+    if (setjmp(out_of_memory) == 0) {
+        lisp_vm_set_out_of_memory(vm, &out_of_memory);
+
+        lisp_object_t output;
+        lisp_object_t environment = lisp_batch_job_environment(lisp_vm_get_environment(vm), &output);
+        switch (batch->mode) {
+            case lisp_batch_mode_files:
+                lisp_batch_evaluate_file(batch, job, environment, output, &input);
+                break;
+
+            case lisp_batch_mode_forms:
+                lisp_batch_evaluate_form(batch, job, environment, output);
+                break;
+        }
+    } else {
+        if (input != lisp_NIL) {
+            lisp_stream_close(input);
+        }
+        lisp_batch_record(batch, job, NULL, 0, "out of memory");
+    }
+
+    lisp_vm_set_out_of_memory(vm, NULL);
+    lisp_vm_dispose(vm);
+}
+
+static void *lisp_batch_worker(void *argument)
+{
+    struct lisp_batch *batch = argument;
+
+    uintptr_t job;
+    while (lisp_batch_claim(batch, &job)) {
+        lisp_batch_run(batch, job);
+    }
+
+    return NULL;
+}
+
+/** Skip bytes of a stream, returning `0` if it ends first. */
+static int lisp_batch_skip(lisp_object_t stream, uintptr_t count)
+{
+    while (count > 0) {
+        uintptr_t available = 0;
+        if (lisp_stream_buffer(stream, &available) == NULL) {
+            if (lisp_stream_read_char(stream) == lisp_NIL) {
+                return 0;
+            }
+            count = count - 1;
+        } else {
+            if (available > count) available = count;
+            lisp_stream_consume(stream, available);
+            count = count - available;
+        }
+    }
+    return 1;
+}
+
+/** How far finding the top-level forms of a file has gotten. */
+struct lisp_batch_search {
+    const char *path;
+    uintptr_t heap_size;
+
+    /* The size of the file, or `UINTPTR_MAX` until it's known. */
+    uintptr_t size;
+
+    /* The number of forms found so far, and room for how many. */
+    uintptr_t count;
+    uintptr_t capacity;
+
+    int finished;
+    const char *problem;
+
+    /* The file while it's open, so it can be closed if reading runs out of memory. */
+    lisp_object_t input;
+};
+
+/**
+ Find as many more forms of a file as a new virtual machine has room to
+ read, which is until its heap is half full but at least one form,
+ continuing after the last form found.
+
+ - Returns: `0` if the file can't be read, or the form being read
+            doesn't fit in the heap.
+ */
+static int lisp_batch_find_more_forms(struct lisp_batch *batch, struct lisp_batch_search *search)
+{
+    lisp_vm_t vm = lisp_vm_create(search->heap_size);
+    if (vm == NULL) {
+        search->problem = "out of memory";
+        return 0;
+    }
+
+    int readable;
+    jmp_buf out_of_memory;
+    if (setjmp(out_of_memory) == 0) {
+        lisp_vm_set_out_of_memory(vm, &out_of_memory);
+
+        lisp_object_t environment = lisp_vm_get_environment(vm);
+        const uintptr_t reserve = lisp_heap_available() / 2;
+
+        search->input = lisp_batch_open(search->path);
+        if (search->input == lisp_NIL) {
+            readable = 0;
+        } else {
+            /* Continue after the last form found, as long as the file hasn't changed. */
+            lisp_object_t stream = search->input;
+            uintptr_t offset = 0;
+            if (search->count > 0) {
+                const struct lisp_batch_form *last = &batch->forms[search->count - 1];
+                offset = last->start + last->length;
+            }
+            const uintptr_t remaining = lisp_stream_remaining(stream);
+            if (search->size == UINTPTR_MAX) {
+                search->size = remaining;
+            }
+            const uintptr_t size = search->size;
+            readable = (remaining == size) && (size != UINTPTR_MAX) && lisp_batch_skip(stream, offset);
+
+            uintptr_t read = 0;
+            while (readable && ((read == 0) || (lisp_heap_available() > reserve))) {
+                if (lisp_read_finishedp(environment, stream) != lisp_NIL) {
+                    search->finished = 1;
+                    break;
+                }
+
+                if (search->count == search->capacity) {
+                    const uintptr_t capacity = (search->capacity == 0) ? 64 : (search->capacity * 2);
+                    struct lisp_batch_form *forms = realloc(batch->forms, capacity * sizeof(struct lisp_batch_form));
+                    if (forms == NULL) {
+                        search->problem = "out of memory";
+                        readable = 0;
+                        break;
+                    }
+                    batch->forms = forms;
+                    search->capacity = capacity;
+                }
+
+                const uintptr_t start = size - lisp_stream_remaining(stream);
+                lisp_read(environment, stream, lisp_NIL);
+                batch->forms[search->count].start = start;
+                batch->forms[search->count].length = (size - lisp_stream_remaining(stream)) - start;
+                search->count = search->count + 1;
+                read = read + 1;
+            }
+            lisp_stream_close(stream);
+            search->input = lisp_NIL;
+        }
+    } else {
+        if (search->input != lisp_NIL) {
+            lisp_stream_close(search->input);
+            search->input = lisp_NIL;
+        }
+        search->problem = "out of memory";
+        readable = 0;
+    }
+
+    lisp_vm_set_out_of_memory(vm, NULL);
+    lisp_vm_dispose(vm);
+    return readable;
+}
+
+/**
+ Find the top-level forms in a file, for a batch in forms mode, and read
+ its text into memory so each job can read its own form from it.
+
+ The forms are read in virtual machines of their own, and since nothing
+ read can be freed, a new one is made to continue from the same place
+ whenever one's heap is half full. The place of each form is found from
+ how much of the file is left before and after reading it, so the file
+ must be a regular one.
+
+ - Parameters:
+   - problem: Set to what kept the forms from being found, if anything.
+ - Returns: The number of forms, or `UINTPTR_MAX` if they can't be found.
+ */
+static uintptr_t lisp_batch_find_forms(struct lisp_batch *batch, const char *path, uintptr_t heap_size,
+                                       const char **problem)
+{
+    lisp_vm_t previous = lisp_vm_current;
+    struct lisp_batch_search search = {
+        .path = path,
+        .heap_size = heap_size,
+        .size = UINTPTR_MAX,
+        .count = 0,
+        .capacity = 0,
+        .finished = 0,
+        .problem = "can't be read",
+        .input = lisp_NIL,
+    };
+
+    int readable = 1;
+    while (readable && !search.finished) {
+        readable = lisp_batch_find_more_forms(batch, &search);
+    }
+    lisp_vm_set_current(previous);
+
+    /* Keep the text the forms are in. */
+    if (readable) {
+        FILE *file = fopen(path, "rb");
+        batch->text = malloc((search.size > 0) ? search.size : 1);
+        if (batch->text == NULL) {
+            search.problem = "out of memory";
+        }
+        readable = (file != NULL) && (batch->text != NULL) && (fread(batch->text, 1, search.size, file) == search.size);
+        if (file != NULL) {
+            fclose(file);
+        }
+    }
+
+    *problem = search.problem;
+    return readable ? search.count : UINTPTR_MAX;
+}
+
+
+uintptr_t lisp_batch_evaluate(lisp_batch_mode_t mode,
+                              const char * const *paths,
+                              uintptr_t path_count,
+                              uintptr_t workers,
+                              uintptr_t heap_size,
+                              lisp_vm_t shared,
+                              FILE *output,
+                              FILE *errors)
+{
+    struct lisp_batch batch = {
+        .mode = mode,
+        .paths = paths,
+        .heap_size = heap_size,
+        .shared = shared,
+        .job_count = path_count,
+        .next_job = 0,
+        .results = NULL,
+        .text = NULL,
+        .forms = NULL,
+    };
+
+    if (mode == lisp_batch_mode_forms) {
+        const char *problem;
+        batch.job_count = lisp_batch_find_forms(&batch, paths[0], heap_size, &problem);
+        if (batch.job_count == UINTPTR_MAX) {
+            fprintf(errors, "%s: %s\n", paths[0], problem);
+            free(batch.forms);
+            free(batch.text);
+            return 1;
+        }
+    }
+
+    batch.results = calloc(batch.job_count, sizeof(struct lisp_batch_result));
+    pthread_t *threads = calloc(workers, sizeof(pthread_t));
+    if (((batch.results == NULL) && (batch.job_count > 0)) || (threads == NULL)) {
+        fprintf(errors, "batch: out of memory\n");
+        free(batch.results);
+        free(threads);
+        free(batch.forms);
+        free(batch.text);
+        return batch.job_count;
+    }
+
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.finished, NULL);
+
+    uintptr_t started = 0;
+    while ((started < workers) && (pthread_create(&threads[started], NULL, lisp_batch_worker, &batch) == 0)) {
+        started = started + 1;
+    }
+
+    /*
+     If every worker couldn't be started, don't let the ones that were
+     claim anything more, and once they're done, fail the whole batch
+     rather than write only some of its output.
+     */
+    uintptr_t failures = 0;
+    uintptr_t written = batch.job_count;
+    if (started < workers) {
+        fprintf(errors, "batch: can't start %llu workers\n", (unsigned long long)workers);
+        pthread_mutex_lock(&batch.lock);
+        batch.next_job = batch.job_count;
+        pthread_mutex_unlock(&batch.lock);
+        failures = batch.job_count;
+        written = 0;
+    }
+
+    /* Write each job's output as soon as it and every job before it is finished. */
+    for (uintptr_t job = 0; job < written; job++) {
+        pthread_mutex_lock(&batch.lock);
+        while (!batch.results[job].finished) {
+            pthread_cond_wait(&batch.finished, &batch.lock);
+        }
+        struct lisp_batch_result result = batch.results[job];
+        pthread_mutex_unlock(&batch.lock);
+
+        if (result.problem != NULL) {
+            const char *path = (mode == lisp_batch_mode_files) ? paths[job] : paths[0];
+            fprintf(errors, "%s: %s\n", path, result.problem);
+            failures = failures + 1;
+        } else {
+            fwrite(result.bytes, 1, result.length, output);
+            free(result.bytes);
+        }
+    }
+    fflush(output);
+
+    for (uintptr_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+
+    /* Jobs whose output wasn't written still have it. */
+    for (uintptr_t job = written; job < batch.job_count; job++) {
+        free(batch.results[job].bytes);
+    }
+
+    pthread_cond_destroy(&batch.finished);
+    pthread_mutex_destroy(&batch.lock);
+    free(batch.results);
+    free(batch.forms);
+    free(batch.text);
+
+    return failures;
+}
+
+
+lisp_vm_t lisp_batch_load_shared(const char *path, uintptr_t heap_size)
+{
+    lisp_vm_t vm = lisp_vm_create(heap_size);
+    if (vm == NULL) {
+        return NULL;
+    }
+
+    lisp_object_t volatile stream = lisp_NIL;
+    jmp_buf out_of_memory;
+    if (setjmp(out_of_memory) == 0) {
+        lisp_vm_set_out_of_memory(vm, &out_of_memory);
+
+        lisp_object_t environment = lisp_vm_get_environment(vm);
+        stream = lisp_batch_open(path);
+        if (stream == lisp_NIL) {
+            lisp_vm_dispose(vm);
+            return NULL;
+        }
+
+        while (lisp_read_finishedp(environment, stream) == lisp_NIL) {
+            lisp_object_t form = lisp_read(environment, stream, lisp_NIL);
+            lisp_eval(environment, form);
+        }
+        lisp_stream_close(stream);
+    } else {
+        /* What doesn't fit can't be shared. */
+        if (stream != lisp_NIL) {
+            lisp_stream_close(stream);
+        }
+        lisp_vm_set_out_of_memory(vm, NULL);
+        lisp_vm_dispose(vm);
+        return NULL;
+    }
+
+    lisp_vm_set_out_of_memory(vm, NULL);
+    lisp_vm_freeze(vm);
+    return vm;
+}
+
+#endif /* LISP_USE_STDLIB */
@@ -0,0 +1,103 @@
+/*
+    File:       lisp_batch.h
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#ifndef __lisp_batch__
+#define __lisp_batch__ 1
+
+
+#include "lisp_types.h"
+#include "lisp_vm.h"
+
+#if LISP_USE_STDLIB
+#include <stdio.h>
+
+
+/**
+ Batch evaluation.
+
+ Batches need threads, so they're only available with the C library.
+
+ A *batch* is a set of independent *jobs* evaluated in parallel by a
+ pool of worker threads, each with a virtual machine of its own. Each
+ job's output is collected separately, and written in the order of the
+ jobs as soon as it and every job before it is finished, so the output
+ is the same no matter how many workers there are.
+
+ Jobs run in a child of their virtual machine's environment, so their
+ bindings don't affect each other, but nothing else separates them; a
+ job shouldn't depend on any other. A job whose heap runs out fails
+ without affecting the others.
+
+ Every worker's virtual machine may share a frozen one, such as one a
+ library or data set was loaded into, so there's only one copy of it no
+ matter how many workers there are.
+ */
+
+/** What each job in a batch is. */
+typedef enum lisp_batch_mode {
+    /**
+     Each file is a job, which is evaluated as by `LOAD` in a new
+     virtual machine. Its output is everything it writes to
+     `*STANDARD-OUTPUT*`.
+     */
+    lisp_batch_mode_files,
+
+    /**
+     Each top-level form of a single file is a job, which is evaluated
+     in a new virtual machine. Its output is everything it writes to
+     `*STANDARD-OUTPUT*`, followed by its value and a newline. The file
+     must be a regular one, since it's read more than once.
+     */
+    lisp_batch_mode_forms,
+} lisp_batch_mode_t;
+
+/**
+ Evaluate a batch.
+
+ - Parameters:
+   - mode: What each job is.
+   - paths: The files to evaluate, of which there must be exactly one
+            for `lisp_batch_mode_forms`.
+   - path_count: The number of files.
+   - workers: The number of worker threads, at least one.
+   - heap_size: The size of the heap of each virtual machine.
+   - shared: The frozen virtual machine every worker's shares, or
+             `NULL` for none.
+   - output: Where to write the output of each job.
+   - errors: Where to report each file that can't be read, and anything
+             else that keeps a job or the whole batch from being run.
+ - Returns: The number of jobs that failed, which is every job if the
+            batch itself couldn't be run, in which case no output is
+            written.
+ */
+LISP_EXTERN uintptr_t lisp_batch_evaluate(lisp_batch_mode_t mode,
+                                          const char * const *paths,
+                                          uintptr_t path_count,
+                                          uintptr_t workers,
+                                          uintptr_t heap_size,
+                                          lisp_vm_t shared,
+                                          FILE *output,
+                                          FILE *errors);
+
+/**
+ Load a file, as by `LOAD`, into a new virtual machine, then freeze it
+ so a batch can share it.
+
+ - Parameters:
+   - path: The file to load.
+   - heap_size: The size of the new virtual machine's heap.
+ - Returns: The frozen virtual machine, or `NULL` if it couldn't be
+            created or the file couldn't be read. The calling thread has
+            no current virtual machine afterward.
+ */
+LISP_EXTERN lisp_vm_t lisp_batch_load_shared(const char *path, uintptr_t heap_size);
+
+
+#endif /* LISP_USE_STDLIB */
+
+
+#endif  /* __lisp_batch__ */
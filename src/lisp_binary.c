@@ -0,0 +1,573 @@
+/*
+    File:       lisp_binary.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include "lisp_binary.h"
+
+#include "lisp_atom.h"
+#include "lisp_cell.h"
+#include "lisp_environment.h"
+#include "lisp_fixnum.h"
+#include "lisp_hash_table.h"
+#include "lisp_interior.h"
+#include "lisp_memory.h"
+#include "lisp_stream.h"
+#include "lisp_string.h"
+#include "lisp_symbol_table.h"
+#include "lisp_vector.h"
+
+#if LISP_USE_STDLIB
+#include <string.h>
+#endif
+
+
+/** Make a tag byte from an object's tag and a variant of it. */
+#define LISP_BINARY_TAG(tag, variant) ((unsigned char)(((variant) << 4) | (tag)))
+
+/** The tag bytes of the binary format. */
+enum {
+    lisp_binary_tag_list            = LISP_BINARY_TAG(lisp_tag_cell, 0),
+    lisp_binary_tag_atom            = LISP_BINARY_TAG(lisp_tag_atom, 0),
+    lisp_binary_tag_atom_reference  = LISP_BINARY_TAG(lisp_tag_atom, 1),
+    lisp_binary_tag_fixnum          = LISP_BINARY_TAG(lisp_tag_fixnum, 0),
+    lisp_binary_tag_vector          = LISP_BINARY_TAG(lisp_tag_vector, 0),
+    lisp_binary_tag_char            = LISP_BINARY_TAG(lisp_tag_char, 0),
+    lisp_binary_tag_string          = LISP_BINARY_TAG(lisp_tag_string, 0),
+};
+
+/** The size of the buffer an object is written through. */
+#define LISP_BINARY_BUFFER_SIZE 256
+
+/** The number of frames a stack holds before it must grow. */
+#define LISP_BINARY_STACK_INITIAL_CAPACITY 64
+
+/**
+ The deepest an object may be nested when it's written, which also
+ stops a structure that contains itself from being written forever.
+ */
+#define LISP_BINARY_DEPTH_LIMIT 4096
+
+/** The longest atom name that's read into a buffer on the C stack. */
+#define LISP_BINARY_NAME_SIZE 128
+
+/**
+ The most cells, values, characters, or bytes of a name that one object
+ read may have, which also keeps the size of what's allocated for it
+ from overflowing.
+ */
+#define LISP_BINARY_LENGTH_LIMIT ((uint64_t)UINT32_MAX)
+
+
+/* MARK: - Writing */
+
+/** What a frame on the writer's stack has left to write. */
+typedef enum lisp_binary_write_step {
+    /** Write the frame's object. */
+    lisp_binary_write_step_element,
+
+    /** Write the rest of a list, whose next cell is the frame's object. */
+    lisp_binary_write_step_list_rest,
+
+    /** Write the rest of a vector, from the frame's index onward. */
+    lisp_binary_write_step_vector_rest,
+} lisp_binary_write_step_t;
+
+/** A frame on the writer's stack. */
+typedef struct lisp_binary_write_frame {
+    lisp_binary_write_step_t step;
+    lisp_object_t object;
+    uintptr_t index;
+    uintptr_t depth;
+} *lisp_binary_write_frame_t;
+
+/**
+ The state of writing one object, which is buffered. The atoms are an
+ `EQ` hash table from each atom already written to its index.
+ */
+typedef struct lisp_binary_writer {
+    lisp_object_t stream;
+    lisp_object_t atoms;
+    uintptr_t atom_count;
+    lisp_binary_write_frame_t frames;
+    uintptr_t count;
+    uintptr_t capacity;
+    uintptr_t buffered;
+    unsigned char buffer[LISP_BINARY_BUFFER_SIZE];
+} *lisp_binary_writer_t;
+
+static void lisp_binary_flush(lisp_binary_writer_t writer)
+{
+    if (writer->buffered > 0) {
+        lisp_stream_write_bytes(writer->stream, writer->buffer, writer->buffered);
+        writer->buffered = 0;
+    }
+}
+
+static void lisp_binary_write_byte(lisp_binary_writer_t writer, unsigned char byte)
+{
+    if (writer->buffered == LISP_BINARY_BUFFER_SIZE) {
+        lisp_binary_flush(writer);
+    }
+    writer->buffer[writer->buffered] = byte;
+    writer->buffered = writer->buffered + 1;
+}
+
+static void lisp_binary_write_varint(lisp_binary_writer_t writer, uint64_t value)
+{
+    while (value >= 0x80) {
+        lisp_binary_write_byte(writer, (unsigned char)(value | 0x80));
+        value = value >> 7;
+    }
+    lisp_binary_write_byte(writer, (unsigned char)value);
+}
+
+/** Push a frame on the writer's stack, moving the stack to the heap to grow it. */
+static void lisp_binary_write_push(lisp_binary_writer_t writer,
+                                   lisp_binary_write_step_t step,
+                                   lisp_object_t object,
+                                   uintptr_t index,
+                                   uintptr_t depth)
+{
+    if (writer->count == writer->capacity) {
+        lisp_binary_write_frame_t frames;
+        const uintptr_t capacity = writer->capacity * 2;
+        lisp_interior_create(sizeof(struct lisp_binary_write_frame) * capacity, (void **)&frames);
+        memcpy(frames, writer->frames, sizeof(struct lisp_binary_write_frame) * writer->count);
+        writer->frames = frames;
+        writer->capacity = capacity;
+    }
+
+    lisp_binary_write_frame_t frame = &writer->frames[writer->count];
+    frame->step = step;
+    frame->object = object;
+    frame->index = index;
+    frame->depth = depth;
+    writer->count = writer->count + 1;
+}
+
+/**
+ Count the cells in a list, following its `CDR` and using Brent's
+ algorithm to notice if it never ends.
+
+ - Returns: Zero if the list is circular.
+ */
+static int lisp_binary_list_length(lisp_object_t list, uintptr_t *length)
+{
+    lisp_object_t tortoise = list;
+    lisp_object_t hare = list;
+    uintptr_t count = 0;
+    uintptr_t power = 1;
+    uintptr_t steps = 0;
+
+    while (lisp_object_get_tag(hare) == lisp_tag_cell) {
+        count = count + 1;
+        hare = lisp_cell_get_value(hare)->cdr;
+        if (hare == tortoise) {
+            return 0;
+        }
+        steps = steps + 1;
+        if (steps == power) {
+            tortoise = hare;
+            power = power * 2;
+            steps = 0;
+        }
+    }
+
+    *length = count;
+    return 1;
+}
+
+static void lisp_binary_write_atom(lisp_binary_writer_t writer, lisp_object_t atom)
+{
+    lisp_object_t index = lisp_hash_table_get(writer->atoms, atom, lisp_NIL);
+    if (index != lisp_NIL) {
+        lisp_binary_write_byte(writer, lisp_binary_tag_atom_reference);
+        lisp_binary_write_varint(writer, (uint64_t)lisp_fixnum_get_value(index));
+        return;
+    }
+
+    const char *name = lisp_atom_get_value(atom);
+    const uintptr_t length = (uintptr_t)strlen(name);
+    lisp_binary_write_byte(writer, lisp_binary_tag_atom);
+    lisp_binary_write_varint(writer, length);
+    for (uintptr_t i = 0; i < length; i++) {
+        lisp_binary_write_byte(writer, (unsigned char)name[i]);
+    }
+
+    lisp_hash_table_put(writer->atoms, atom, lisp_fixnum_create((lisp_fixnum_t)writer->atom_count));
+    writer->atom_count = writer->atom_count + 1;
+}
+
+/**
+ Write one object, pushing frames for the rest of it if it's a list or
+ a vector.
+
+ - Returns: Zero if the object can't be written.
+ */
+static int lisp_binary_write_element(lisp_binary_writer_t writer, lisp_object_t object, uintptr_t depth)
+{
+    switch (lisp_object_get_tag(object)) {
+        case lisp_tag_cell: {
+            uintptr_t length;
+            if ((depth >= LISP_BINARY_DEPTH_LIMIT) || !lisp_binary_list_length(object, &length)) {
+                return 0;
+            }
+            lisp_binary_write_byte(writer, lisp_binary_tag_list);
+            lisp_binary_write_varint(writer, length);
+            lisp_binary_write_push(writer, lisp_binary_write_step_list_rest, object, 0, depth + 1);
+        } break;
+
+        case lisp_tag_atom:
+            lisp_binary_write_atom(writer, object);
+            break;
+
+        case lisp_tag_fixnum: {
+            const int64_t value = (int64_t)lisp_fixnum_get_value(object);
+            lisp_binary_write_byte(writer, lisp_binary_tag_fixnum);
+            lisp_binary_write_varint(writer, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+        } break;
+
+        case lisp_tag_vector: {
+            const uintptr_t count = lisp_vector_get_value(object)->count;
+            if (depth >= LISP_BINARY_DEPTH_LIMIT) {
+                return 0;
+            }
+            lisp_binary_write_byte(writer, lisp_binary_tag_vector);
+            lisp_binary_write_varint(writer, count);
+            if (count > 0) {
+                lisp_binary_write_push(writer, lisp_binary_write_step_vector_rest, object, 0, depth + 1);
+            }
+        } break;
+
+        case lisp_tag_char:
+            lisp_binary_write_byte(writer, lisp_binary_tag_char);
+            lisp_binary_write_varint(writer, (uint64_t)lisp_char_get_value(object));
+            break;
+
+        case lisp_tag_string: {
+            lisp_string_t string_value = lisp_string_get_value(object);
+            lisp_object_t *chars = (lisp_object_t *)lisp_interior_get_value(string_value->chars);
+            lisp_binary_write_byte(writer, lisp_binary_tag_string);
+            lisp_binary_write_varint(writer, string_value->length);
+            for (uintptr_t i = 0; i < string_value->length; i++) {
+                lisp_binary_write_varint(writer, (uint64_t)lisp_char_get_value(chars[i]));
+            }
+        } break;
+
+        default:
+            return 0;
+    }
+
+    return 1;
+}
+
+lisp_object_t lisp_binary_write(lisp_object_t stream, lisp_object_t object)
+{
+    struct lisp_binary_write_frame initial_frames[LISP_BINARY_STACK_INITIAL_CAPACITY];
+
+    struct lisp_binary_writer writer;
+    writer.stream = stream;
+    writer.atoms = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+    writer.atom_count = 0;
+    writer.frames = initial_frames;
+    writer.count = 0;
+    writer.capacity = LISP_BINARY_STACK_INITIAL_CAPACITY;
+    writer.buffered = 0;
+
+    /* NIL and T are always the first two atoms. */
+    lisp_hash_table_put(writer.atoms, lisp_NIL, lisp_fixnum_create(0));
+    lisp_hash_table_put(writer.atoms, lisp_T, lisp_fixnum_create(1));
+    writer.atom_count = 2;
+
+    int written = lisp_binary_write_element(&writer, object, 0);
+
+    while (written && (writer.count > 0)) {
+        struct lisp_binary_write_frame frame = writer.frames[writer.count - 1];
+        writer.count = writer.count - 1;
+
+        switch (frame.step) {
+            case lisp_binary_write_step_element:
+                written = lisp_binary_write_element(&writer, frame.object, frame.depth);
+                break;
+
+            case lisp_binary_write_step_list_rest: {
+                /* Leave the rest of the list, or its final CDR, under the CAR. */
+                lisp_cell_t cell_value = lisp_cell_get_value(frame.object);
+                if (lisp_object_get_tag(cell_value->cdr) == lisp_tag_cell) {
+                    lisp_binary_write_push(&writer, lisp_binary_write_step_list_rest, cell_value->cdr, 0, frame.depth);
+                } else {
+                    lisp_binary_write_push(&writer, lisp_binary_write_step_element, cell_value->cdr, 0, frame.depth);
+                }
+                written = lisp_binary_write_element(&writer, cell_value->car, frame.depth);
+            } break;
+
+            case lisp_binary_write_step_vector_rest: {
+                lisp_vector_t vector_value = lisp_vector_get_value(frame.object);
+                if ((frame.index + 1) < vector_value->count) {
+                    lisp_binary_write_push(&writer, lisp_binary_write_step_vector_rest, frame.object, frame.index + 1, frame.depth);
+                }
+                written = lisp_binary_write_element(&writer, vector_value->values[frame.index], frame.depth);
+            } break;
+        }
+    }
+
+    lisp_binary_flush(&writer);
+    return written ? lisp_T : lisp_NIL;
+}
+
+
+/* MARK: - Reading */
+
+/**
+ A frame on the reader's stack, which is a run of slots left to fill
+ with objects as they're read: either the `CAR` of each cell in a list
+ and then its final `CDR`, or a number of consecutive values.
+ */
+typedef struct lisp_binary_read_frame {
+    lisp_object_t list;
+    lisp_object_t *slots;
+    uintptr_t remaining;
+} *lisp_binary_read_frame_t;
+
+/**
+ The state of reading one object. The atoms are a vector of the atoms
+ read so far, in order. The slots are the number left to fill in every
+ frame, each of which still takes at least one byte of the stream.
+ Reading stops at the first problem.
+ */
+typedef struct lisp_binary_reader {
+    lisp_object_t stream;
+    lisp_object_t atoms;
+    lisp_binary_read_frame_t frames;
+    uintptr_t count;
+    uintptr_t capacity;
+    uintptr_t slots;
+    int failed;
+} *lisp_binary_reader_t;
+
+static unsigned char lisp_binary_read_byte(lisp_binary_reader_t reader)
+{
+    unsigned char byte = 0;
+    if (!reader->failed && (lisp_stream_read_bytes(reader->stream, &byte, 1) != 1)) {
+        reader->failed = 1;
+    }
+    return byte;
+}
+
+static uint64_t lisp_binary_read_varint(lisp_binary_reader_t reader)
+{
+    uint64_t value = 0;
+    for (unsigned int shift = 0; (shift < 64) && !reader->failed; shift += 7) {
+        const unsigned char byte = lisp_binary_read_byte(reader);
+        value = value | ((uint64_t)(byte & 0x7F) << shift);
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    reader->failed = 1;
+    return 0;
+}
+
+/**
+ Read the length of something that takes at least one byte of the
+ stream and `size` bytes of the heap for each unit of its length, such
+ as a list's cells. The length is checked against what's left of both
+ before anything is allocated, so a malformed or truncated stream can't
+ make the reader exhaust the heap.
+
+ - Parameters:
+   - slots: The number of slots the object adds to the reader's stack
+            besides its length, such as the final `CDR` of a list.
+ */
+static uintptr_t lisp_binary_read_length(lisp_binary_reader_t reader, uintptr_t size, uintptr_t slots)
+{
+    const uint64_t length = lisp_binary_read_varint(reader);
+    if (reader->failed) {
+        return 0;
+    }
+
+    /* Every slot left to fill also still needs a byte, so reserve those. */
+    const uintptr_t remaining = lisp_stream_remaining(reader->stream);
+    const uintptr_t available = (remaining > reader->slots) ? (remaining - reader->slots) : 0;
+    if ((length > LISP_BINARY_LENGTH_LIMIT)
+        || ((uintptr_t)length + slots > available)
+        || ((uintptr_t)length > lisp_heap_available() / size))
+    {
+        reader->failed = 1;
+        return 0;
+    }
+
+    return (uintptr_t)length;
+}
+
+/** Push a frame on the reader's stack, moving the stack to the heap to grow it. */
+static void lisp_binary_read_push(lisp_binary_reader_t reader,
+                                  lisp_object_t list,
+                                  lisp_object_t *slots,
+                                  uintptr_t remaining)
+{
+    if (reader->count == reader->capacity) {
+        lisp_binary_read_frame_t frames;
+        const uintptr_t capacity = reader->capacity * 2;
+        lisp_interior_create(sizeof(struct lisp_binary_read_frame) * capacity, (void **)&frames);
+        memcpy(frames, reader->frames, sizeof(struct lisp_binary_read_frame) * reader->count);
+        reader->frames = frames;
+        reader->capacity = capacity;
+    }
+
+    lisp_binary_read_frame_t frame = &reader->frames[reader->count];
+    frame->list = list;
+    frame->slots = slots;
+    frame->remaining = remaining;
+    reader->count = reader->count + 1;
+}
+
+/** Take the next slot to fill from the top frame of the reader's stack. */
+static lisp_object_t *lisp_binary_read_next_slot(lisp_binary_reader_t reader)
+{
+    lisp_binary_read_frame_t frame = &reader->frames[reader->count - 1];
+    lisp_object_t *slot;
+    reader->slots = reader->slots - 1;
+
+    if (frame->list != lisp_NIL) {
+        /* The CAR of each cell, then the CDR of the last. */
+        lisp_cell_t cell_value = lisp_cell_get_value(frame->list);
+        slot = &cell_value->car;
+        if (lisp_object_get_tag(cell_value->cdr) == lisp_tag_cell) {
+            frame->list = cell_value->cdr;
+        } else {
+            frame->list = lisp_NIL;
+            frame->slots = &cell_value->cdr;
+            frame->remaining = 1;
+        }
+        return slot;
+    }
+
+    slot = frame->slots;
+    frame->slots = frame->slots + 1;
+    frame->remaining = frame->remaining - 1;
+    if (frame->remaining == 0) {
+        reader->count = reader->count - 1;
+    }
+    return slot;
+}
+
+static lisp_object_t lisp_binary_read_atom(lisp_binary_reader_t reader)
+{
+    const uintptr_t length = lisp_binary_read_length(reader, 1, 0);
+    unsigned char stack_bytes[LISP_BINARY_NAME_SIZE];
+    unsigned char *bytes = stack_bytes;
+    if (reader->failed) {
+        return lisp_NIL;
+    }
+    if (length > LISP_BINARY_NAME_SIZE) {
+        lisp_interior_create(length, (void **)&bytes);
+    }
+    if (lisp_stream_read_bytes(reader->stream, bytes, length) != length) {
+        reader->failed = 1;
+        return lisp_NIL;
+    }
+
+    lisp_object_t atom = lisp_symbol_table_intern_bytes((const char *)bytes, length);
+    lisp_vector_push_extend(reader->atoms, atom);
+    return atom;
+}
+
+/**
+ Read one object, pushing a frame for the rest of it if it's a list or
+ a vector.
+ */
+static lisp_object_t lisp_binary_read_element(lisp_binary_reader_t reader)
+{
+    switch (lisp_binary_read_byte(reader)) {
+        case lisp_binary_tag_list: {
+            const uintptr_t length = lisp_binary_read_length(reader, sizeof(struct lisp_cell), 1);
+            if (reader->failed || (length == 0)) break;
+            lisp_object_t list = lisp_cell_create_list(length);
+            lisp_binary_read_push(reader, list, NULL, 0);
+            reader->slots = reader->slots + length + 1;
+            return list;
+        } break;
+
+        case lisp_binary_tag_atom:
+            return lisp_binary_read_atom(reader);
+
+        case lisp_binary_tag_atom_reference: {
+            const uint64_t index = lisp_binary_read_varint(reader);
+            lisp_vector_t atoms_value = lisp_vector_get_value(reader->atoms);
+            if (reader->failed || (index >= atoms_value->count)) break;
+            return atoms_value->values[index];
+        } break;
+
+        case lisp_binary_tag_fixnum: {
+            const uint64_t value = lisp_binary_read_varint(reader);
+            return lisp_fixnum_create((lisp_fixnum_t)(int64_t)((value >> 1) ^ (~(value & 1) + 1)));
+        } break;
+
+        case lisp_binary_tag_vector: {
+            const uintptr_t count = lisp_binary_read_length(reader, sizeof(lisp_object_t), 0);
+            if (reader->failed) break;
+            lisp_object_t vector = lisp_vector_create(count, lisp_NIL);
+            if (count > 0) {
+                lisp_binary_read_push(reader, lisp_NIL, lisp_vector_get_value(vector)->values, count);
+                reader->slots = reader->slots + count;
+            }
+            return vector;
+        } break;
+
+        case lisp_binary_tag_char:
+            return lisp_char_create((lisp_char_t)lisp_binary_read_varint(reader));
+
+        case lisp_binary_tag_string: {
+            const uintptr_t length = lisp_binary_read_length(reader, sizeof(lisp_object_t), 0);
+            if (reader->failed) break;
+            lisp_object_t *chars;
+            lisp_object_t chars_interior = lisp_interior_create(sizeof(lisp_object_t) * length, (void **)&chars);
+            for (uintptr_t i = 0; i < length; i++) {
+                chars[i] = lisp_char_create((lisp_char_t)lisp_binary_read_varint(reader));
+            }
+            return lisp_string_create(chars_interior, length, length);
+        } break;
+
+        default:
+            break;
+    }
+
+    reader->failed = 1;
+    return lisp_NIL;
+}
+
+lisp_object_t lisp_binary_read(lisp_object_t stream, lisp_object_t *object)
+{
+    struct lisp_binary_read_frame initial_frames[LISP_BINARY_STACK_INITIAL_CAPACITY];
+
+    struct lisp_binary_reader reader;
+    reader.stream = stream;
+    reader.atoms = lisp_vector_create(0, lisp_NIL);
+    reader.frames = initial_frames;
+    reader.count = 0;
+    reader.capacity = LISP_BINARY_STACK_INITIAL_CAPACITY;
+    reader.slots = 0;
+    reader.failed = 0;
+    *object = lisp_NIL;
+
+    /* NIL and T are always the first two atoms. */
+    lisp_vector_push_extend(reader.atoms, lisp_NIL);
+    lisp_vector_push_extend(reader.atoms, lisp_T);
+
+    lisp_object_t root = lisp_binary_read_element(&reader);
+    while (!reader.failed && (reader.count > 0)) {
+        lisp_object_t *slot = lisp_binary_read_next_slot(&reader);
+        *slot = lisp_binary_read_element(&reader);
+    }
+
+    if (reader.failed) {
+        return lisp_NIL;
+    }
+
+    *object = root;
+    return lisp_T;
+}
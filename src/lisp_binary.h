@@ -0,0 +1,71 @@
+/*
+    File:       lisp_binary.h
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#ifndef __lisp_binary__
+#define __lisp_binary__ 1
+
+
+#include "lisp_types.h"
+
+
+/**
+ Binary S-expressions.
+
+ The *binary format* is a compact encoding of an S-expression for
+ exchanging data with other processes, which is much faster to write
+ and to read than printing the same object and reading it back.
+
+ Each object starts with a tag byte, whose low four bits are the
+ object's `lisp_tag_t` and whose high four bits distinguish variants
+ of the same type. Numbers are unsigned LEB128 *varints*, and fixnums
+ are zigzag-encoded first so small negative fixnums stay small.
+
+ - A list is its number of cells, the `CAR` of each, and the final
+   `CDR`, so a proper list ends with `NIL`.
+ - An atom is its name's length and bytes the first time it appears,
+   and its index in the atoms written so far after that. `NIL` and `T`
+   are always atoms `0` and `1`.
+ - A fixnum or a character is its value.
+ - A string is its length and the code of each of its characters.
+ - A vector is its number of values and each value.
+
+ Each object written is self-contained, so several objects can be
+ written to the same stream one after another. The format is a tree,
+ so an object shared within a structure is written once per use, and
+ a circular structure can't be written at all; use an image for those.
+ */
+
+/**
+ Write an object to a stream in the binary format.
+
+ - Parameters:
+   - stream: The stream to write to, which is written as bytes.
+   - object: The object to write.
+ - Returns: `T` upon success, or `NIL` if the object is circular or
+            contains anything other than cells, atoms, fixnums,
+            characters, strings, and vectors, in which case the stream
+            may have been partially written.
+ */
+LISP_EXTERN lisp_object_t lisp_binary_write(lisp_object_t stream, lisp_object_t object);
+
+/**
+ Read an object from a stream in the binary format.
+
+ The cells of each list are allocated together, which makes reading
+ long lists much faster than constructing them one cell at a time.
+
+ - Parameters:
+   - stream: The stream to read from, which is read as bytes.
+   - object: Set to the object read.
+ - Returns: `T` upon success, or `NIL` if the stream ends early, the
+            data is malformed, or a length in it is more than what's
+            left of the stream or the heap could hold.
+ */
+LISP_EXTERN lisp_object_t lisp_binary_read(lisp_object_t stream, lisp_object_t *object);
+
+
+#endif  /* __lisp_binary__ */
@@ -9,12 +9,15 @@
 
 
 #include "lisp_atom.h"
+#include "lisp_built_in_streams.h"
 #include "lisp_cell.h"
 #include "lisp_environment.h"
 #include "lisp_evaluation.h"
 #include "lisp_memory.h"
 #include "lisp_plist.h"
+#include "lisp_stream.h"
 #include "lisp_subr.h"
+#include "lisp_vm.h"
 
 
 #if LISP_USE_STDLIB
@@ -23,68 +26,48 @@
 
 
 /* MARK: - Special Forms */
-static void lisp_eval_special_forms_initialize(lisp_object_t environment);
-
-/* The symbols representing the built-in special forms. */
-lisp_object_t lisp_symbol_AND = NULL;
-lisp_object_t lisp_symbol_COND = NULL;
-lisp_object_t lisp_symbol_DEFINE = NULL;
-lisp_object_t lisp_symbol_DEFUN = NULL;
-lisp_object_t lisp_symbol_IF = NULL;
-lisp_object_t lisp_symbol_LAMBDA = NULL;
-lisp_object_t lisp_symbol_OR = NULL;
-lisp_object_t lisp_symbol_QUOTE = NULL;
-lisp_object_t lisp_symbol_SET = NULL;
-lisp_object_t lisp_symbol_SETQ = NULL;
-lisp_object_t lisp_symbol_BLOCK = NULL;
-lisp_object_t lisp_symbol_RETURN_FROM = NULL;
-lisp_object_t lisp_symbol_RETURN = NULL;
-lisp_object_t lisp_symbol_TAGBODY = NULL;
-lisp_object_t lisp_symbol_GO = NULL;
+
+static void lisp_tagbody_initialize(lisp_object_t environment);
+
+/*
+ The symbols representing the built-in special forms are constants
+ defined with the static root environment, which binds them.
+ */
+
+#define LISP_BUILT_IN_SPECIAL_FORM(symbol, name, function) \
+    lisp_object_t function(lisp_object_t environment, lisp_object_t cell);
+#include "lisp_built_in_sforms.def"
+#undef LISP_BUILT_IN_SPECIAL_FORM
 
 /**
- Add symbols for the built-in special forms to the environment, and do
- any other intiialization required in order to use special forms.
+ Do any initialization required in order to use special forms in the
+ given child of the root environment.
  */
-void lisp_environment_add_built_in_special_forms(lisp_object_t environment)
+void lisp_environment_initialize_built_in_special_forms(lisp_object_t environment)
 {
-    /* Set up all of the symbols representing special forms. */
-    lisp_symbol_AND = lisp_environment_intern_symbol(environment, lisp_atom_create_c("AND"));
-    lisp_symbol_COND = lisp_environment_intern_symbol(environment, lisp_atom_create_c("COND"));
-    lisp_symbol_DEFINE = lisp_environment_intern_symbol(environment, lisp_atom_create_c("DEFINE"));
-    lisp_symbol_DEFUN = lisp_environment_intern_symbol(environment, lisp_atom_create_c("DEFUN"));
-    lisp_symbol_IF = lisp_environment_intern_symbol(environment, lisp_atom_create_c("IF"));
-    lisp_symbol_LAMBDA = lisp_environment_intern_symbol(environment, lisp_atom_create_c("LAMBDA"));
-    lisp_symbol_OR = lisp_environment_intern_symbol(environment, lisp_atom_create_c("OR"));
-    lisp_symbol_QUOTE = lisp_environment_intern_symbol(environment, lisp_atom_create_c("QUOTE"));
-    lisp_symbol_SET = lisp_environment_intern_symbol(environment, lisp_atom_create_c("SET"));
-    lisp_symbol_SETQ = lisp_environment_intern_symbol(environment, lisp_atom_create_c("SETQ"));
-
-    lisp_symbol_BLOCK = lisp_environment_intern_symbol(environment, lisp_atom_create_c("BLOCK"));
-    lisp_symbol_RETURN_FROM = lisp_environment_intern_symbol(environment, lisp_atom_create_c("RETURN-FROM"));
-    lisp_symbol_RETURN = lisp_environment_intern_symbol(environment, lisp_atom_create_c("RETURN"));
-
-    lisp_symbol_TAGBODY = lisp_environment_intern_symbol(environment, lisp_atom_create_c("TAGBODY"));
-    lisp_symbol_GO = lisp_environment_intern_symbol(environment, lisp_atom_create_c("GO"));
-
-    /* Initialize everything else needed by special forms. */
-    lisp_eval_special_forms_initialize(environment);
+    lisp_vm_current->open_streams = lisp_NIL;
+    lisp_tagbody_initialize(environment);
 }
 
 
 /** A mapping between symbols and special forms. */
-struct lisp_special_form_mapping {
-    lisp_object_t symbol;
+static const struct lisp_special_form_mapping {
+    const lisp_object_t *symbol;
     lisp_object_t (*function)(lisp_object_t environment, lisp_object_t cell);
-} *lisp_special_form_mappings = NULL;
+} lisp_special_form_mappings[] = {
+#define LISP_BUILT_IN_SPECIAL_FORM(symbol, name, function) { &symbol, function },
+#include "lisp_built_in_sforms.def"
+#undef LISP_BUILT_IN_SPECIAL_FORM
+};
 
 /** The number of mappings between symbols and special forms. */
-uintptr_t lisp_special_form_mappings_count = 0;
+static const uintptr_t lisp_special_form_mappings_count =
+    sizeof(lisp_special_form_mappings) / sizeof(struct lisp_special_form_mapping);
 
 int lisp_eval_is_special_form(lisp_object_t special_form)
 {
     for (uintptr_t i = 0; i < lisp_special_form_mappings_count; i++) {
-        if (lisp_eq(special_form, lisp_special_form_mappings[i].symbol) != lisp_NIL) {
+        if (lisp_eq(special_form, *lisp_special_form_mappings[i].symbol) != lisp_NIL) {
             return 1;
         }
     }
@@ -99,7 +82,7 @@ lisp_object_t lisp_eval_special_form(lisp_object_t environment,
     lisp_object_t (*function)(lisp_object_t environment, lisp_object_t cell) = NULL;
 
     for (uintptr_t i = 0; i < lisp_special_form_mappings_count; i++) {
-        if (lisp_eq(special_form, lisp_special_form_mappings[i].symbol) != lisp_NIL) {
+        if (lisp_eq(special_form, *lisp_special_form_mappings[i].symbol) != lisp_NIL) {
             function = lisp_special_form_mappings[i].function;
             break;
         }
@@ -274,6 +257,10 @@ lisp_object_t lisp_eval_DEFUN(lisp_object_t environment, lisp_object_t cell)
     /* Construct the DEFINE equivalent. */
     lisp_object_t block_form = lisp_cell_cons(lisp_symbol_BLOCK, lisp_cell_cons(name, body_forms));
     lisp_object_t lambda_form = lisp_cell_list(lisp_symbol_LAMBDA, arguments, block_form, lisp_NIL);
+
+    /* Fold what can be folded once, instead of every time it's applied. */
+    lambda_form = lisp_eval_fold_lambda(environment, lambda_form);
+
     lisp_object_t define_form = lisp_cell_list(lisp_symbol_DEFINE, name, lambda_form, lisp_NIL);
 
     /* Return the result of evaluating the DEFINE equivalent. */
@@ -495,6 +482,7 @@ lisp_object_t lisp_eval_BLOCK(lisp_object_t environment, lisp_object_t cell)
 #endif
 
     /* The second and subsequent arguments are the body. */
+    const lisp_object_t mark = lisp_eval_unwind_mark();
     lisp_object_t remaining_body_forms = lisp_cell_cdr(arguments);
     do {
         lisp_object_t body_form = lisp_cell_car(remaining_body_forms);
@@ -502,6 +490,9 @@ lisp_object_t lisp_eval_BLOCK(lisp_object_t environment, lisp_object_t cell)
         remaining_body_forms = lisp_cell_cdr(remaining_body_forms);
     } while (remaining_body_forms != lisp_NIL);
 
+    /* Close any files the body was exited from without closing. */
+    lisp_eval_unwind(mark);
+
     return result;
 }
 
@@ -534,13 +525,14 @@ lisp_object_t lisp_eval_RETURN(lisp_object_t environment, lisp_object_t cell)
 
 /* MARK: TAGBODY/GO */
 
-static lisp_object_t lisp_SI_TAGBODY_STACK = NULL;
-static lisp_object_t lisp_SI_TAGBODY_CURRENT = NULL;
-static lisp_object_t lisp_SI_TAGBODY_SEQEUENCE = NULL;
-static lisp_object_t lisp_SI_TAGBODY_MAPPING = NULL;
-static lisp_object_t lisp_SI_TAGBODY_NEXT = NULL;
-static lisp_object_t lisp_SI_TAGBODY_START = NULL;
-static lisp_object_t lisp_SI_TAGBODY_END = NULL;
+/* The atoms needed by the TAGBODY/GO mechanism belong to the current virtual machine. */
+#define lisp_SI_TAGBODY_STACK (lisp_vm_current->SI_TAGBODY_STACK)
+#define lisp_SI_TAGBODY_CURRENT (lisp_vm_current->SI_TAGBODY_CURRENT)
+#define lisp_SI_TAGBODY_SEQEUENCE (lisp_vm_current->SI_TAGBODY_SEQEUENCE)
+#define lisp_SI_TAGBODY_MAPPING (lisp_vm_current->SI_TAGBODY_MAPPING)
+#define lisp_SI_TAGBODY_NEXT (lisp_vm_current->SI_TAGBODY_NEXT)
+#define lisp_SI_TAGBODY_START (lisp_vm_current->SI_TAGBODY_START)
+#define lisp_SI_TAGBODY_END (lisp_vm_current->SI_TAGBODY_END)
 
 static void lisp_tagbody_initialize(lisp_object_t environment)
 {
@@ -892,8 +884,12 @@ lisp_object_t lisp_eval_TAGBODY(lisp_object_t environment, lisp_object_t cell)
     lisp_tagbody_push(environment, tagbody_plist);
 
     /* Start executing the TAGBODY state machine. */
+    const lisp_object_t mark = lisp_eval_unwind_mark();
     lisp_tagbody_execute(environment, tagbody_plist);
 
+    /* Close any files a GO left without closing. */
+    lisp_eval_unwind(mark);
+
     /* Popping the TAGBODY happens when execution completes. */
 
     return lisp_NIL;
@@ -919,40 +915,131 @@ lisp_object_t lisp_eval_GO(lisp_object_t environment, lisp_object_t cell)
 }
 
 
-/* MARK: - Initialization */
+/* MARK: WITH-OPEN-FILE/WITH-OUTPUT-TO-STRING */
 
-void lisp_eval_special_forms_initialize(lisp_object_t environment)
+/* The streams WITH-OPEN-FILE has open belong to the current virtual machine. */
+#define lisp_with_open_file_streams (lisp_vm_current->open_streams)
+
+lisp_object_t lisp_eval_unwind_mark(void)
 {
-    struct lisp_special_form_mapping mappings[] = {
-        { lisp_symbol_AND, lisp_eval_AND },
-        { lisp_symbol_COND, lisp_eval_COND },
-        { lisp_symbol_DEFINE, lisp_eval_DEFINE },
-        { lisp_symbol_DEFUN, lisp_eval_DEFUN },
-        { lisp_symbol_IF, lisp_eval_IF },
-        { lisp_symbol_LAMBDA, lisp_eval_LAMBDA },
-        { lisp_symbol_OR, lisp_eval_OR },
-        { lisp_symbol_QUOTE, lisp_eval_QUOTE },
-        { lisp_symbol_BLOCK, lisp_eval_BLOCK },
-        { lisp_symbol_RETURN_FROM, lisp_eval_RETURN_FROM },
-        { lisp_symbol_RETURN, lisp_eval_RETURN },
-        { lisp_symbol_SET, lisp_eval_SET },
-        { lisp_symbol_SETQ, lisp_eval_SETQ },
-        { lisp_symbol_TAGBODY, lisp_eval_TAGBODY },
-        { lisp_symbol_GO, lisp_eval_GO },
-    };
-
-    lisp_special_form_mappings_count = sizeof(mappings) / sizeof(struct lisp_special_form_mapping);
+    return lisp_with_open_file_streams;
+}
 
-#if LISP_USE_STDLIB
-    /* TODO: Put this in the Lisp heap as an interior? */
-    lisp_special_form_mappings = calloc(lisp_special_form_mappings_count,
-                                        sizeof(struct lisp_special_form_mapping));
-#endif
+void lisp_eval_unwind(lisp_object_t mark)
+{
+    while ((lisp_with_open_file_streams != mark) && (lisp_with_open_file_streams != lisp_NIL)) {
+        lisp_object_t stream = lisp_cell_car(lisp_with_open_file_streams);
+        lisp_with_open_file_streams = lisp_cell_cdr(lisp_with_open_file_streams);
+        if (lisp_stream_openp(stream) != lisp_NIL) {
+            lisp_stream_close(stream);
+        }
+    }
+}
+
+/**
+ Evaluate the `WITH-OPEN-FILE` special form.
+
+ The `WITH-OPEN-FILE` special form takes a list of a variable, a path,
+ and keyword options as for `OPEN`, followed by a series of body forms:
+
+     (WITH-OPEN-FILE (STREAM PATH :DIRECTION DIRECTION)
+        BODY-FORMS)
 
-    for (size_t i = 0; i < lisp_special_form_mappings_count; i++) {
-        lisp_special_form_mappings[i].symbol = mappings[i].symbol;
-        lisp_special_form_mappings[i].function = mappings[i].function;
+ The path and direction are evaluated and used to open the file as by
+ `OPEN`, the resulting stream is bound to the variable in a new
+ environment, and each body form is evaluated in turn in that
+ environment. The stream is closed after the last body form has been
+ evaluated, and the result is the value of that form; if the body is
+ exited some other way, it's closed on leaving the enclosing `BLOCK` or
+ `TAGBODY`, or the load or virtual machine it's evaluated in. If the
+ file can't be opened, the body forms aren't evaluated and the result
+ is `NIL`.
+ */
+lisp_object_t lisp_eval_WITH_OPEN_FILE(lisp_object_t environment, lisp_object_t cell)
+{
+    lisp_object_t result = lisp_NIL;
+
+    /* The first item is the WITH-OPEN-FILE itself. */
+    lisp_object_t arguments = lisp_cell_cdr(cell);
+
+    /* The first argument is the specification of the stream to open. */
+    lisp_object_t specification = lisp_cell_car(arguments);
+    lisp_object_t variable = lisp_cell_car(specification);
+    lisp_object_t specification_rest = lisp_cell_cdr(specification);
+    lisp_object_t path = lisp_eval(environment, lisp_cell_car(specification_rest));
+    lisp_object_t direction;
+    if (!lisp_stream_get_direction_option(lisp_cell_cdr(specification_rest), &direction)) {
+        return lisp_NIL;
     }
 
-    lisp_tagbody_initialize(environment);
+    lisp_object_t stream = lisp_stream_open_file(path, lisp_eval(environment, direction));
+    if (stream == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    /* Keep track of the stream, so it's closed however the body is exited. */
+    const lisp_object_t mark = lisp_eval_unwind_mark();
+    lisp_with_open_file_streams = lisp_cell_cons(stream, mark);
+
+    /* Bind the stream in an environment of its own. */
+    lisp_object_t stream_environment = lisp_environment_create(environment);
+    lisp_environment_set_symbol_value(stream_environment, variable,
+                                      lisp_APVAL, stream,
+                                      lisp_NIL);
+
+    /* The second and subsequent arguments are the body. */
+    for (lisp_object_t remaining_body_forms = lisp_cell_cdr(arguments);
+         remaining_body_forms != lisp_NIL;
+         remaining_body_forms = lisp_cell_cdr(remaining_body_forms))
+    {
+        lisp_object_t body_form = lisp_cell_car(remaining_body_forms);
+        result = lisp_eval(stream_environment, body_form);
+    }
+
+    lisp_eval_unwind(mark);
+
+    return result;
+}
+
+/**
+ Evaluate the `WITH-OUTPUT-TO-STRING` special form.
+
+ The `WITH-OUTPUT-TO-STRING` special form takes a list of a variable,
+ followed by a series of body forms:
+
+     (WITH-OUTPUT-TO-STRING (STREAM)
+        BODY-FORMS)
+
+ A new string output stream is bound to the variable in a new
+ environment, and each body form is evaluated in turn in that
+ environment. The result is the string containing everything written to
+ the stream, rather than the value of any body form.
+ */
+lisp_object_t lisp_eval_WITH_OUTPUT_TO_STRING(lisp_object_t environment, lisp_object_t cell)
+{
+    /* The first item is the WITH-OUTPUT-TO-STRING itself. */
+    lisp_object_t arguments = lisp_cell_cdr(cell);
+
+    /* The first argument is the specification of the stream to create. */
+    lisp_object_t specification = lisp_cell_car(arguments);
+    lisp_object_t variable = lisp_cell_car(specification);
+
+    /* Bind the stream in an environment of its own. */
+    lisp_object_t stream = lisp_stream_create_string_output();
+    lisp_object_t stream_environment = lisp_environment_create(environment);
+    lisp_environment_set_symbol_value(stream_environment, variable,
+                                      lisp_APVAL, stream,
+                                      lisp_NIL);
+
+    /* The second and subsequent arguments are the body. */
+    for (lisp_object_t remaining_body_forms = lisp_cell_cdr(arguments);
+         remaining_body_forms != lisp_NIL;
+         remaining_body_forms = lisp_cell_cdr(remaining_body_forms))
+    {
+        lisp_object_t body_form = lisp_cell_car(remaining_body_forms);
+        lisp_eval(stream_environment, body_form);
+    }
+
+    return lisp_stream_get_output_string(stream);
 }
+
@@ -26,29 +26,49 @@ LISP_EXTERN lisp_object_t lisp_eval_special_form(lisp_object_t environment,
                                                  lisp_object_t cell);
 
 /**
- Add bindings for the built-in special forms to the given environment.
+ Initialize the built-in special forms, whose symbols the static root
+ environment binds, for use in the given child of the root environment.
+ This binds the variables `TAGBODY` and `GO` use in that environment.
  */
-LISP_EXTERN void lisp_environment_add_built_in_special_forms(lisp_object_t environment);
-
-
-/* Well-known symbols represnting special forms. */
-LISP_EXTERN lisp_object_t lisp_symbol_AND;
-LISP_EXTERN lisp_object_t lisp_symbol_COND;
-LISP_EXTERN lisp_object_t lisp_symbol_DEFINE;
-LISP_EXTERN lisp_object_t lisp_symbol_DEFUN;
-LISP_EXTERN lisp_object_t lisp_symbol_IF;
-LISP_EXTERN lisp_object_t lisp_symbol_LAMBDA;
-LISP_EXTERN lisp_object_t lisp_symbol_OR;
-LISP_EXTERN lisp_object_t lisp_symbol_QUOTE;
-LISP_EXTERN lisp_object_t lisp_symbol_SET;
-LISP_EXTERN lisp_object_t lisp_symbol_SETQ;
-
-LISP_EXTERN lisp_object_t lisp_symbol_BLOCK;
-LISP_EXTERN lisp_object_t lisp_symbol_RETURN_FROM;
-LISP_EXTERN lisp_object_t lisp_symbol_RETURN;
-
-LISP_EXTERN lisp_object_t lisp_symbol_TAGBODY;
-LISP_EXTERN lisp_object_t lisp_symbol_GO;
+LISP_EXTERN void lisp_environment_initialize_built_in_special_forms(lisp_object_t environment);
+
+/**
+ Get a mark representing the streams `WITH-OPEN-FILE` currently has
+ open, for passing to `lisp_eval_unwind`.
+ */
+LISP_EXTERN lisp_object_t lisp_eval_unwind_mark(void);
+
+/**
+ Close every stream `WITH-OPEN-FILE` opened since the given mark was
+ taken. A `WITH-OPEN-FILE` closes its own stream when its body finishes,
+ so these are the ones whose bodies were exited some other way; the
+ forms a non-local exit can leave, and anything that evaluates whole
+ forms, unwind to where they started. Pass `NIL` to close them all.
+ */
+LISP_EXTERN void lisp_eval_unwind(lisp_object_t mark);
+
+
+/* Well-known symbols represnting special forms, which the root environment binds. */
+LISP_EXTERN lisp_object_t const lisp_symbol_AND;
+LISP_EXTERN lisp_object_t const lisp_symbol_COND;
+LISP_EXTERN lisp_object_t const lisp_symbol_DEFINE;
+LISP_EXTERN lisp_object_t const lisp_symbol_DEFUN;
+LISP_EXTERN lisp_object_t const lisp_symbol_IF;
+LISP_EXTERN lisp_object_t const lisp_symbol_LAMBDA;
+LISP_EXTERN lisp_object_t const lisp_symbol_OR;
+LISP_EXTERN lisp_object_t const lisp_symbol_QUOTE;
+LISP_EXTERN lisp_object_t const lisp_symbol_SET;
+LISP_EXTERN lisp_object_t const lisp_symbol_SETQ;
+
+LISP_EXTERN lisp_object_t const lisp_symbol_BLOCK;
+LISP_EXTERN lisp_object_t const lisp_symbol_RETURN_FROM;
+LISP_EXTERN lisp_object_t const lisp_symbol_RETURN;
+
+LISP_EXTERN lisp_object_t const lisp_symbol_TAGBODY;
+LISP_EXTERN lisp_object_t const lisp_symbol_GO;
+
+LISP_EXTERN lisp_object_t const lisp_symbol_WITH_OPEN_FILE;
+LISP_EXTERN lisp_object_t const lisp_symbol_WITH_OUTPUT_TO_STRING;
 
 
 #endif  /* __lisp_built_in_sforms__ */
@@ -8,13 +8,161 @@
 #include "lisp_built_in_streams.h"
 
 #include "lisp_atom.h"
+#include "lisp_cell.h"
 #include "lisp_environment.h"
 #include "lisp_interior.h"
+#include "lisp_memory.h"
 #include "lisp_string.h"
 
 
+/* MARK: String Streams */
+
+/**
+ The state of a string stream, which is the string being read from or
+ written to and the index of the next character to read.
+ */
+typedef struct lisp_stream_string_state {
+    lisp_object_t string;
+    uintptr_t position;
+} *lisp_stream_string_state_t;
+
+static lisp_stream_string_state_t lisp_stream_string_get_state(lisp_object_t stream)
+{
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    lisp_interior_t metadata = lisp_interior_get_value(functions->metadata);
+    return (lisp_stream_string_state_t)metadata;
+}
+
+static lisp_object_t lisp_stream_string_open(lisp_object_t stream, lisp_object_t readable, lisp_object_t writable)
+{
+    /* The underlying string always exists. */
+    return stream;
+}
+
+static lisp_object_t lisp_stream_string_close(lisp_object_t stream)
+{
+    return stream;
+}
+
+static lisp_object_t lisp_stream_string_read_char(lisp_object_t stream)
+{
+    lisp_stream_string_state_t state = lisp_stream_string_get_state(stream);
+    lisp_string_t string_value = lisp_string_get_value(state->string);
+
+    if (state->position >= string_value->length) {
+        return lisp_NIL;
+    }
+
+    lisp_object_t *chars = (lisp_object_t *)lisp_interior_get_value(string_value->chars);
+    lisp_object_t ch = chars[state->position];
+    state->position += 1;
+    return ch;
+}
+
+static lisp_object_t lisp_stream_string_write_char(lisp_object_t stream, lisp_object_t value)
+{
+    /* An input stream reads a string it doesn't own, so it can't change it. */
+    if ((lisp_stream_get_value(stream)->flags & lisp_stream_flags_writable) == 0) {
+        return lisp_NIL;
+    }
+
+    lisp_stream_string_state_t state = lisp_stream_string_get_state(stream);
+    lisp_string_append_char(state->string, value);
+    return stream;
+}
+
+static lisp_object_t lisp_stream_string_eofp(lisp_object_t stream)
+{
+    lisp_stream_string_state_t state = lisp_stream_string_get_state(stream);
+    lisp_string_t string_value = lisp_string_get_value(state->string);
+
+    if (state->position >= string_value->length) {
+        return lisp_T;
+    } else {
+        return lisp_NIL;
+    }
+}
+
+static uintptr_t lisp_stream_string_remaining(lisp_object_t stream)
+{
+    lisp_stream_string_state_t state = lisp_stream_string_get_state(stream);
+    lisp_string_t string_value = lisp_string_get_value(state->string);
+
+    if (state->position >= string_value->length) {
+        return 0;
+    } else {
+        return string_value->length - state->position;
+    }
+}
+
+lisp_object_t lisp_stream_functions_string(lisp_object_t string)
+{
+    lisp_stream_functions_t underlying_functions;
+    lisp_object_t functions = lisp_interior_create(sizeof(struct lisp_stream_functions), (void **)&underlying_functions);
+    underlying_functions->open = lisp_stream_string_open;
+    underlying_functions->close = lisp_stream_string_close;
+    underlying_functions->read_char = lisp_stream_string_read_char;
+    underlying_functions->write_char = lisp_stream_string_write_char;
+    underlying_functions->eofp = lisp_stream_string_eofp;
+    underlying_functions->buffer = NULL;
+    underlying_functions->consume = NULL;
+    underlying_functions->write_bytes = NULL;
+    underlying_functions->remaining = lisp_stream_string_remaining;
+    lisp_stream_string_state_t state;
+    underlying_functions->metadata = lisp_interior_create(sizeof(struct lisp_stream_string_state), (void **)&state);
+    state->string = string;
+    state->position = 0;
+    return functions;
+}
+
+lisp_object_t lisp_stream_create_string_input(lisp_object_t string)
+{
+    if (lisp_stringp(string) == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    lisp_object_t stream = lisp_stream_create(lisp_stream_functions_string(string));
+    lisp_stream_open(stream, lisp_T, lisp_NIL);
+    return stream;
+}
+
+lisp_object_t lisp_stream_create_string_output(void)
+{
+    lisp_object_t string = lisp_string_create_empty();
+    lisp_object_t stream = lisp_stream_create(lisp_stream_functions_string(string));
+    lisp_stream_open(stream, lisp_NIL, lisp_T);
+    return stream;
+}
+
+lisp_object_t lisp_stream_get_output_string(lisp_object_t stream)
+{
+    if ((lisp_streamp(stream) == lisp_NIL) || lisp_heap_sharedp(stream)) {
+        return lisp_NIL;
+    }
+
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    if (functions->write_char != lisp_stream_string_write_char) {
+        return lisp_NIL;
+    }
+
+    lisp_stream_string_state_t state = lisp_stream_string_get_state(stream);
+    lisp_object_t string = state->string;
+    state->string = lisp_string_create_empty();
+    state->position = 0;
+    return string;
+}
+
+
 #if LISP_USE_STDLIB
 
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 
 /* MARK: C Standard Library Streams */
 
@@ -36,8 +184,7 @@ static lisp_object_t lisp_stream_stdio_open(lisp_object_t stream, lisp_object_t
 static lisp_object_t lisp_stream_stdio_close(lisp_object_t stream)
 {
     FILE *file = lisp_stream_stdio_get_FILE(stream);
-    fclose(file);
-    return stream;
+    return (fclose(file) == 0) ? stream : lisp_NIL;
 }
 
 static lisp_object_t lisp_stream_stdio_read_char(lisp_object_t stream)
@@ -52,26 +199,19 @@ static lisp_object_t lisp_stream_stdio_read_char(lisp_object_t stream)
     }
 }
 
-static lisp_object_t lisp_stream_stdio_unread_char(lisp_object_t stream, lisp_object_t value)
+static lisp_object_t lisp_stream_stdio_write_char(lisp_object_t stream, lisp_object_t value)
 {
     FILE *file = lisp_stream_stdio_get_FILE(stream);
     lisp_char_t lch = lisp_char_get_value(value);
     char ch = (char)lch;
-    int result = ungetc(ch, file);
-    if (result == EOF) {
-        return lisp_NIL;
-    } else {
-        lisp_char_t char_value = (lisp_char_t)result;
-        return lisp_char_create(char_value);
-    }
+    fputc(ch, file);
+    return stream;
 }
 
-static lisp_object_t lisp_stream_stdio_write_char(lisp_object_t stream, lisp_object_t value)
+static lisp_object_t lisp_stream_stdio_write_bytes(lisp_object_t stream, const unsigned char *bytes, uintptr_t length)
 {
     FILE *file = lisp_stream_stdio_get_FILE(stream);
-    lisp_char_t lch = lisp_char_get_value(value);
-    char ch = (char)lch;
-    fputc(ch, file);
+    fwrite(bytes, 1, length, file);
     return stream;
 }
 
@@ -94,9 +234,12 @@ lisp_object_t lisp_stream_functions_stdio(FILE *file)
     underlying_functions->open = lisp_stream_stdio_open;
     underlying_functions->close = lisp_stream_stdio_close;
     underlying_functions->read_char = lisp_stream_stdio_read_char;
-    underlying_functions->unread_char = lisp_stream_stdio_unread_char;
     underlying_functions->write_char = lisp_stream_stdio_write_char;
     underlying_functions->eofp = lisp_stream_stdio_eofp;
+    underlying_functions->buffer = NULL;
+    underlying_functions->consume = NULL;
+    underlying_functions->write_bytes = lisp_stream_stdio_write_bytes;
+    underlying_functions->remaining = NULL;
     FILE **underlying_FILE;
     underlying_functions->metadata = lisp_interior_create(sizeof(FILE *), (void **)&underlying_FILE);
     *underlying_FILE = file;
@@ -148,26 +291,19 @@ static lisp_object_t lisp_stream_stdio_pair_read_char(lisp_object_t stream)
     }
 }
 
-static lisp_object_t lisp_stream_stdio_pair_unread_char(lisp_object_t stream, lisp_object_t value)
+static lisp_object_t lisp_stream_stdio_pair_write_char(lisp_object_t stream, lisp_object_t value)
 {
     lisp_stdio_FILE_pair_t files = lisp_stream_stdio_get_FILE_pair(stream);
     lisp_char_t lch = lisp_char_get_value(value);
     char ch = (char)lch;
-    int result = ungetc(ch, files->input);
-    if (result == EOF) {
-        return lisp_NIL;
-    } else {
-        lisp_char_t char_value = (lisp_char_t)result;
-        return lisp_char_create(char_value);
-    }
+    fputc(ch, files->output);
+    return stream;
 }
 
-static lisp_object_t lisp_stream_stdio_pair_write_char(lisp_object_t stream, lisp_object_t value)
+static lisp_object_t lisp_stream_stdio_pair_write_bytes(lisp_object_t stream, const unsigned char *bytes, uintptr_t length)
 {
     lisp_stdio_FILE_pair_t files = lisp_stream_stdio_get_FILE_pair(stream);
-    lisp_char_t lch = lisp_char_get_value(value);
-    char ch = (char)lch;
-    fputc(ch, files->output);
+    fwrite(bytes, 1, length, files->output);
     return stream;
 }
 
@@ -195,9 +331,12 @@ lisp_object_t lisp_stream_functions_stdio_pair(FILE *input, FILE *output)
     underlying_functions->open = lisp_stream_stdio_pair_open;
     underlying_functions->close = lisp_stream_stdio_pair_close;
     underlying_functions->read_char = lisp_stream_stdio_pair_read_char;
-    underlying_functions->unread_char = lisp_stream_stdio_pair_unread_char;
     underlying_functions->write_char = lisp_stream_stdio_pair_write_char;
     underlying_functions->eofp = lisp_stream_stdio_pair_eofp;
+    underlying_functions->buffer = NULL;
+    underlying_functions->consume = NULL;
+    underlying_functions->write_bytes = lisp_stream_stdio_pair_write_bytes;
+    underlying_functions->remaining = NULL;
     lisp_stdio_FILE_pair_t underlying_FILE_pair;
     underlying_functions->metadata = lisp_interior_create(sizeof(struct lisp_stdio_FILE_pair), (void **)&underlying_FILE_pair);
     underlying_FILE_pair->input = input;
@@ -205,9 +344,567 @@ lisp_object_t lisp_stream_functions_stdio_pair(FILE *input, FILE *output)
     return functions;
 }
 
+/* MARK: POSIX File Descriptor Streams */
+
+/** The size of each of the input and output buffers of an fd stream. */
+#define LISP_STREAM_FD_BUFFER_SIZE  (64 * 1024)
+
+/**
+ The state of a buffered POSIX file descriptor stream.
+
+ The input buffer holds `input_length` valid bytes of which the first
+ `input_position` have been consumed. The output buffer holds
+ `output_length` bytes not yet written to the file descriptor.
+ */
+typedef struct lisp_stream_fd_state {
+    int fd;
+    int at_eof;
+    unsigned char *input;
+    uintptr_t input_position;
+    uintptr_t input_length;
+    unsigned char *output;
+    uintptr_t output_length;
+} *lisp_stream_fd_state_t;
+
+static lisp_stream_fd_state_t lisp_stream_fd_get_state(lisp_object_t stream)
+{
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    lisp_interior_t metadata = lisp_interior_get_value(functions->metadata);
+    return (lisp_stream_fd_state_t)metadata;
+}
+
+/**
+ Write all buffered output to the file descriptor.
+
+ - Returns: `0` on success, `-1` if the data could not all be written.
+ */
+static int lisp_stream_fd_flush(lisp_stream_fd_state_t state)
+{
+    uintptr_t written = 0;
+    while (written < state->output_length) {
+        ssize_t result = write(state->fd,
+                               state->output + written,
+                               state->output_length - written);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            state->output_length = 0;
+            return -1;
+        }
+        written += (uintptr_t)result;
+    }
+    state->output_length = 0;
+    return 0;
+}
+
+/**
+ Discard any read-ahead so the file offset matches what has actually
+ been consumed, which is necessary before writing to a stream that is
+ open for both input and output.
+ */
+static void lisp_stream_fd_discard_input(lisp_stream_fd_state_t state)
+{
+    uintptr_t unconsumed = state->input_length - state->input_position;
+    if (unconsumed > 0) {
+        lseek(state->fd, -(off_t)unconsumed, SEEK_CUR);
+    }
+    state->input_position = 0;
+    state->input_length = 0;
+}
+
+/**
+ Refill the input buffer from the file descriptor.
+
+ - Returns: The number of new bytes available, `0` at end of file.
+ */
+static uintptr_t lisp_stream_fd_fill(lisp_stream_fd_state_t state)
+{
+    if (state->output_length > 0) {
+        lisp_stream_fd_flush(state);
+    }
+
+    state->input_position = 0;
+    state->input_length = 0;
+
+    ssize_t result;
+    do {
+        result = read(state->fd, state->input, LISP_STREAM_FD_BUFFER_SIZE);
+    } while ((result < 0) && (errno == EINTR));
+
+    if (result <= 0) {
+        state->at_eof = 1;
+        return 0;
+    }
+
+    state->input_length = (uintptr_t)result;
+    return (uintptr_t)result;
+}
+
+static lisp_object_t lisp_stream_fd_open(lisp_object_t stream, lisp_object_t readable, lisp_object_t writable)
+{
+    /* The underlying file descriptor must already be open. */
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+
+    if ((readable != lisp_NIL) && (state->input == NULL)) {
+        state->input = malloc(LISP_STREAM_FD_BUFFER_SIZE);
+        if (state->input == NULL) return lisp_NIL;
+    }
+    if ((writable != lisp_NIL) && (state->output == NULL)) {
+        state->output = malloc(LISP_STREAM_FD_BUFFER_SIZE);
+        if (state->output == NULL) return lisp_NIL;
+    }
+
+    return stream;
+}
+
+static lisp_object_t lisp_stream_fd_close(lisp_object_t stream)
+{
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+
+    if (state->fd < 0) {
+        return lisp_NIL;
+    }
+
+    /* Data that never reached the file is an error, as is failing to close it. */
+    int failed = 0;
+    if (state->output_length > 0) {
+        failed = (lisp_stream_fd_flush(state) != 0);
+    }
+    if (close(state->fd) != 0) {
+        failed = 1;
+    }
+    state->fd = -1;
+
+    free(state->input);
+    state->input = NULL;
+    state->input_position = 0;
+    state->input_length = 0;
+    free(state->output);
+    state->output = NULL;
+
+    return failed ? lisp_NIL : stream;
+}
+
+static lisp_object_t lisp_stream_fd_read_char(lisp_object_t stream)
+{
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+
+    if (state->input == NULL) {
+        return lisp_NIL;
+    }
+
+    if (state->input_position == state->input_length) {
+        if (state->at_eof || (lisp_stream_fd_fill(state) == 0)) {
+            return lisp_NIL;
+        }
+    }
+
+    unsigned char ch = state->input[state->input_position];
+    state->input_position += 1;
+    return lisp_char_create((lisp_char_t)ch);
+}
+
+static lisp_object_t lisp_stream_fd_write_char(lisp_object_t stream, lisp_object_t value)
+{
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+
+    if (state->output == NULL) {
+        return lisp_NIL;
+    }
+
+    if (state->input_length > 0) {
+        lisp_stream_fd_discard_input(state);
+    }
+    if ((state->output_length == LISP_STREAM_FD_BUFFER_SIZE) && (lisp_stream_fd_flush(state) != 0)) {
+        return lisp_NIL;
+    }
+
+    state->output[state->output_length] = (unsigned char)lisp_char_get_value(value);
+    state->output_length += 1;
+    return stream;
+}
+
+static lisp_object_t lisp_stream_fd_write_bytes(lisp_object_t stream, const unsigned char *bytes, uintptr_t length)
+{
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+
+    if (state->output == NULL) {
+        return lisp_NIL;
+    }
+
+    if (state->input_length > 0) {
+        lisp_stream_fd_discard_input(state);
+    }
+
+    while (length > 0) {
+        if ((state->output_length == LISP_STREAM_FD_BUFFER_SIZE) && (lisp_stream_fd_flush(state) != 0)) {
+            return lisp_NIL;
+        }
+
+        uintptr_t available = LISP_STREAM_FD_BUFFER_SIZE - state->output_length;
+        uintptr_t count = (length < available) ? length : available;
+        memcpy(state->output + state->output_length, bytes, count);
+        state->output_length += count;
+        bytes += count;
+        length -= count;
+    }
+
+    return stream;
+}
+
+static lisp_object_t lisp_stream_fd_eofp(lisp_object_t stream)
+{
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+
+    /* Only input can be at EOF. */
+    if (state->input == NULL) {
+        return lisp_NIL;
+    }
+
+    if (state->input_position < state->input_length) {
+        return lisp_NIL;
+    }
+
+    if (state->at_eof || (lisp_stream_fd_fill(state) == 0)) {
+        return lisp_T;
+    } else {
+        return lisp_NIL;
+    }
+}
+
+static const unsigned char *lisp_stream_fd_buffer(lisp_object_t stream, uintptr_t *length)
+{
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+
+    if (state->input == NULL) {
+        return NULL;
+    }
+
+    if (state->input_position == state->input_length) {
+        if (state->at_eof || (lisp_stream_fd_fill(state) == 0)) {
+            return NULL;
+        }
+    }
+
+    *length = state->input_length - state->input_position;
+    return state->input + state->input_position;
+}
+
+static void lisp_stream_fd_consume(lisp_object_t stream, uintptr_t count)
+{
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+    state->input_position += count;
+}
+
+/**
+ A regular file has what's left of it past the file offset to read, in
+ addition to whatever has been read ahead into the input buffer; the
+ length of anything else can't be known in advance.
+ */
+static uintptr_t lisp_stream_fd_remaining(lisp_object_t stream)
+{
+    lisp_stream_fd_state_t state = lisp_stream_fd_get_state(stream);
+
+    struct stat file_status;
+    if ((fstat(state->fd, &file_status) != 0) || !S_ISREG(file_status.st_mode)) {
+        return UINTPTR_MAX;
+    }
+
+    const off_t offset = lseek(state->fd, 0, SEEK_CUR);
+    if ((offset < 0) || (offset > file_status.st_size)) {
+        return UINTPTR_MAX;
+    }
+
+    return (uintptr_t)(file_status.st_size - offset) + (state->input_length - state->input_position);
+}
+
+lisp_object_t lisp_stream_functions_fd(int fd)
+{
+    lisp_stream_functions_t underlying_functions;
+    lisp_object_t functions = lisp_interior_create(sizeof(struct lisp_stream_functions), (void **)&underlying_functions);
+    underlying_functions->open = lisp_stream_fd_open;
+    underlying_functions->close = lisp_stream_fd_close;
+    underlying_functions->read_char = lisp_stream_fd_read_char;
+    underlying_functions->write_char = lisp_stream_fd_write_char;
+    underlying_functions->eofp = lisp_stream_fd_eofp;
+    underlying_functions->buffer = lisp_stream_fd_buffer;
+    underlying_functions->consume = lisp_stream_fd_consume;
+    underlying_functions->write_bytes = lisp_stream_fd_write_bytes;
+    underlying_functions->remaining = lisp_stream_fd_remaining;
+    lisp_stream_fd_state_t state;
+    underlying_functions->metadata = lisp_interior_create(sizeof(struct lisp_stream_fd_state), (void **)&state);
+    state->fd = fd;
+    state->at_eof = 0;
+    state->input = NULL;
+    state->input_position = 0;
+    state->input_length = 0;
+    state->output = NULL;
+    state->output_length = 0;
+    return functions;
+}
+
+
+/* MARK: Memory-Mapped Streams */
+
+/**
+ The state of a memory-mapped stream, which is just the mapping and the
+ offset of the next character to read from it.
+ */
+typedef struct lisp_stream_mmap_state {
+    int fd;
+    const unsigned char *bytes;
+    uintptr_t length;
+    uintptr_t position;
+} *lisp_stream_mmap_state_t;
+
+static lisp_stream_mmap_state_t lisp_stream_mmap_get_state(lisp_object_t stream)
+{
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    lisp_interior_t metadata = lisp_interior_get_value(functions->metadata);
+    return (lisp_stream_mmap_state_t)metadata;
+}
+
+static lisp_object_t lisp_stream_mmap_open(lisp_object_t stream, lisp_object_t readable, lisp_object_t writable)
+{
+    /* The file is mapped when the stream functions are created. */
+    if (writable != lisp_NIL) {
+        return lisp_NIL;
+    }
+    return stream;
+}
+
+static lisp_object_t lisp_stream_mmap_close(lisp_object_t stream)
+{
+    lisp_stream_mmap_state_t state = lisp_stream_mmap_get_state(stream);
+
+    if (state->bytes == NULL) {
+        return lisp_NIL;
+    }
+
+    munmap((void *)state->bytes, state->length);
+    int failed = (close(state->fd) != 0);
+    state->bytes = NULL;
+    state->fd = -1;
+    state->length = 0;
+    state->position = 0;
+
+    return failed ? lisp_NIL : stream;
+}
+
+static lisp_object_t lisp_stream_mmap_read_char(lisp_object_t stream)
+{
+    lisp_stream_mmap_state_t state = lisp_stream_mmap_get_state(stream);
+
+    if (state->position >= state->length) {
+        return lisp_NIL;
+    }
+
+    unsigned char ch = state->bytes[state->position];
+    state->position += 1;
+    return lisp_char_create((lisp_char_t)ch);
+}
+
+static lisp_object_t lisp_stream_mmap_write_char(lisp_object_t stream, lisp_object_t value)
+{
+    /* Memory-mapped streams are input-only. */
+    return lisp_NIL;
+}
+
+static lisp_object_t lisp_stream_mmap_eofp(lisp_object_t stream)
+{
+    lisp_stream_mmap_state_t state = lisp_stream_mmap_get_state(stream);
+
+    if (state->position >= state->length) {
+        return lisp_T;
+    } else {
+        return lisp_NIL;
+    }
+}
+
+static const unsigned char *lisp_stream_mmap_buffer(lisp_object_t stream, uintptr_t *length)
+{
+    lisp_stream_mmap_state_t state = lisp_stream_mmap_get_state(stream);
+
+    if (state->position >= state->length) {
+        return NULL;
+    }
+
+    *length = state->length - state->position;
+    return state->bytes + state->position;
+}
+
+static void lisp_stream_mmap_consume(lisp_object_t stream, uintptr_t count)
+{
+    lisp_stream_mmap_state_t state = lisp_stream_mmap_get_state(stream);
+    state->position += count;
+}
+
+static uintptr_t lisp_stream_mmap_remaining(lisp_object_t stream)
+{
+    lisp_stream_mmap_state_t state = lisp_stream_mmap_get_state(stream);
+
+    if (state->position >= state->length) {
+        return 0;
+    } else {
+        return state->length - state->position;
+    }
+}
+
+lisp_object_t lisp_stream_functions_mmap(int fd)
+{
+    struct stat file_status;
+    if (fstat(fd, &file_status) != 0) {
+        return lisp_NIL;
+    }
+    if (!S_ISREG(file_status.st_mode) || (file_status.st_size <= 0)) {
+        return lisp_NIL;
+    }
+
+    const uintptr_t length = (uintptr_t)file_status.st_size;
+    void *bytes = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (bytes == MAP_FAILED) {
+        return lisp_NIL;
+    }
+
+    /* Input is consumed front to back, so let the kernel read ahead. */
+    madvise(bytes, length, MADV_SEQUENTIAL);
+
+    lisp_stream_functions_t underlying_functions;
+    lisp_object_t functions = lisp_interior_create(sizeof(struct lisp_stream_functions), (void **)&underlying_functions);
+    underlying_functions->open = lisp_stream_mmap_open;
+    underlying_functions->close = lisp_stream_mmap_close;
+    underlying_functions->read_char = lisp_stream_mmap_read_char;
+    underlying_functions->write_char = lisp_stream_mmap_write_char;
+    underlying_functions->eofp = lisp_stream_mmap_eofp;
+    underlying_functions->buffer = lisp_stream_mmap_buffer;
+    underlying_functions->consume = lisp_stream_mmap_consume;
+    underlying_functions->write_bytes = NULL;
+    underlying_functions->remaining = lisp_stream_mmap_remaining;
+    lisp_stream_mmap_state_t state;
+    underlying_functions->metadata = lisp_interior_create(sizeof(struct lisp_stream_mmap_state), (void **)&state);
+    state->fd = fd;
+    state->bytes = (const unsigned char *)bytes;
+    state->length = length;
+    state->position = 0;
+    return functions;
+}
+
+
+/* MARK: Opening Files */
+
+lisp_stream_flags_t lisp_stream_flags_for_direction(lisp_object_t direction)
+{
+    if (direction == lisp_NIL) {
+        return lisp_stream_flags_readable;
+    }
+
+    if (lisp_atomp(direction) == lisp_NIL) {
+        return 0;
+    }
+
+    const char *name = (const char *)lisp_atom_get_value(direction);
+    if (strcmp(name, ":INPUT") == 0) {
+        return lisp_stream_flags_readable;
+    } else if (strcmp(name, ":OUTPUT") == 0) {
+        return lisp_stream_flags_writable;
+    } else if (strcmp(name, ":IO") == 0) {
+        return lisp_stream_flags_readable | lisp_stream_flags_writable;
+    } else {
+        return 0;
+    }
+}
+
+int lisp_stream_get_direction_option(lisp_object_t options, lisp_object_t *direction)
+{
+    *direction = lisp_NIL;
+
+    for (lisp_object_t rest = options; rest != lisp_NIL; rest = lisp_cell_cdr(lisp_cell_cdr(rest))) {
+        lisp_object_t keyword = lisp_cell_car(rest);
+        if ((lisp_cell_cdr(rest) == lisp_NIL)
+            || (lisp_atomp(keyword) == lisp_NIL)
+            || (strcmp((const char *)lisp_atom_get_value(keyword), ":DIRECTION") != 0))
+        {
+            return 0;
+        }
+        *direction = lisp_cell_car(lisp_cell_cdr(rest));
+    }
+
+    return 1;
+}
+
+lisp_object_t lisp_stream_open_file(lisp_object_t path, lisp_object_t direction)
+{
+    if (lisp_stringp(path) == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    lisp_stream_flags_t flags = lisp_stream_flags_for_direction(direction);
+    const int readable = ((flags & lisp_stream_flags_readable) != 0);
+    const int writable = ((flags & lisp_stream_flags_writable) != 0);
+
+    int open_flags;
+    if (readable && writable) {
+        open_flags = O_RDWR | O_CREAT;
+    } else if (writable) {
+        open_flags = O_WRONLY | O_CREAT | O_TRUNC;
+    } else if (readable) {
+        open_flags = O_RDONLY;
+    } else {
+        return lisp_NIL;
+    }
+
+    /*
+     The path has to be passed to the system in full, so one containing a
+     NUL can't be opened, since the system would stop at it.
+     */
+    const uintptr_t path_length = lisp_string_get_value(path)->length;
+    char *path_buffer = malloc(path_length + 1);
+    if (path_buffer == NULL) {
+        return lisp_NIL;
+    }
+    lisp_string_get_c(path, path_buffer, path_length + 1);
+    if (strlen(path_buffer) != path_length) {
+        free(path_buffer);
+        return lisp_NIL;
+    }
+
+    int fd;
+    do {
+        fd = open(path_buffer, open_flags, 0666);
+    } while ((fd < 0) && (errno == EINTR));
+    free(path_buffer);
+    if (fd < 0) {
+        return lisp_NIL;
+    }
+
+    /*
+     Map read-only files if possible, since that avoids copying them at
+     all, but fall back to buffered reads for anything unmappable.
+     */
+    lisp_object_t functions = lisp_NIL;
+    if (readable && !writable) {
+        functions = lisp_stream_functions_mmap(fd);
+    }
+    if (functions == lisp_NIL) {
+        functions = lisp_stream_functions_fd(fd);
+    }
+
+    lisp_object_t stream = lisp_stream_create(functions);
+    lisp_object_t opened = lisp_stream_open(stream,
+                                            readable ? lisp_T : lisp_NIL,
+                                            writable ? lisp_T : lisp_NIL);
+    if (opened == lisp_NIL) {
+        lisp_stream_close(stream);
+        return lisp_NIL;
+    }
+
+    return stream;
+}
+
 
 void lisp_environment_add_built_in_streams(lisp_object_t mutable_environment)
 {
+    lisp_stream_initialize();
+
     lisp_object_t lisp_TERMINAL_IO_stream = lisp_stream_create(lisp_stream_functions_stdio_pair(stdin, stdout));
     lisp_stream_open(lisp_TERMINAL_IO_stream, lisp_T, lisp_T);
     lisp_object_t lisp_TERMINAL_IO_name = lisp_string_create_c("*TERMINAL-IO*");
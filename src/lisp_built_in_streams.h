@@ -12,6 +12,42 @@
 #include "lisp_stream.h"
 
 
+/**
+ Gets stream functions for an in-memory string.
+
+ Reading takes characters from the string starting at its beginning,
+ and writing appends characters to the end of the string, growing it
+ as necessary.
+
+ - Warning: The string is used directly rather than copied, so it will
+            reflect anything written to the stream.
+ */
+LISP_EXTERN lisp_object_t lisp_stream_functions_string(lisp_object_t string);
+
+/**
+ Create a stream that reads from the given string.
+
+ - Returns: An open input stream, or `NIL` if not given a string.
+ */
+LISP_EXTERN lisp_object_t lisp_stream_create_string_input(lisp_object_t string);
+
+/**
+ Create a stream that writes to a new, empty string.
+
+ - Returns: An open output stream.
+ */
+LISP_EXTERN lisp_object_t lisp_stream_create_string_output(void);
+
+/**
+ Get the string that has been written to a string output stream, and
+ start a new, empty string for any subsequent output.
+
+ - Returns: The string written so far, or `NIL` if the stream is not a
+            string stream or is shared from a frozen virtual machine.
+ */
+LISP_EXTERN lisp_object_t lisp_stream_get_output_string(lisp_object_t stream);
+
+
 #if LISP_USE_STDLIB
 
 #include <stdio.h>
@@ -35,9 +71,79 @@ LISP_EXTERN lisp_object_t lisp_stream_functions_stdio(FILE *file);
 LISP_EXTERN lisp_object_t lisp_stream_functions_stdio_pair(FILE *input, FILE *output);
 
 
+/**
+ Gets stream functions for a POSIX file descriptor.
+
+ Unlike the C `stdio` streams, these do their own buffering and call
+ `read(2)` and `write(2)` directly, avoiding the locking and per-character
+ overhead of `FILE *` for large files. Buffers are only allocated for
+ the directions the stream is opened for.
+
+ - Warning: The file descriptor must already be open. Closing the
+            stream writes any buffered output and closes the file
+            descriptor.
+ */
+LISP_EXTERN lisp_object_t lisp_stream_functions_fd(int fd);
+
+
+/**
+ Gets read-only stream functions for a memory-mapped file.
+
+ The whole file is mapped at once, and characters are read by moving an
+ offset into the mapping, without any copying or system calls.
+
+ - Returns: The stream functions, or `NIL` if the file descriptor can't
+            be mapped (*e.g.* because it's a pipe or an empty file).
+ - Warning: The file descriptor must already be open for reading. If
+            the stream functions are created, closing the stream unmaps
+            the file and closes the file descriptor.
+ */
+LISP_EXTERN lisp_object_t lisp_stream_functions_mmap(int fd);
+
+
 #endif /* LISP_USE_STDLIB */
 
 
+/**
+ Get the stream flags corresponding to a direction keyword.
+
+ - Parameters:
+   - direction: One of the keywords `:INPUT`, `:OUTPUT`, or `:IO`. `NIL`
+                is treated as `:INPUT`.
+ - Returns: `lisp_stream_flags_readable`, `lisp_stream_flags_writable`,
+            or both, or `0` if the direction is not recognized.
+ */
+LISP_EXTERN lisp_stream_flags_t lisp_stream_flags_for_direction(lisp_object_t direction);
+
+/**
+ Open a file as a stream.
+
+ - Parameters:
+   - path: A string naming the file to open.
+   - direction: The direction keyword to open the file with, as for
+                `lisp_stream_flags_for_direction`. A file opened for
+                `:INPUT` is memory-mapped if possible, a file opened for
+                `:OUTPUT` is created if necessary and truncated, a file
+                opened for `:IO` is created if necessary.
+ - Returns: A newly-opened stream, or `NIL` if the file could not be
+            opened.
+ */
+LISP_EXTERN lisp_object_t lisp_stream_open_file(lisp_object_t path, lisp_object_t direction);
+
+/**
+ Get the direction from the keyword options following the path given to
+ `OPEN` or `WITH-OPEN-FILE`, such as `(:DIRECTION :OUTPUT)`.
+
+ - Parameters:
+   - options: The list of alternating keywords and values.
+   - direction: Receives the value given for `:DIRECTION`, or `NIL` if
+                there was none.
+ - Returns: `1` if the options were valid, `0` if the list has an odd
+            length or a keyword other than `:DIRECTION`.
+ */
+LISP_EXTERN int lisp_stream_get_direction_option(lisp_object_t options, lisp_object_t *direction);
+
+
 /**
  Create the `*TERMINAL-IO*`, `*STANDARD-INPUT*` and `*STANDARD-OUTPUT*` streams in the environment, connected to the appropriate underlying constructs for our system.
  */
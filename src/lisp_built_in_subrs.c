@@ -7,20 +7,36 @@
 
 #include "lisp_built_in_subrs.h"
 
+#include "lisp_array.h"
 #include "lisp_atom.h"
+#include "lisp_binary.h"
+#include "lisp_built_in_sforms.h"
+#include "lisp_built_in_streams.h"
 #include "lisp_cell.h"
 #include "lisp_environment.h"
 #include "lisp_evaluation.h"
 #include "lisp_fixnum.h"
+#include "lisp_hash_table.h"
+#include "lisp_image.h"
+#include "lisp_memory.h"
 #include "lisp_printing.h"
 #include "lisp_reading.h"
 #include "lisp_stream.h"
 #include "lisp_string.h"
 #include "lisp_subr.h"
+#include "lisp_vector.h"
+
+#if LISP_USE_STDLIB
+#include <string.h>
+#endif
 
 
 /*
  The built-in SUBRs cover the rest of Lisp.
+
+ Those that change an object refuse to change one that's shared from a
+ frozen virtual machine, returning `NIL` instead, since it may be in use
+ by any number of other threads.
  */
 
 lisp_object_t lisp_subr_CAR(lisp_object_t environment, lisp_object_t arguments)
@@ -53,6 +69,14 @@ lisp_object_t lisp_subr_EQ(lisp_object_t environment, lisp_object_t arguments)
     return lisp_eq(first, second);
 }
 
+lisp_object_t lisp_subr_EQL(lisp_object_t environment, lisp_object_t arguments)
+{
+    /* Fixnums and characters are immediate, so EQL is the same as EQ. */
+    lisp_object_t first = lisp_cell_car(arguments);
+    lisp_object_t second = lisp_cell_car(lisp_cell_cdr(arguments));
+    return lisp_eq(first, second);
+}
+
 lisp_object_t lisp_subr_EQUAL(lisp_object_t environment, lisp_object_t arguments)
 {
     lisp_object_t first = lisp_cell_car(arguments);
@@ -92,6 +116,15 @@ lisp_object_t lisp_subr_LENGTH(lisp_object_t environment, lisp_object_t argument
     lisp_fixnum_t length = 0;
     lisp_object_t list = lisp_cell_car(arguments);
 
+    /* Vectors and arrays know their length. */
+    if (lisp_vectorp(list) != lisp_NIL) {
+        lisp_vector_t vector_value = lisp_vector_get_value(list);
+        return lisp_fixnum_create((lisp_fixnum_t) vector_value->count);
+    }
+    if (lisp_arrayp(list) != lisp_NIL) {
+        return lisp_fixnum_create((lisp_fixnum_t) lisp_array_count(list));
+    }
+
     while (list != lisp_NIL) {
         length = length + 1;
         list = lisp_cell_cdr(list);
@@ -103,6 +136,7 @@ lisp_object_t lisp_subr_LENGTH(lisp_object_t environment, lisp_object_t argument
 lisp_object_t lisp_subr_RPLACA(lisp_object_t environment, lisp_object_t arguments)
 {
     lisp_object_t first = lisp_cell_car(arguments);
+    if ((lisp_cellp(first) == lisp_NIL) || lisp_heap_sharedp(first)) return lisp_NIL;
     lisp_object_t second = lisp_cell_car(lisp_cell_cdr(arguments));
     return lisp_cell_rplaca(first, second);
 }
@@ -110,6 +144,7 @@ lisp_object_t lisp_subr_RPLACA(lisp_object_t environment, lisp_object_t argument
 lisp_object_t lisp_subr_RPLACD(lisp_object_t environment, lisp_object_t arguments)
 {
     lisp_object_t first = lisp_cell_car(arguments);
+    if ((lisp_cellp(first) == lisp_NIL) || lisp_heap_sharedp(first)) return lisp_NIL;
     lisp_object_t second = lisp_cell_car(lisp_cell_cdr(arguments));
     return lisp_cell_rplacd(first, second);
 }
@@ -253,7 +288,7 @@ lisp_object_t lisp_subr_sign_MINUS(lisp_object_t environment, lisp_object_t argu
 
 lisp_object_t lisp_subr_sign_TIMES(lisp_object_t environment, lisp_object_t arguments)
 {
-    lisp_fixnum_t product = 0;
+    lisp_fixnum_t product = 1;
     lisp_object_t args = arguments;
     while (args != lisp_NIL) {
         lisp_object_t arg = lisp_cell_car(args);
@@ -274,6 +309,7 @@ lisp_object_t lisp_subr_sign_DIVIDE(lisp_object_t environment, lisp_object_t arg
 
     lisp_fixnum_t x = lisp_fixnum_get_value(first);
     lisp_fixnum_t y = lisp_fixnum_get_value(second);
+    if (y == 0) return lisp_NIL;
 
     return lisp_fixnum_create(x / y);
 }
@@ -288,6 +324,7 @@ lisp_object_t lisp_subr_sign_MODULO(lisp_object_t environment, lisp_object_t arg
 
     lisp_fixnum_t x = lisp_fixnum_get_value(first);
     lisp_fixnum_t y = lisp_fixnum_get_value(second);
+    if (y == 0) return lisp_NIL;
 
     return lisp_fixnum_create(x % y);
 }
@@ -304,6 +341,511 @@ lisp_object_t lisp_subr_STREAMP(lisp_object_t environment, lisp_object_t argumen
     return lisp_streamp(first);
 }
 
+lisp_object_t lisp_subr_VECTORP(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t first = lisp_cell_car(arguments);
+    return lisp_vectorp(first);
+}
+
+lisp_object_t lisp_subr_MAKE_VECTOR(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t size = lisp_cell_car(arguments);
+    if (lisp_fixnump(size) == lisp_NIL) return lisp_NIL;
+    if (lisp_fixnum_get_value(size) < 0) return lisp_NIL;
+
+    lisp_object_t initial_element = lisp_cell_car(lisp_cell_cdr(arguments));
+
+    return lisp_vector_create((uintptr_t) lisp_fixnum_get_value(size), initial_element);
+}
+
+lisp_object_t lisp_subr_VECTOR(lisp_object_t environment, lisp_object_t arguments)
+{
+    return lisp_vector_create_from_list(arguments);
+}
+
+lisp_object_t lisp_subr_AREF(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t vector = lisp_cell_car(arguments);
+    if ((lisp_vectorp(vector) == lisp_NIL) && (lisp_arrayp(vector) == lisp_NIL)) return lisp_NIL;
+
+    lisp_object_t index = lisp_cell_car(lisp_cell_cdr(arguments));
+    if (lisp_fixnump(index) == lisp_NIL) return lisp_NIL;
+    if (lisp_fixnum_get_value(index) < 0) return lisp_NIL;
+
+    if (lisp_arrayp(vector) != lisp_NIL) {
+        return lisp_array_ref(vector, (uintptr_t) lisp_fixnum_get_value(index));
+    }
+    return lisp_vector_ref(vector, (uintptr_t) lisp_fixnum_get_value(index));
+}
+
+lisp_object_t lisp_subr_ASET(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t vector = lisp_cell_car(arguments);
+    if ((lisp_vectorp(vector) == lisp_NIL) && (lisp_arrayp(vector) == lisp_NIL)) return lisp_NIL;
+
+    lisp_object_t index = lisp_cell_car(lisp_cell_cdr(arguments));
+    if (lisp_fixnump(index) == lisp_NIL) return lisp_NIL;
+    if (lisp_fixnum_get_value(index) < 0) return lisp_NIL;
+
+    if (lisp_heap_sharedp(vector)) return lisp_NIL;
+
+    lisp_object_t value = lisp_cell_car(lisp_cell_cdr(lisp_cell_cdr(arguments)));
+
+    if (lisp_arrayp(vector) != lisp_NIL) {
+        return lisp_array_set(vector, (uintptr_t) lisp_fixnum_get_value(index), value);
+    }
+    return lisp_vector_set(vector, (uintptr_t) lisp_fixnum_get_value(index), value);
+}
+
+lisp_object_t lisp_subr_VECTOR_PUSH_EXTEND(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t value = lisp_cell_car(arguments);
+
+    lisp_object_t vector = lisp_cell_car(lisp_cell_cdr(arguments));
+    if (lisp_vectorp(vector) == lisp_NIL) return lisp_NIL;
+    if (lisp_heap_sharedp(vector)) return lisp_NIL;
+
+    uintptr_t index = lisp_vector_push_extend(vector, value);
+    return lisp_fixnum_create((lisp_fixnum_t) index);
+}
+
+lisp_object_t lisp_subr_ARRAYP(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t first = lisp_cell_car(arguments);
+    return lisp_arrayp(first);
+}
+
+lisp_object_t lisp_subr_MAKE_ARRAY(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t size = lisp_cell_car(arguments);
+    if (lisp_fixnump(size) == lisp_NIL) return lisp_NIL;
+    if (lisp_fixnum_get_value(size) < 0) return lisp_NIL;
+
+    lisp_object_t type_keyword = lisp_cell_car(lisp_cell_cdr(arguments));
+    lisp_object_t initial_element = lisp_cell_car(lisp_cell_cdr(lisp_cell_cdr(arguments)));
+
+    /* Without an element type, an array is just a vector. */
+    if (type_keyword == lisp_NIL) {
+        return lisp_vector_create((uintptr_t) lisp_fixnum_get_value(size), initial_element);
+    }
+
+    lisp_array_type_t type = lisp_array_type_for_keyword(type_keyword);
+    if (type == 0) return lisp_NIL;
+
+    lisp_object_t array = lisp_array_create(type, (uintptr_t) lisp_fixnum_get_value(size));
+    if (initial_element != lisp_NIL) {
+        if (lisp_fixnump(initial_element) == lisp_NIL) return lisp_NIL;
+        lisp_array_fill(array, lisp_fixnum_get_value(initial_element));
+    }
+    return array;
+}
+
+/**
+ Get the number of elements in a list, vector, or array.
+ */
+static uintptr_t lisp_subr_sequence_count(lisp_object_t sequence)
+{
+    if (lisp_vectorp(sequence) != lisp_NIL) {
+        lisp_vector_t vector_value = lisp_vector_get_value(sequence);
+        return vector_value->count;
+    } else if (lisp_arrayp(sequence) != lisp_NIL) {
+        return lisp_array_count(sequence);
+    } else {
+        uintptr_t count = 0;
+        while (lisp_cellp(sequence) != lisp_NIL) {
+            count = count + 1;
+            sequence = lisp_cell_cdr(sequence);
+        }
+        return count;
+    }
+}
+
+/**
+ Get the next element of a list, vector, or array. The cursor starts as
+ the sequence itself and is advanced through a list, so that walking a
+ list doesn't need to start over at each element.
+ */
+static lisp_object_t lisp_subr_sequence_next(lisp_object_t sequence,
+                                             lisp_object_t *cursor,
+                                             uintptr_t index)
+{
+    if (lisp_vectorp(sequence) != lisp_NIL) {
+        return lisp_vector_ref(sequence, index);
+    } else if (lisp_arrayp(sequence) != lisp_NIL) {
+        return lisp_array_ref(sequence, index);
+    } else {
+        lisp_object_t element = lisp_cell_car(*cursor);
+        *cursor = lisp_cell_cdr(*cursor);
+        return element;
+    }
+}
+
+lisp_object_t lisp_subr_FILL(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t sequence = lisp_cell_car(arguments);
+    lisp_object_t value = lisp_cell_car(lisp_cell_cdr(arguments));
+
+    if ((lisp_vectorp(sequence) == lisp_NIL) && (lisp_arrayp(sequence) == lisp_NIL)) return lisp_NIL;
+    if (lisp_heap_sharedp(sequence)) return lisp_NIL;
+
+    if (lisp_arrayp(sequence) != lisp_NIL) {
+        if (lisp_fixnump(value) == lisp_NIL) return lisp_NIL;
+        lisp_array_fill(sequence, lisp_fixnum_get_value(value));
+    } else if (lisp_vectorp(sequence) != lisp_NIL) {
+        lisp_vector_t vector_value = lisp_vector_get_value(sequence);
+        for (uintptr_t i = 0; i < vector_value->count; i++) {
+            vector_value->values[i] = value;
+        }
+    } else {
+        return lisp_NIL;
+    }
+
+    return sequence;
+}
+
+lisp_object_t lisp_subr_REPLACE(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t destination = lisp_cell_car(arguments);
+    lisp_object_t source = lisp_cell_car(lisp_cell_cdr(arguments));
+
+    if ((lisp_vectorp(destination) == lisp_NIL) && (lisp_arrayp(destination) == lisp_NIL)) return lisp_NIL;
+    if (lisp_heap_sharedp(destination)) return lisp_NIL;
+
+    /* Arrays of the same type are copied in bulk. */
+    if ((lisp_arrayp(destination) != lisp_NIL) && (lisp_arrayp(source) != lisp_NIL)
+        && (lisp_array_get_type(destination) == lisp_array_get_type(source)))
+    {
+        lisp_array_replace(destination, source);
+        return destination;
+    }
+
+    const uintptr_t destination_count = lisp_subr_sequence_count(destination);
+    const uintptr_t source_count = lisp_subr_sequence_count(source);
+    const uintptr_t count = (destination_count < source_count) ? destination_count : source_count;
+
+    lisp_object_t cursor = source;
+    for (uintptr_t i = 0; i < count; i++) {
+        lisp_object_t element = lisp_subr_sequence_next(source, &cursor, i);
+        if (lisp_arrayp(destination) != lisp_NIL) {
+            lisp_array_set(destination, i, element);
+        } else {
+            lisp_vector_set(destination, i, element);
+        }
+    }
+
+    return destination;
+}
+
+lisp_object_t lisp_subr_REDUCE(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t function = lisp_cell_car(arguments);
+    if ((lisp_subrp(function) == lisp_NIL) && (lisp_cellp(function) == lisp_NIL)) return lisp_NIL;
+
+    lisp_object_t sequence = lisp_cell_car(lisp_cell_cdr(arguments));
+
+    /* Summing an array doesn't need to box each element. */
+    if ((lisp_arrayp(sequence) != lisp_NIL) && (lisp_subrp(function) != lisp_NIL)) {
+        lisp_subr_t subr_value = lisp_subr_get_value(function);
+        if (subr_value->function == lisp_subr_sign_PLUS) {
+            return lisp_fixnum_create(lisp_array_sum(sequence));
+        }
+    }
+
+    /* An empty sequence reduces to the function called with no arguments. */
+    const uintptr_t count = lisp_subr_sequence_count(sequence);
+    if (count == 0) {
+        return lisp_apply(environment, function, lisp_NIL);
+    }
+
+    lisp_object_t cursor = sequence;
+    lisp_object_t accumulator = lisp_subr_sequence_next(sequence, &cursor, 0);
+    for (uintptr_t i = 1; i < count; i++) {
+        lisp_object_t element = lisp_subr_sequence_next(sequence, &cursor, i);
+        lisp_object_t function_arguments = lisp_cell_cons(accumulator, lisp_cell_cons(element, lisp_NIL));
+        accumulator = lisp_apply(environment, function, function_arguments);
+    }
+
+    return accumulator;
+}
+
+lisp_object_t lisp_subr_MAP(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t function = lisp_cell_car(arguments);
+    if ((lisp_subrp(function) == lisp_NIL) && (lisp_cellp(function) == lisp_NIL)) return lisp_NIL;
+
+    lisp_object_t a = lisp_cell_car(lisp_cell_cdr(arguments));
+    lisp_object_t rest = lisp_cell_cdr(lisp_cell_cdr(arguments));
+    lisp_object_t b = lisp_cell_car(rest);
+
+    /* Arithmetic on two arrays of the same type is done element-wise in bulk. */
+    if ((rest != lisp_NIL) && (lisp_subrp(function) != lisp_NIL)
+        && (lisp_arrayp(a) != lisp_NIL) && (lisp_arrayp(b) != lisp_NIL)
+        && (lisp_array_get_type(a) == lisp_array_get_type(b)))
+    {
+        lisp_subr_t subr_value = lisp_subr_get_value(function);
+        if (subr_value->function == lisp_subr_sign_PLUS) {
+            return lisp_array_map(lisp_array_operation_add, a, b);
+        } else if (subr_value->function == lisp_subr_sign_MINUS) {
+            return lisp_array_map(lisp_array_operation_subtract, a, b);
+        } else if (subr_value->function == lisp_subr_sign_TIMES) {
+            return lisp_array_map(lisp_array_operation_multiply, a, b);
+        }
+    }
+
+    /* The result is the same kind of sequence as the first argument. */
+    uintptr_t count = lisp_subr_sequence_count(a);
+    if (rest != lisp_NIL) {
+        const uintptr_t b_count = lisp_subr_sequence_count(b);
+        count = (count < b_count) ? count : b_count;
+    }
+
+    lisp_object_t result;
+    if (lisp_arrayp(a) != lisp_NIL) {
+        result = lisp_array_create(lisp_array_get_type(a), count);
+    } else if (lisp_vectorp(a) != lisp_NIL) {
+        result = lisp_vector_create(count, lisp_NIL);
+    } else {
+        result = lisp_NIL;
+    }
+    lisp_object_t result_tail = lisp_NIL;
+
+    lisp_object_t a_cursor = a;
+    lisp_object_t b_cursor = b;
+    for (uintptr_t i = 0; i < count; i++) {
+        lisp_object_t function_arguments;
+        lisp_object_t a_element = lisp_subr_sequence_next(a, &a_cursor, i);
+        if (rest != lisp_NIL) {
+            lisp_object_t b_element = lisp_subr_sequence_next(b, &b_cursor, i);
+            function_arguments = lisp_cell_cons(a_element, lisp_cell_cons(b_element, lisp_NIL));
+        } else {
+            function_arguments = lisp_cell_cons(a_element, lisp_NIL);
+        }
+        lisp_object_t value = lisp_apply(environment, function, function_arguments);
+
+        if (lisp_arrayp(a) != lisp_NIL) {
+            lisp_array_set(result, i, value);
+        } else if (lisp_vectorp(a) != lisp_NIL) {
+            lisp_vector_set(result, i, value);
+        } else {
+            lisp_object_t result_cell = lisp_cell_cons(value, lisp_NIL);
+            if (result_tail != lisp_NIL) {
+                lisp_cell_rplacd(result_tail, result_cell);
+            } else {
+                result = result_cell;
+            }
+            result_tail = result_cell;
+        }
+    }
+
+    return result;
+}
+
+lisp_object_t lisp_subr_HASH_TABLE_P(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t first = lisp_cell_car(arguments);
+    return lisp_hash_tablep(first);
+}
+
+lisp_object_t lisp_subr_MAKE_HASH_TABLE(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_hash_table_test_t test = lisp_hash_table_test_eql;
+    uintptr_t size = 0;
+
+    /* Arguments are keyword/value pairs, :TEST and :SIZE. */
+    for (lisp_object_t args = arguments; args != lisp_NIL; args = lisp_cell_cdr(lisp_cell_cdr(args))) {
+        lisp_object_t keyword = lisp_cell_car(args);
+        lisp_object_t value = lisp_cell_car(lisp_cell_cdr(args));
+        if (lisp_atomp(keyword) == lisp_NIL) return lisp_NIL;
+        const char *keyword_name = lisp_atom_get_value(keyword);
+
+        if (strcmp(keyword_name, ":TEST") == 0) {
+            /* The test may be given as a name or as the function itself. */
+            const char *test_name = NULL;
+            if (lisp_atomp(value) != lisp_NIL) {
+                test_name = lisp_atom_get_value(value);
+            } else if (lisp_subrp(value) != lisp_NIL) {
+                lisp_subr_t subr_value = lisp_subr_get_value(value);
+                if (subr_value->function == lisp_subr_EQ) test_name = "EQ";
+                if (subr_value->function == lisp_subr_EQL) test_name = "EQL";
+                if (subr_value->function == lisp_subr_EQUAL) test_name = "EQUAL";
+            }
+            if (test_name == NULL) return lisp_NIL;
+
+            if (strcmp(test_name, "EQ") == 0) {
+                test = lisp_hash_table_test_eq;
+            } else if (strcmp(test_name, "EQL") == 0) {
+                test = lisp_hash_table_test_eql;
+            } else if (strcmp(test_name, "EQUAL") == 0) {
+                test = lisp_hash_table_test_equal;
+            } else {
+                return lisp_NIL;
+            }
+        } else if (strcmp(keyword_name, ":SIZE") == 0) {
+            if (lisp_fixnump(value) == lisp_NIL) return lisp_NIL;
+            if (lisp_fixnum_get_value(value) < 0) return lisp_NIL;
+            size = (uintptr_t) lisp_fixnum_get_value(value);
+        } else {
+            return lisp_NIL;
+        }
+    }
+
+    return lisp_hash_table_create(test, size);
+}
+
+lisp_object_t lisp_subr_GETHASH(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t key = lisp_cell_car(arguments);
+    lisp_object_t table = lisp_cell_car(lisp_cell_cdr(arguments));
+    if (lisp_hash_tablep(table) == lisp_NIL) return lisp_NIL;
+    lisp_object_t default_value = lisp_cell_car(lisp_cell_cdr(lisp_cell_cdr(arguments)));
+    return lisp_hash_table_get(table, key, default_value);
+}
+
+lisp_object_t lisp_subr_PUTHASH(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t key = lisp_cell_car(arguments);
+    lisp_object_t value = lisp_cell_car(lisp_cell_cdr(arguments));
+    lisp_object_t table = lisp_cell_car(lisp_cell_cdr(lisp_cell_cdr(arguments)));
+    if (lisp_hash_tablep(table) == lisp_NIL) return lisp_NIL;
+    if (lisp_heap_sharedp(table)) return lisp_NIL;
+    return lisp_hash_table_put(table, key, value);
+}
+
+lisp_object_t lisp_subr_REMHASH(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t key = lisp_cell_car(arguments);
+    lisp_object_t table = lisp_cell_car(lisp_cell_cdr(arguments));
+    if (lisp_hash_tablep(table) == lisp_NIL) return lisp_NIL;
+    if (lisp_heap_sharedp(table)) return lisp_NIL;
+    return lisp_hash_table_remove(table, key);
+}
+
+/** The state MAPHASH passes through to each call of its function. */
+struct lisp_subr_MAPHASH_context {
+    lisp_object_t environment;
+    lisp_object_t function;
+};
+
+static void lisp_subr_MAPHASH_entry(lisp_object_t key, lisp_object_t value, void *context)
+{
+    struct lisp_subr_MAPHASH_context *maphash_context = context;
+    lisp_object_t function_arguments = lisp_cell_cons(key, lisp_cell_cons(value, lisp_NIL));
+    lisp_apply(maphash_context->environment, maphash_context->function, function_arguments);
+}
+
+lisp_object_t lisp_subr_MAPHASH(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t function = lisp_cell_car(arguments);
+    if ((lisp_subrp(function) == lisp_NIL) && (lisp_cellp(function) == lisp_NIL)) return lisp_NIL;
+
+    lisp_object_t table = lisp_cell_car(lisp_cell_cdr(arguments));
+    if (lisp_hash_tablep(table) == lisp_NIL) return lisp_NIL;
+
+    struct lisp_subr_MAPHASH_context context = { environment, function };
+    lisp_hash_table_map(table, lisp_subr_MAPHASH_entry, &context);
+    return lisp_NIL;
+}
+
+lisp_object_t lisp_subr_HASH_TABLE_COUNT(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t table = lisp_cell_car(arguments);
+    if (lisp_hash_tablep(table) == lisp_NIL) return lisp_NIL;
+    return lisp_fixnum_create((lisp_fixnum_t) lisp_hash_table_count(table));
+}
+
+lisp_object_t lisp_subr_SXHASH(lisp_object_t environment, lisp_object_t arguments)
+{
+    /* The hash is only 32 bits, so it's always a non-negative fixnum. */
+    lisp_object_t object = lisp_cell_car(arguments);
+    return lisp_fixnum_create((lisp_fixnum_t) lisp_hash_table_hash_equal(object));
+}
+
+lisp_object_t lisp_subr_OPEN(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t path = lisp_cell_car(arguments);
+    lisp_object_t direction;
+    if (!lisp_stream_get_direction_option(lisp_cell_cdr(arguments), &direction)) return lisp_NIL;
+    return lisp_stream_open_file(path, direction);
+}
+
+lisp_object_t lisp_subr_CLOSE(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t stream = lisp_cell_car(arguments);
+    if (lisp_streamp(stream) == lisp_NIL) return lisp_NIL;
+    if (lisp_stream_openp(stream) == lisp_NIL) return lisp_NIL;
+
+    /* Failing to write out everything or to close the file is an error. */
+    return (lisp_stream_close(stream) != lisp_NIL) ? lisp_T : lisp_NIL;
+}
+
+lisp_object_t lisp_subr_LOAD(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t path = lisp_cell_car(arguments);
+    lisp_object_t stream = lisp_stream_open_file(path, lisp_NIL);
+    if (stream == lisp_NIL) return lisp_NIL;
+
+    const lisp_object_t mark = lisp_eval_unwind_mark();
+    while (lisp_read_finishedp(environment, stream) == lisp_NIL) {
+        lisp_object_t form = lisp_read(environment, stream, lisp_NIL);
+        lisp_eval(environment, form);
+    }
+    lisp_eval_unwind(mark);
+
+    lisp_stream_close(stream);
+    return lisp_T;
+}
+
+lisp_object_t lisp_subr_SAVE_IMAGE(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t path = lisp_cell_car(arguments);
+    if (lisp_stringp(path) == lisp_NIL) return lisp_NIL;
+    return lisp_image_save(environment, path);
+}
+
+lisp_object_t lisp_subr_LOAD_IMAGE(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t path = lisp_cell_car(arguments);
+    if (lisp_stringp(path) == lisp_NIL) return lisp_NIL;
+    return lisp_image_load(environment, path);
+}
+
+lisp_object_t lisp_subr_WRITE_BINARY(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t object = lisp_cell_car(arguments);
+    lisp_object_t stream = lisp_cell_car(lisp_cell_cdr(arguments));
+    lisp_object_t output_stream = lisp_stream_best_output_stream(environment, stream);
+    if (output_stream == lisp_NIL) return lisp_NIL;
+    if (lisp_binary_write(output_stream, object) == lisp_NIL) return lisp_NIL;
+    return object;
+}
+
+lisp_object_t lisp_subr_READ_BINARY(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t stream = lisp_cell_car(arguments);
+    lisp_object_t input_stream = lisp_stream_best_input_stream(environment, stream);
+    if (input_stream == lisp_NIL) return lisp_NIL;
+    lisp_object_t object;
+    if (lisp_binary_read(input_stream, &object) == lisp_NIL) return lisp_NIL;
+    return object;
+}
+
+lisp_object_t lisp_subr_MAKE_STRING_INPUT_STREAM(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t string = lisp_cell_car(arguments);
+    return lisp_stream_create_string_input(string);
+}
+
+lisp_object_t lisp_subr_MAKE_STRING_OUTPUT_STREAM(lisp_object_t environment, lisp_object_t arguments)
+{
+    return lisp_stream_create_string_output();
+}
+
+lisp_object_t lisp_subr_GET_OUTPUT_STREAM_STRING(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t stream = lisp_cell_car(arguments);
+    return lisp_stream_get_output_string(stream);
+}
+
 lisp_object_t lisp_subr_READ(lisp_object_t environment, lisp_object_t arguments)
 {
     lisp_object_t stream = lisp_cell_car(arguments);
@@ -331,12 +873,22 @@ lisp_object_t lisp_subr_PRINT(lisp_object_t environment, lisp_object_t arguments
 {
     lisp_object_t object = lisp_cell_car(arguments);
     lisp_object_t stream = lisp_cell_car(lisp_cell_cdr(arguments));
-    lisp_print(environment, stream, lisp_char_create(char_newline));
-    lisp_print(environment, stream, object);
-    lisp_print(environment, stream, lisp_char_create(char_space));
+    lisp_object_t output_stream = lisp_stream_best_output_stream(environment, stream);
+    if (output_stream == lisp_NIL) return lisp_NIL;
+    lisp_print_object(environment, output_stream, lisp_char_create(char_newline));
+    lisp_print_object(environment, output_stream, object);
+    lisp_print_object(environment, output_stream, lisp_char_create(char_space));
     return object;
 }
 
+lisp_object_t lisp_subr_FORMAT(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t destination = lisp_cell_car(arguments);
+    lisp_object_t control = lisp_cell_car(lisp_cell_cdr(arguments));
+    lisp_object_t format_arguments = lisp_cell_cdr(lisp_cell_cdr(arguments));
+    return lisp_format(environment, destination, control, format_arguments);
+}
+
 lisp_object_t lisp_subr_TERPRI(lisp_object_t environment, lisp_object_t arguments)
 {
     lisp_object_t stream = lisp_cell_car(arguments);
@@ -344,6 +896,26 @@ lisp_object_t lisp_subr_TERPRI(lisp_object_t environment, lisp_object_t argument
     return lisp_NIL;
 }
 
+lisp_object_t lisp_subr_REMPROP(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t symbol = lisp_cell_car(arguments);
+    if (lisp_atomp(symbol) == lisp_NIL) return lisp_NIL;
+    lisp_object_t indicator = lisp_cell_car(lisp_cell_cdr(arguments));
+    return lisp_environment_remove_symbol_value(environment, symbol, indicator, lisp_T);
+}
+
+lisp_object_t lisp_subr_MAKUNBOUND(lisp_object_t environment, lisp_object_t arguments)
+{
+    lisp_object_t symbol = lisp_cell_car(arguments);
+    if (lisp_atomp(symbol) == lisp_NIL) return lisp_NIL;
+
+    /* T and NIL are constants. */
+    if ((symbol == lisp_T) || (symbol == lisp_NIL)) return lisp_NIL;
+
+    lisp_environment_remove_symbol_value(environment, symbol, lisp_APVAL, lisp_T);
+    return symbol;
+}
+
 lisp_object_t lisp_subr_EVAL(lisp_object_t environment, lisp_object_t arguments)
 {
     lisp_object_t form = lisp_cell_car(arguments);
@@ -358,61 +930,3 @@ lisp_object_t lisp_subr_APPLY(lisp_object_t environment, lisp_object_t arguments
     lisp_object_t function_arguments = lisp_cell_car(lisp_cell_cdr(arguments));
     return lisp_apply(environment, function, function_arguments);
 }
-
-
-void lisp_environment_add_built_in_SUBRs(lisp_object_t environment)
-{
-    struct proto_subr {
-        lisp_callable callable;
-        char *name;
-    } lisp_built_in_SUBRs[] = {
-        { lisp_subr_CAR, "CAR" },
-        { lisp_subr_CDR, "CDR" },
-        { lisp_subr_CONS, "CONS" },
-        { lisp_subr_ATOM, "ATOM" },
-        { lisp_subr_EQ, "EQ" },
-        { lisp_subr_EQUAL, "EQUAL" },
-        { lisp_subr_LIST, "LIST" },
-        { lisp_subr_NULL, "NULL" },
-        { lisp_subr_MEMBER, "MEMBER" },
-        { lisp_subr_LENGTH, "LENGTH" },
-        { lisp_subr_RPLACA, "RPLACA" },
-        { lisp_subr_RPLACD, "RPLACD" },
-        { lisp_subr_NOT, "NOT" },
-        { lisp_subr_NUMBERP, "NUMBERP" },
-        { lisp_subr_ZEROP, "ZEROP" },
-        { lisp_subr_MINUSP, "MINUSP" },
-        { lisp_subr_sign_LESS_THAN, "<" },
-        { lisp_subr_sign_LESS_THAN_OR_EQUALS, "<=" },
-        { lisp_subr_sign_GREATER_THAN, ">" },
-        { lisp_subr_sign_GREATER_THAN_OR_EQUALS, ">=" },
-        { lisp_subr_sign_EQUALS, "=" },
-        { lisp_subr_sign_PLUS, "+" },
-        { lisp_subr_sign_MINUS, "-" },
-        { lisp_subr_sign_TIMES, "*" },
-        { lisp_subr_sign_DIVIDE, "/" },
-        { lisp_subr_sign_MODULO, "%" },
-        { lisp_subr_STRINGP, "STRINGP" },
-        { lisp_subr_STREAMP, "STREAMP" },
-        { lisp_subr_READ, "READ" },
-        { lisp_subr_PRIN1, "PRIN1" },
-        { lisp_subr_PRIN1, "PRINC" },
-        { lisp_subr_PRINT, "PRINT" },
-        { lisp_subr_TERPRI, "TERPRI" },
-        { lisp_subr_EVAL, "EVAL" },
-        { lisp_subr_APPLY, "APPLY" },
-        { 0, 0 },
-    };
-
-    for (struct proto_subr *item = lisp_built_in_SUBRs;
-         item->callable != 0;
-         item++)
-    {
-        lisp_object_t symbol = lisp_atom_create_c(item->name);
-        lisp_object_t symbol_name = lisp_string_create_c(item->name);
-        lisp_callable symbol_callable = item->callable;
-        lisp_object_t symbol_subr = lisp_subr_create(symbol_callable, symbol_name);
-        lisp_environment_set_symbol_value(environment, symbol, lisp_SUBR, symbol_subr, lisp_NIL);
-        lisp_environment_set_symbol_value(environment, symbol, lisp_PNAME, symbol_name, lisp_NIL);
-    }
-}
@@ -13,10 +13,15 @@
 
 
 /**
- Add the built-in `SUBR` instances to the given environment, which
- should be a root environment or one level above it.
+ The functions implementing the built-in `SUBR` instances.
+
+ The `SUBR` objects themselves are part of the static root environment,
+ which is generated at build time from `lisp_built_in_subrs.def`.
  */
-LISP_EXTERN void lisp_environment_add_built_in_SUBRs(lisp_object_t environment);
+#define LISP_BUILT_IN_SUBR(function, name, pure) \
+    LISP_EXTERN lisp_object_t function(lisp_object_t environment, lisp_object_t arguments);
+#include "lisp_built_in_subrs.def"
+#undef LISP_BUILT_IN_SUBR
 
 
 #endif  /* __lisp_built_in_subrs__ */
@@ -29,6 +29,18 @@ typedef struct lisp_cell {
 /** Construct a Lisp cell with the given `CAR` and `CDR`. */
 LISP_EXTERN lisp_object_t lisp_cell_cons(lisp_object_t car, lisp_object_t cdr);
 
+/**
+ Constructs a list of the given number of cells, whose `CAR` are all
+ `NIL`, allocating them together in one block of the heap.
+
+ This is much faster than constructing the cells one at a time when the
+ length of a list is known before its elements, as when reading a list
+ in a binary format.
+
+ - Returns: The first cell of the list, or `NIL` if the count is zero.
+ */
+LISP_EXTERN lisp_object_t lisp_cell_create_list(uintptr_t count);
+
 /** Gets the `CAR` of the given cell. */
 LISP_EXTERN lisp_object_t lisp_cell_car(lisp_object_t cell);
 
@@ -68,7 +80,8 @@ LISP_EXTERN lisp_object_t lisp_cell_print_dotted(lisp_object_t environment,
 /**
  Compares two cells.
 
- Two cells are equal if their `CAR` and `CDR` are equal, recursively.
+ Two cells are equal if their `CAR` and `CDR` are equal. This is the
+ same as `lisp_equal`, so it's iterative and safe on circular lists.
  */
 LISP_EXTERN lisp_object_t lisp_cell_equal(lisp_object_t a, lisp_object_t b);
 
@@ -10,32 +10,42 @@
 #include "lisp_atom.h"
 #include "lisp_cell.h"
 #include "lisp_evaluation.h"
+#include "lisp_fixnum.h"
+#include "lisp_hash_table.h"
 #include "lisp_memory.h"
 #include "lisp_plist.h"
+#include "lisp_printing.h"
+#include "lisp_root.h"
 #include "lisp_stream.h"
 #include "lisp_string.h"
 #include "lisp_subr.h"
+#include "lisp_symbol_table.h"
+#include "lisp_vm.h"
 
 #include "lisp_built_in_sforms.h"
 #include "lisp_built_in_streams.h"
-#include "lisp_built_in_subrs.h"
 
 
-/* Well-known atoms that are always in a root environment. */
+/*
+ The well-known atoms that are always in a root environment are defined
+ with the static root environment itself.
+ */
+
 
-lisp_object_t lisp_T = NULL;
-lisp_object_t lisp_NIL = NULL;
+/* How many environments bind each symbol, keyed by name. */
+#define lisp_environment_binding_counts (lisp_vm_current->binding_counts)
 
-lisp_object_t lisp_TERMINAL_IO = NULL;
-lisp_object_t lisp_STANDARD_INPUT = NULL;
-lisp_object_t lisp_STANDARD_OUTPUT = NULL;
+/* Changes whenever the function a symbol names might change. */
+#define lisp_environment_function_epoch_value (lisp_vm_current->function_epoch)
 
-lisp_object_t lisp_PNAME = NULL;
-lisp_object_t lisp_EXPR = NULL;
-lisp_object_t lisp_SUBR = NULL;
-lisp_object_t lisp_APVAL = NULL;
+/* Changes whenever the stream a well-known stream symbol names might change. */
+#define lisp_environment_stream_epoch_value (lisp_vm_current->stream_epoch)
 
-static lisp_object_t lisp_SI_PARENT_ENVIRONMENT = NULL;
+/* The frozen virtual machine whose environment is shared, if any. */
+#define lisp_environment_shared_vm (lisp_vm_current->shared)
+
+static void lisp_environment_count_binding(lisp_object_t symbol, lisp_fixnum_t delta);
+static int lisp_environment_stream_symbolp(lisp_object_t symbol);
 
 
 lisp_object_t lisp_environment_create(lisp_object_t parent)
@@ -134,9 +144,20 @@ lisp_object_t lisp_environment_set_symbol_value(lisp_object_t environment,
                                                 lisp_object_t recursive)
 {
     lisp_object_t found_symbol = lisp_environment_find_symbol(environment, symbol, recursive);
+
+    /* A shared binding can't change, so bind the symbol anew instead. */
+    if (lisp_heap_sharedp(found_symbol)) {
+        found_symbol = lisp_NIL;
+    }
+
     lisp_object_t plist = lisp_cell_cdr(found_symbol);
     if (plist == lisp_NIL) {
-        /* There was no plist, create it. */
+        /*
+         There was no plist, create it. Register the symbol so that reading
+         its name yields the atom the environment uses for it.
+         */
+        lisp_symbol_table_intern(symbol);
+        lisp_environment_count_binding(symbol, 1);
         lisp_object_t symbol_type_value_cell = lisp_cell_cons(type, value);
         lisp_object_t symbol_plist = lisp_plist_create(symbol_type_value_cell, NULL);
         lisp_plist_set(environment, symbol, symbol_plist);
@@ -144,9 +165,173 @@ lisp_object_t lisp_environment_set_symbol_value(lisp_object_t environment,
         /* There was a plist, update it. */
         lisp_plist_set(plist, type, value);
     }
+
+    if ((type == lisp_SUBR) || (type == lisp_EXPR)) {
+        lisp_environment_function_epoch_value = lisp_environment_function_epoch_value + 1;
+    } else if ((type == lisp_APVAL) && lisp_environment_stream_symbolp(symbol)) {
+        lisp_environment_stream_epoch_value = lisp_environment_stream_epoch_value + 1;
+    }
+
     return value;
 }
 
+lisp_object_t lisp_environment_remove_symbol_value(lisp_object_t environment,
+                                                   lisp_object_t symbol,
+                                                   lisp_object_t type,
+                                                   lisp_object_t recursive)
+{
+    /*
+     Find the environment that actually contains the symbol, since that's
+     the plist the symbol's entry may need to be removed from.
+     */
+    lisp_object_t containing_environment = environment;
+    lisp_object_t entry = lisp_NIL;
+    while (!lisp_plist_find_entry(containing_environment, symbol, &entry)) {
+        if (recursive == lisp_NIL) {
+            return lisp_NIL;
+        }
+        containing_environment = lisp_environment_parent(containing_environment);
+        if (containing_environment == lisp_NIL) {
+            return lisp_NIL;
+        }
+    }
+
+    /*
+     The root environment is constant, as are those of a shared virtual
+     machine, so nothing can be removed from them.
+     */
+    if ((lisp_environment_parent(containing_environment) == lisp_NIL)
+        || lisp_heap_sharedp(containing_environment))
+    {
+        return lisp_NIL;
+    }
+
+    lisp_object_t plist = lisp_cell_cdr(entry);
+    lisp_object_t type_entry;
+    if ((plist == lisp_NIL) || !lisp_plist_find_entry(plist, type, &type_entry)) {
+        return lisp_NIL;
+    }
+
+    /* Removing any value may unmask some other function or stream. */
+    lisp_environment_function_epoch_value = lisp_environment_function_epoch_value + 1;
+    if (lisp_environment_stream_symbolp(symbol)) {
+        lisp_environment_stream_epoch_value = lisp_environment_stream_epoch_value + 1;
+    }
+
+    if (lisp_cell_cdr(plist) == lisp_NIL) {
+        /* This is the symbol's only value, so remove the symbol itself. */
+        lisp_environment_count_binding(symbol, -1);
+        return lisp_plist_remprop(containing_environment, symbol);
+    } else {
+        return lisp_plist_remprop(plist, type);
+    }
+}
+
+
+lisp_object_t lisp_environment_bindings(lisp_object_t environment)
+{
+    lisp_object_t bindings = lisp_NIL;
+    lisp_object_t bindings_tail = lisp_NIL;
+    lisp_object_t seen = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+
+    /* The root environment is the one without a parent, so stop there. */
+    for (lisp_object_t env = environment;
+         lisp_environment_parent(env) != lisp_NIL;
+         env = lisp_environment_parent(env))
+    {
+        for (lisp_object_t rest = env; rest != lisp_NIL; rest = lisp_cell_cdr(rest)) {
+            lisp_object_t entry = lisp_cell_car(rest);
+            lisp_object_t symbol = lisp_cell_car(entry);
+            if ((symbol == lisp_SI_PARENT_ENVIRONMENT)
+                || (lisp_hash_table_get(seen, symbol, lisp_NIL) != lisp_NIL))
+            {
+                continue;
+            }
+            lisp_hash_table_put(seen, symbol, lisp_T);
+
+            lisp_object_t binding_cell = lisp_cell_cons(entry, lisp_NIL);
+            if (bindings_tail == lisp_NIL) {
+                bindings = binding_cell;
+            } else {
+                lisp_cell_rplacd(bindings_tail, binding_cell);
+            }
+            bindings_tail = binding_cell;
+        }
+    }
+
+    return bindings;
+}
+
+
+uintptr_t lisp_environment_binding_count(lisp_object_t symbol)
+{
+    const lisp_object_t zero = lisp_fixnum_create(0);
+    lisp_object_t count = lisp_hash_table_get(lisp_environment_binding_counts, symbol, zero);
+    lisp_fixnum_t total = lisp_fixnum_get_value(count);
+
+    /* Bindings in a shared virtual machine's environments count too. */
+    for (lisp_vm_t vm = lisp_environment_shared_vm; vm != NULL; vm = vm->shared) {
+        lisp_object_t shared_count = lisp_hash_table_get(vm->binding_counts, symbol, zero);
+        total = total + lisp_fixnum_get_value(shared_count);
+    }
+
+    return (uintptr_t) total;
+}
+
+
+uintptr_t lisp_environment_function_epoch(void)
+{
+    return lisp_environment_function_epoch_value;
+}
+
+
+uintptr_t lisp_environment_stream_epoch(void)
+{
+    return lisp_environment_stream_epoch_value;
+}
+
+
+/**
+ Adjust the number of environments in which a symbol is bound. A symbol
+ becoming bound in a second environment may shadow a function, so that
+ changes the function epoch.
+ */
+static void lisp_environment_count_binding(lisp_object_t symbol, lisp_fixnum_t delta)
+{
+    lisp_object_t own_count = lisp_hash_table_get(lisp_environment_binding_counts, symbol, lisp_fixnum_create(0));
+    lisp_hash_table_put(lisp_environment_binding_counts, symbol, lisp_fixnum_create(lisp_fixnum_get_value(own_count) + delta));
+
+    lisp_fixnum_t count = (lisp_fixnum_t) lisp_environment_binding_count(symbol);
+    if ((delta > 0) && (count == 2)) {
+        lisp_environment_function_epoch_value = lisp_environment_function_epoch_value + 1;
+    }
+}
+
+/**
+ Indicate whether a symbol is one of the well-known stream symbols. The
+ symbol may not be the canonical atom for its name, so fall back to
+ comparing names for anything that might be one.
+ */
+static int lisp_environment_stream_symbolp(lisp_object_t symbol)
+{
+    if ((symbol == lisp_TERMINAL_IO) || (symbol == lisp_STANDARD_INPUT) || (symbol == lisp_STANDARD_OUTPUT)) {
+        return 1;
+    }
+
+    if ((lisp_TERMINAL_IO == NULL) || (lisp_atomp(symbol) == lisp_NIL)) {
+        return 0;
+    }
+
+    const char *name = (const char *)lisp_atom_get_value(symbol);
+    if (name[0] != '*') {
+        return 0;
+    }
+
+    return (   (lisp_atom_equal(symbol, lisp_TERMINAL_IO) != lisp_NIL)
+            || (lisp_atom_equal(symbol, lisp_STANDARD_INPUT) != lisp_NIL)
+            || (lisp_atom_equal(symbol, lisp_STANDARD_OUTPUT) != lisp_NIL));
+}
+
 /**
  "Intern" a symbol for the given atom in the environment, using `NIL` as
  its `APVAL` since being interned doesn't necessarily mean being bound.
@@ -165,8 +350,9 @@ lisp_object_t lisp_environment_intern_symbol(lisp_object_t environment,
 lisp_object_t lisp_environment_create_root(void)
 {
     /*
-     Create the "raw" root environment property list, where each symbol is
-     its own APVAL.
+     The root environment property list is constant data generated at
+     build time from the built-in special forms and SUBRs, where each of
+     the rawest symbols is its own APVAL:
 
          ((T . ((PNAME . "T")
                 (APVAL . T)))
@@ -181,85 +367,65 @@ lisp_object_t lisp_environment_create_root(void)
           (SUBR . ((PNAME . "SUBR")
                    (APVAL . SUBR)))
           (%SI:*PARENT-ENVIRONMENT* . ((PNAME . "%SI:*PARENT-ENVIRONMENT*")
-                                       (APVAL . NIL))))
+                                       (APVAL . NIL)))
+          (AND . ((APVAL . NIL)))
+          ...
+          (CAR . ((SUBR . #<SUBR CAR>)
+                  (PNAME . "CAR")))
+          ...)
 
-     It must be created "manually" in order to bootstrap everything else,
-     because some of the things in it are used as keys in an environment
-     property list itself.
+     so none of it needs to be constructed here, only registered.
 
      Note that the symbol for %SI:*PARENT-ENVIRONMENT* is registered with
      an APVAL of NIL to indicate that this environment has no parent; a
      non-root environment has its parent environment as its APVAL.
      */
 
-    lisp_object_t lisp_T_name = lisp_string_create_c("T");
-    lisp_object_t lisp_NIL_name = lisp_string_create_c("NIL");
-    lisp_object_t lisp_PNAME_name = lisp_string_create_c("PNAME");
-    lisp_object_t lisp_APVAL_name = lisp_string_create_c("APVAL");
-    lisp_object_t lisp_EXPR_name = lisp_string_create_c("EXPR");
-    lisp_object_t lisp_SUBR_name = lisp_string_create_c("SUBR");
-    lisp_object_t lisp_parent_name = lisp_string_create_c("%SI:PARENT-ENVIRONMENT");
-
-    lisp_T = lisp_atom_create(lisp_T_name);
-    lisp_NIL = lisp_atom_create(lisp_NIL_name);
-    lisp_PNAME = lisp_atom_create(lisp_PNAME_name);
-    lisp_APVAL = lisp_atom_create(lisp_APVAL_name);
-    lisp_EXPR = lisp_atom_create(lisp_EXPR_name);
-    lisp_SUBR = lisp_atom_create(lisp_SUBR_name);
-    lisp_SI_PARENT_ENVIRONMENT = lisp_atom_create(lisp_parent_name);
-
-    lisp_object_t lisp_T_plist = lisp_plist_create(lisp_cell_cons(lisp_PNAME, lisp_T_name),
-                                                   lisp_cell_cons(lisp_APVAL, lisp_T),
-                                                   NULL);
-    lisp_object_t lisp_NIL_plist = lisp_plist_create(lisp_cell_cons(lisp_PNAME, lisp_NIL_name),
-                                                     lisp_cell_cons(lisp_APVAL, lisp_NIL),
-                                                     NULL);
-    lisp_object_t lisp_PNAME_plist = lisp_plist_create(lisp_cell_cons(lisp_PNAME, lisp_PNAME_name),
-                                                       lisp_cell_cons(lisp_APVAL, lisp_PNAME),
-                                                       NULL);
-    lisp_object_t lisp_APVAL_plist = lisp_plist_create(lisp_cell_cons(lisp_PNAME, lisp_APVAL_name),
-                                                       lisp_cell_cons(lisp_APVAL, lisp_APVAL),
-                                                       NULL);
-    lisp_object_t lisp_EXPR_plist = lisp_plist_create(lisp_cell_cons(lisp_PNAME, lisp_EXPR_name),
-                                                      lisp_cell_cons(lisp_APVAL, lisp_EXPR),
-                                                      NULL);
-    lisp_object_t lisp_SUBR_plist = lisp_plist_create(lisp_cell_cons(lisp_PNAME, lisp_SUBR_name),
-                                                      lisp_cell_cons(lisp_APVAL, lisp_SUBR),
-                                                      NULL);
-    lisp_object_t lisp_PARENT_plist = lisp_plist_create(lisp_cell_cons(lisp_PNAME, lisp_parent_name),
-                                                        lisp_cell_cons(lisp_APVAL, lisp_NIL),
-                                                        NULL);
-
-    lisp_object_t environment = lisp_cell_list(lisp_cell_cons(lisp_T, lisp_T_plist),
-                                               lisp_cell_cons(lisp_NIL, lisp_NIL_plist),
-                                               lisp_cell_cons(lisp_PNAME, lisp_PNAME_plist),
-                                               lisp_cell_cons(lisp_APVAL, lisp_APVAL_plist),
-                                               lisp_cell_cons(lisp_EXPR, lisp_EXPR_plist),
-                                               lisp_cell_cons(lisp_SUBR, lisp_SUBR_plist),
-                                               lisp_cell_cons(lisp_SI_PARENT_ENVIRONMENT, lisp_PARENT_plist),
-                                               lisp_NIL);
-
-    /*
-     Now that the rawest portion of the root environment has been
-     established, register the built-in special forms and SUBRs.
-     */
+    /* The well-known stream symbols are created with the built-in streams. */
+    lisp_TERMINAL_IO = NULL;
+    lisp_STANDARD_INPUT = NULL;
+    lisp_STANDARD_OUTPUT = NULL;
+
+    /* Track bindings so evaluation can cache what functions symbols name. */
+    lisp_environment_binding_counts = lisp_hash_table_create(lisp_hash_table_test_equal, 0);
+    lisp_environment_function_epoch_value = lisp_environment_function_epoch_value + 1;
+    lisp_environment_stream_epoch_value = lisp_environment_stream_epoch_value + 1;
+
+    /* Every atom the reader returns is canonicalized through the symbol table. */
+    lisp_symbol_table_initialize();
+    for (uintptr_t i = 0; i < lisp_root_atom_count; i++) {
+        lisp_symbol_table_intern(lisp_root_atoms[i]);
+        lisp_environment_count_binding(lisp_root_atoms[i], 1);
+    }
 
-    lisp_environment_add_built_in_special_forms(environment);
-    lisp_environment_add_built_in_SUBRs(environment);
+    lisp_object_t environment = lisp_root_environment;
+    lisp_eval_initialize(environment);
 
     /*
      The root environment is preserved from modification by the creation
      of a child environment which is actually what gets returned. That way
-     every caller doesn't need to do this itself, and we can alsop set up
-     well-known mutable symbols in it instead of hte root.
+     every caller doesn't need to do this itself, and we can also set up
+     well-known mutable symbols in it instead of the root, which can't be
+     modified at all.
+
+     A virtual machine that shares a frozen one gets a child of its
+     environment instead, which shadows the well-known mutable symbols
+     with its own.
      */
 
-    lisp_object_t mutable_environment = lisp_environment_create(environment);
+    lisp_object_t parent_environment = environment;
+    if (lisp_environment_shared_vm != NULL) {
+        parent_environment = lisp_vm_get_environment(lisp_environment_shared_vm);
+    }
+    lisp_object_t mutable_environment = lisp_environment_create(parent_environment);
 
     /*
-     Set up the built-in streams for our current environment.
+     Set up the built-in special forms and streams for our current
+     environment.
      */
+    lisp_environment_initialize_built_in_special_forms(mutable_environment);
     lisp_environment_add_built_in_streams(mutable_environment);
+    lisp_printing_initialize(mutable_environment);
 
     return mutable_environment;
 }
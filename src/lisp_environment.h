@@ -10,6 +10,7 @@
 
 
 #include "lisp_types.h"
+#include "lisp_vm.h"
 
 
 /**
@@ -76,6 +77,9 @@ LISP_EXTERN lisp_object_t lisp_environment_get_symbol_value(lisp_object_t enviro
  Set the specified type of value for a symbol in the given environment,
  or (if requestsed) in whatever parent environment contains it.
 
+ - Note: The root environment is constant, so a symbol it contains
+         must not be set recursively.
+
  - Parameters:
    - environment: The environment in which to look up the symbol.
    - symbol: The atom representing the symbol to look up.
@@ -91,6 +95,67 @@ LISP_EXTERN lisp_object_t lisp_environment_set_symbol_value(lisp_object_t enviro
                                                             lisp_object_t value,
                                                             lisp_object_t recursive);
 
+/**
+ Remove the specified type of value for a symbol in the given
+ environment, or (if requested) in whatever parent environment contains
+ it. If that leaves the symbol with no values, the symbol's entry is
+ removed from the environment entirely, so that environments don't keep
+ growing as symbols are bound and unbound.
+
+ - Parameters:
+   - environment: The environment in which to look up the symbol.
+   - symbol: The atom representing the symbol to look up.
+   - type: The specific type of value to remove, such as APVAL, SUBR,
+           and so on.
+   - recursive: Whether to search parent environments for the symbol.
+ - Returns: `T` if a value was removed, `NIL` if there was none or
+            the symbol is in the root environment, which is constant.
+ */
+LISP_EXTERN lisp_object_t lisp_environment_remove_symbol_value(lisp_object_t environment,
+                                                               lisp_object_t symbol,
+                                                               lisp_object_t type,
+                                                               lisp_object_t recursive);
+
+/**
+ Get every binding visible in the given environment other than those
+ in the root environment, for saving them elsewhere.
+
+ - Returns: A list of the environment entries, each a symbol consed onto
+            its plist, innermost first. A symbol shadowed by a binding
+            in an inner environment only appears once, and the links to
+            parent environments aren't included.
+ */
+LISP_EXTERN lisp_object_t lisp_environment_bindings(lisp_object_t environment);
+
+/**
+ Get the number of environments in which the given symbol is bound.
+
+ Environments are never torn down, so this counts bindings in every
+ environment that has ever been created, not just ones that are active.
+ */
+LISP_EXTERN uintptr_t lisp_environment_binding_count(lisp_object_t symbol);
+
+/**
+ Get the function epoch, which changes whenever a change to any
+ environment might change which function a symbol names: when a `SUBR`
+ or `EXPR` is set or any value is removed, or when a symbol becomes
+ bound in a second environment and might therefore be shadowed.
+
+ Anything that caches the function a symbol names is only valid while
+ the epoch stays the same.
+ */
+LISP_EXTERN uintptr_t lisp_environment_function_epoch(void);
+
+/**
+ Get the stream epoch, which changes whenever `*TERMINAL-IO*`,
+ `*STANDARD-INPUT*`, or `*STANDARD-OUTPUT*` has a value set or removed
+ in any environment.
+
+ Anything that caches the stream one of those symbols is bound to is
+ only valid while the epoch stays the same.
+ */
+LISP_EXTERN uintptr_t lisp_environment_stream_epoch(void);
+
 /**
  "Intern" a symbol for the given atom in the environment, using it as
  its own `APVAL`.
@@ -104,14 +169,14 @@ LISP_EXTERN lisp_object_t lisp_environment_intern_symbol(lisp_object_t environme
 
  It is recursively defined; it is its own `APVAL`.
  */
-LISP_EXTERN lisp_object_t lisp_T;
+LISP_EXTERN lisp_object_t const lisp_T;
 
 /**
  The well-known `NIL` symbol, always in the root environment.
 
  It is recursively defined; it is its own `APVAL`.
  */
-LISP_EXTERN lisp_object_t lisp_NIL;
+LISP_EXTERN lisp_object_t const lisp_NIL;
 
 
 /**
@@ -119,7 +184,7 @@ LISP_EXTERN lisp_object_t lisp_NIL;
 
  This is the plist key for the "print name" a symbol represents.
  */
-LISP_EXTERN lisp_object_t lisp_PNAME;
+LISP_EXTERN lisp_object_t const lisp_PNAME;
 
 /**
  The well-known `EXPR` symbol.
@@ -127,21 +192,21 @@ LISP_EXTERN lisp_object_t lisp_PNAME;
  This is the plist key for the interpretable function (in the form of
  S-expressions) that a symbol represents.
  */
-LISP_EXTERN lisp_object_t lisp_EXPR;
+LISP_EXTERN lisp_object_t const lisp_EXPR;
 
 /**
  The well-known `SUBR` symbol.
 
  This is the plist key for the compiled function a symbol represents.
  */
-LISP_EXTERN lisp_object_t lisp_SUBR;
+LISP_EXTERN lisp_object_t const lisp_SUBR;
 
 /**
  The well-known `APVAL` symbol.
 
  This is the plist key for the variable a symbol represents.
  */
-LISP_EXTERN lisp_object_t lisp_APVAL;
+LISP_EXTERN lisp_object_t const lisp_APVAL;
 
 
 /**
@@ -154,7 +219,7 @@ LISP_EXTERN lisp_object_t lisp_APVAL;
  - Warning: This is a symbol, not a stream! It must be looked up in
             the current environment!
  */
-LISP_EXTERN lisp_object_t lisp_TERMINAL_IO;
+#define lisp_TERMINAL_IO (lisp_vm_current->TERMINAL_IO)
 
 /**
  The well-known `*STANDARD-INPUT*` symbol.
@@ -165,7 +230,7 @@ LISP_EXTERN lisp_object_t lisp_TERMINAL_IO;
  - Warning: This is a symbol, not a stream! It must be looked up in
             the current environment!
  */
-LISP_EXTERN lisp_object_t lisp_STANDARD_INPUT;
+#define lisp_STANDARD_INPUT (lisp_vm_current->STANDARD_INPUT)
 
 /**
  The well-known `*STANDARD-OUTPUT*` symbol.
@@ -176,7 +241,7 @@ LISP_EXTERN lisp_object_t lisp_STANDARD_INPUT;
  - Warning: This is a symbol, not a stream! It must be looked up in
             the current environment!
  */
-LISP_EXTERN lisp_object_t lisp_STANDARD_OUTPUT;
+#define lisp_STANDARD_OUTPUT (lisp_vm_current->STANDARD_OUTPUT)
 
 
 #endif  /* __lisp_environment__ */
@@ -7,15 +7,23 @@
 
 #include "lisp_evaluation.h"
 
+#include "lisp_atom.h"
 #include "lisp_cell.h"
 #include "lisp_environment.h"
+#include "lisp_fixnum.h"
+#include "lisp_hash_table.h"
 #include "lisp_plist.h"
 #include "lisp_subr.h"
+#include "lisp_vm.h"
 
 #include "lisp_built_in_sforms.h"
 
+#include <stddef.h>
+
 
 static lisp_object_t lisp_eval_atom(lisp_object_t environment, lisp_object_t atom);
+static lisp_object_t lisp_eval_function_atom(lisp_object_t environment, lisp_object_t cell, lisp_object_t atom);
+static int lisp_eval_visiblep(lisp_object_t environment, lisp_object_t binding_environment);
 static lisp_object_t lisp_eval_cell(lisp_object_t environment, lisp_object_t cell);
 
 static lisp_object_t lisp_eval_argument_list(lisp_object_t environment, lisp_object_t list);
@@ -23,9 +31,43 @@ static lisp_object_t lisp_eval_argument_list(lisp_object_t environment, lisp_obj
 static lisp_object_t lisp_apply_expr(lisp_object_t environment, lisp_object_t function, lisp_object_t arguments);
 static lisp_object_t lisp_apply_subr(lisp_object_t environment, lisp_object_t function, lisp_object_t arguments);
 
+static lisp_object_t lisp_eval_folded_lambda(lisp_object_t environment, lisp_object_t function);
+static lisp_object_t lisp_eval_fold(lisp_object_t environment, lisp_object_t parameters, lisp_object_t form);
+static lisp_object_t lisp_eval_fold_list(lisp_object_t environment, lisp_object_t parameters, lisp_object_t list);
+static lisp_object_t lisp_eval_fold_lambda_form(lisp_object_t environment, lisp_object_t parameters, lisp_object_t lambda);
+static lisp_object_t lisp_eval_fold_IF(lisp_object_t environment, lisp_object_t parameters, lisp_object_t form);
+static lisp_object_t lisp_eval_fold_COND(lisp_object_t environment, lisp_object_t parameters, lisp_object_t form);
+static lisp_object_t lisp_eval_fold_pure_subr(lisp_object_t environment, lisp_object_t parameters, lisp_object_t atom);
+static int lisp_eval_fold_constantp(lisp_object_t parameters, lisp_object_t form);
+static lisp_object_t lisp_eval_fold_constant_value(lisp_object_t form);
+static lisp_object_t lisp_eval_fold_constant_form(lisp_object_t value);
+static int lisp_eval_fold_parameterp(lisp_object_t parameters, lisp_object_t atom);
+
+
+/*
+ The function each call site names, keyed by the call site's cell. Each
+ value is a list of the function epoch when the function was looked up,
+ the environment its binding was found in, and the function itself.
+ */
+#define lisp_eval_call_site_cache (lisp_vm_current->call_site_cache)
+
+/*
+ How each folded `LAMBDA` form was folded, keyed by the form. Each value
+ is a list of the function epoch when it was last folded, the result of
+ that folding, and the form it was folded from.
+ */
+#define lisp_eval_folded_lambdas (lisp_vm_current->folded_lambdas)
+
 
 /* MARK: - Evaluation */
 
+lisp_object_t lisp_eval_initialize(lisp_object_t environment)
+{
+    lisp_eval_call_site_cache = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+    lisp_eval_folded_lambdas = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+    return lisp_T;
+}
+
 lisp_object_t lisp_eval(lisp_object_t environment,
                         lisp_object_t form)
 {
@@ -66,10 +108,17 @@ lisp_object_t lisp_eval(lisp_object_t environment,
  3. Its `APVAL` since this repreesents a variable binding.
 
  If no entry exists for the atom in the environment, the atom evaluates
- to `NIL`.
+ to `NIL`. Keywords, whose names begin with a colon, always evaluate to
+ themselves.
  */
 lisp_object_t lisp_eval_atom(lisp_object_t environment, lisp_object_t atom)
 {
+    /* Keywords evaluate to themselves. */
+    const char *name = (const char *)lisp_atom_get_value(atom);
+    if (name[0] == ':') {
+        return atom;
+    }
+
     /* Check whether the atom has an entry in the environment at all. */
     lisp_object_t symbol = lisp_environment_find_symbol(environment, atom, lisp_T);
     lisp_object_t plist = lisp_cell_cdr(symbol);
@@ -79,27 +128,91 @@ lisp_object_t lisp_eval_atom(lisp_object_t environment, lisp_object_t atom)
         return lisp_NIL;
     }
 
-    /* Return the atom's SUBR if it has one. */
-    lisp_object_t subr = lisp_plist_get(plist, lisp_SUBR);
-    if (subr != lisp_NIL) {
-        return subr;
+    /*
+     Return the atom's SUBR, EXPR, or APVAL, whichever it has first in that
+     order, looking for all three in one pass over its plist. If it has
+     none of them, this is NIL.
+     */
+    const lisp_object_t types[] = { lisp_SUBR, lisp_EXPR, lisp_APVAL };
+    return lisp_plist_get_first(plist, types, 3);
+}
+
+/**
+ Determine whether a binding in one environment is visible from
+ another, that is, whether it's the other or one of its parents.
+ */
+static int lisp_eval_visiblep(lisp_object_t environment, lisp_object_t binding_environment)
+{
+    for (lisp_object_t e = environment; e != lisp_NIL; e = lisp_environment_parent(e)) {
+        if (e == binding_environment) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Evaluate an atom in function position at the given call site.
+
+ The `SUBR` or `EXPR` a call site names is cached, so that evaluating
+ the call site again skips looking up the atom. This is only done when
+ the atom is bound in just one environment, since otherwise it could
+ name different functions depending on the environment the call site is
+ evaluated in. The cache entry is valid until the function epoch
+ changes, which happens whenever a `SUBR` or `EXPR` is set, a value is
+ removed, or an atom becomes bound in a second environment. Since that
+ one environment may be a call's, such as one a `DEFUN` in a function
+ body binds in, the entry is also only used where it's visible.
+ */
+lisp_object_t lisp_eval_function_atom(lisp_object_t environment, lisp_object_t cell, lisp_object_t atom)
+{
+    /* Keywords evaluate to themselves. */
+    const char *name = (const char *)lisp_atom_get_value(atom);
+    if (name[0] == ':') {
+        return atom;
     }
 
-    /* Return the atom's EXPR if it has one. */
-    lisp_object_t expr = lisp_plist_get(plist, lisp_EXPR);
-    if (expr != lisp_NIL) {
-        return expr;
+    const lisp_object_t epoch = lisp_fixnum_create((lisp_fixnum_t) lisp_environment_function_epoch());
+
+    lisp_object_t cached = lisp_hash_table_get(lisp_eval_call_site_cache, cell, lisp_NIL);
+    if ((cached != lisp_NIL) && (lisp_cell_car(cached) == epoch)) {
+        lisp_object_t binding = lisp_cell_cdr(cached);
+        if (lisp_eval_visiblep(environment, lisp_cell_car(binding))) {
+            return lisp_cell_cdr(binding);
+        }
     }
 
-    /* Return the atom's APVAL if it has one. */
-    lisp_object_t apval = lisp_plist_get(plist, lisp_APVAL);
-    if (apval != lisp_NIL) {
-        return apval;
+    /* Find the environment the atom is bound in, and its entry there. */
+    lisp_object_t binding_environment = environment;
+    lisp_object_t symbol = lisp_NIL;
+    while (binding_environment != lisp_NIL) {
+        symbol = lisp_environment_find_symbol(binding_environment, atom, lisp_NIL);
+        if (symbol != lisp_NIL) {
+            break;
+        }
+        binding_environment = lisp_environment_parent(binding_environment);
     }
 
-    /* The atom doesn't have a SUBR, EXPR, or APVAL so just return NIL. */
+    /* Only a SUBR or EXPR of an atom bound in one environment is cached. */
+    lisp_object_t plist = lisp_cell_cdr(symbol);
+    if ((symbol != lisp_NIL) && (plist != lisp_NIL)
+        && (lisp_environment_binding_count(atom) == 1))
+    {
+        const lisp_object_t types[] = { lisp_SUBR, lisp_EXPR };
+        lisp_object_t function = lisp_plist_get_first(plist, types, 2);
+        if (function != lisp_NIL) {
+            if (cached != lisp_NIL) {
+                lisp_cell_rplaca(cached, epoch);
+                lisp_cell_rplacd(cached, lisp_cell_cons(binding_environment, function));
+            } else {
+                lisp_hash_table_put(lisp_eval_call_site_cache, cell,
+                                    lisp_cell_cons(epoch, lisp_cell_cons(binding_environment, function)));
+            }
+            return function;
+        }
+    }
 
-    return lisp_NIL;
+    return lisp_eval_atom(environment, atom);
 }
 
 /**
@@ -129,7 +242,7 @@ lisp_object_t lisp_eval_cell(lisp_object_t environment, lisp_object_t cell)
         if (lisp_eval_is_special_form(car)) {
             result = lisp_eval_special_form(environment, car, cell);
         } else {
-            lisp_object_t function = lisp_eval_atom(environment, car);
+            lisp_object_t function = lisp_eval_function_atom(environment, cell, car);
             if (function != lisp_NIL) {
                 lisp_object_t arguments = lisp_cell_cdr(cell);
                 lisp_object_t evaluated_arguments = lisp_eval_argument_list(environment, arguments);
@@ -260,6 +373,9 @@ lisp_object_t lisp_environment_bind_variables(lisp_object_t environment,
  */
 lisp_object_t lisp_apply_expr(lisp_object_t environment, lisp_object_t function, lisp_object_t arguments)
 {
+    /* Apply what the function folds to now, rather than when it was defined. */
+    function = lisp_eval_folded_lambda(environment, function);
+
     /* Create an environment in which the application takes place. */
     lisp_object_t application_environment = lisp_environment_create(environment);
 
@@ -300,3 +416,373 @@ lisp_object_t lisp_apply_subr(lisp_object_t environment, lisp_object_t function,
 
     return lisp_subr_call(function, environment, arguments);
 }
+
+
+/* MARK: - Folding */
+
+lisp_object_t lisp_eval_fold_lambda(lisp_object_t environment, lisp_object_t lambda)
+{
+    const lisp_object_t epoch = lisp_fixnum_create((lisp_fixnum_t) lisp_environment_function_epoch());
+
+    lisp_object_t folded = lisp_eval_fold_lambda_form(environment, lisp_NIL, lambda);
+    lisp_hash_table_put(lisp_eval_folded_lambdas, folded, lisp_cell_list(epoch, folded, lambda, lisp_NIL));
+    return folded;
+}
+
+/**
+ Get what a `LAMBDA` form folds to in an environment.
+
+ Folding assumes each atom a pure `SUBR` is bound to names it wherever
+ the form is applied, which an application of some other function may
+ have since made false: under dynamic scope, a parameter of a caller
+ with the same name shadows the `SUBR`. Anything that could do so also
+ changes the function epoch, so the form is folded anew from the one it
+ was folded from whenever the epoch has changed.
+
+ A form folded in a shared virtual machine is refolded in this one,
+ since the shared one can't change.
+ */
+lisp_object_t lisp_eval_folded_lambda(lisp_object_t environment, lisp_object_t function)
+{
+    lisp_object_t folding = lisp_hash_table_get(lisp_eval_folded_lambdas, function, lisp_NIL);
+    for (lisp_vm_t vm = lisp_vm_current->shared;
+         (folding == lisp_NIL) && (vm != NULL);
+         vm = vm->shared)
+    {
+        lisp_object_t shared_folding = lisp_hash_table_get(vm->folded_lambdas, function, lisp_NIL);
+        if (shared_folding != lisp_NIL) {
+            lisp_object_t original = lisp_cell_car(lisp_cell_cdr(lisp_cell_cdr(shared_folding)));
+            folding = lisp_cell_cons(lisp_NIL, lisp_cell_cons(function, lisp_cell_cons(original, lisp_NIL)));
+            lisp_hash_table_put(lisp_eval_folded_lambdas, function, folding);
+        }
+    }
+    if (folding == lisp_NIL) {
+        return function;
+    }
+
+    const lisp_object_t epoch = lisp_fixnum_create((lisp_fixnum_t) lisp_environment_function_epoch());
+    if (lisp_cell_car(folding) != epoch) {
+        lisp_object_t original = lisp_cell_car(lisp_cell_cdr(lisp_cell_cdr(folding)));
+        lisp_cell_rplaca(folding, epoch);
+        lisp_cell_rplaca(lisp_cell_cdr(folding),
+                         lisp_eval_fold_lambda_form(environment, lisp_NIL, original));
+    }
+
+    return lisp_cell_car(lisp_cell_cdr(folding));
+}
+
+/**
+ Fold a form, given the parameters of the `LAMBDA` forms that enclose it.
+
+ Only the special forms whose structure the folder understands are
+ descended into; any other special form is left alone. Anything else is
+ a function call, whose arguments are folded and which is itself folded
+ if it calls a pure `SUBR` with constant arguments.
+ */
+lisp_object_t lisp_eval_fold(lisp_object_t environment, lisp_object_t parameters, lisp_object_t form)
+{
+    if (lisp_cellp(form) == lisp_NIL) {
+        return form;
+    }
+
+    lisp_object_t car = lisp_cell_car(form);
+    lisp_object_t rest = lisp_cell_cdr(form);
+
+    if (car == lisp_symbol_QUOTE) {
+        return form;
+    } else if (car == lisp_symbol_LAMBDA) {
+        return lisp_eval_fold_lambda_form(environment, parameters, form);
+    } else if (car == lisp_symbol_IF) {
+        return lisp_eval_fold_IF(environment, parameters, form);
+    } else if (car == lisp_symbol_COND) {
+        return lisp_eval_fold_COND(environment, parameters, form);
+    } else if ((car == lisp_symbol_AND) || (car == lisp_symbol_OR)) {
+        lisp_object_t folded_rest = lisp_eval_fold_list(environment, parameters, rest);
+        return (folded_rest == rest) ? form : lisp_cell_cons(car, folded_rest);
+    } else if ((car == lisp_symbol_BLOCK) || (car == lisp_symbol_SETQ)) {
+        /* Leave the tag or variable alone, and fold what follows it. */
+        lisp_object_t name = lisp_cell_car(rest);
+        lisp_object_t body = lisp_cell_cdr(rest);
+        lisp_object_t folded_body = lisp_eval_fold_list(environment, parameters, body);
+        return (folded_body == body) ? form : lisp_cell_cons(car, lisp_cell_cons(name, folded_body));
+    } else if ((lisp_atomp(car) != lisp_NIL) && lisp_eval_is_special_form(car)) {
+        return form;
+    }
+
+    /* This is a function call, so fold its function and arguments. */
+    lisp_object_t folded_car = lisp_eval_fold(environment, parameters, car);
+    lisp_object_t folded_rest = lisp_eval_fold_list(environment, parameters, rest);
+
+    lisp_object_t subr = lisp_NIL;
+    if (lisp_atomp(car) != lisp_NIL) {
+        subr = lisp_eval_fold_pure_subr(environment, parameters, car);
+    }
+
+    if (subr != lisp_NIL) {
+        int constant = 1;
+        for (lisp_object_t next = folded_rest; next != lisp_NIL; next = lisp_cell_cdr(next)) {
+            if (!lisp_eval_fold_constantp(parameters, lisp_cell_car(next))) {
+                constant = 0;
+                break;
+            }
+        }
+
+        if (constant) {
+            lisp_object_t values = lisp_NIL;
+            lisp_object_t values_last = lisp_NIL;
+            for (lisp_object_t next = folded_rest; next != lisp_NIL; next = lisp_cell_cdr(next)) {
+                lisp_object_t value = lisp_eval_fold_constant_value(lisp_cell_car(next));
+                lisp_object_t value_cell = lisp_cell_cons(value, lisp_NIL);
+                if (values == lisp_NIL) {
+                    values = value_cell;
+                } else {
+                    lisp_cell_rplacd(values_last, value_cell);
+                }
+                values_last = value_cell;
+            }
+
+            lisp_object_t result = lisp_subr_call(subr, environment, values);
+            return lisp_eval_fold_constant_form(result);
+        }
+    }
+
+    if ((folded_car == car) && (folded_rest == rest)) {
+        return form;
+    } else {
+        return lisp_cell_cons(folded_car, folded_rest);
+    }
+}
+
+/**
+ Fold each form in a list.
+
+ - Returns: The list itself if no form in it changed, or a new list of
+            the folded forms.
+ */
+lisp_object_t lisp_eval_fold_list(lisp_object_t environment, lisp_object_t parameters, lisp_object_t list)
+{
+    int changed = 0;
+    lisp_object_t folded = lisp_NIL;
+    lisp_object_t folded_last = lisp_NIL;
+
+    for (lisp_object_t next = list; next != lisp_NIL; next = lisp_cell_cdr(next)) {
+        lisp_object_t form = lisp_cell_car(next);
+        lisp_object_t folded_form = lisp_eval_fold(environment, parameters, form);
+        if (folded_form != form) {
+            changed = 1;
+        }
+
+        lisp_object_t folded_cell = lisp_cell_cons(folded_form, lisp_NIL);
+        if (folded == lisp_NIL) {
+            folded = folded_cell;
+        } else {
+            lisp_cell_rplacd(folded_last, folded_cell);
+        }
+        folded_last = folded_cell;
+    }
+
+    return changed ? folded : list;
+}
+
+/**
+ Fold the body of a `LAMBDA` form, adding its parameters to those of the
+ `LAMBDA` forms that enclose it since any of them may shadow a function.
+ */
+lisp_object_t lisp_eval_fold_lambda_form(lisp_object_t environment, lisp_object_t parameters, lisp_object_t lambda)
+{
+    lisp_object_t lambda_list = lisp_cell_car(lisp_cell_cdr(lambda));
+    lisp_object_t body = lisp_cell_cdr(lisp_cell_cdr(lambda));
+
+    lisp_object_t body_parameters = parameters;
+    for (lisp_object_t next = lambda_list; next != lisp_NIL; next = lisp_cell_cdr(next)) {
+        body_parameters = lisp_cell_cons(lisp_cell_car(next), body_parameters);
+    }
+
+    lisp_object_t folded_body = lisp_eval_fold_list(environment, body_parameters, body);
+    if (folded_body == body) {
+        return lambda;
+    } else {
+        return lisp_cell_cons(lisp_symbol_LAMBDA, lisp_cell_cons(lambda_list, folded_body));
+    }
+}
+
+/**
+ Fold an `IF` form, replacing it with just the branch it takes if its
+ test is constant.
+ */
+lisp_object_t lisp_eval_fold_IF(lisp_object_t environment, lisp_object_t parameters, lisp_object_t form)
+{
+    lisp_object_t rest = lisp_cell_cdr(form);
+    lisp_object_t folded_rest = lisp_eval_fold_list(environment, parameters, rest);
+
+    lisp_object_t test = lisp_cell_car(folded_rest);
+    if (lisp_eval_fold_constantp(parameters, test)) {
+        lisp_object_t branches = lisp_cell_cdr(folded_rest);
+        if (lisp_eval_fold_constant_value(test) != lisp_NIL) {
+            return lisp_cell_car(branches);
+        } else {
+            return lisp_cell_car(lisp_cell_cdr(branches));
+        }
+    }
+
+    return (folded_rest == rest) ? form : lisp_cell_cons(lisp_symbol_IF, folded_rest);
+}
+
+/**
+ Fold a `COND` form, dropping the clauses whose tests are constant `NIL`
+ and those after the first clause whose test is constant non-`NIL`.
+ */
+lisp_object_t lisp_eval_fold_COND(lisp_object_t environment, lisp_object_t parameters, lisp_object_t form)
+{
+    int changed = 0;
+    lisp_object_t clauses = lisp_NIL;
+    lisp_object_t clauses_last = lisp_NIL;
+
+    for (lisp_object_t next = lisp_cell_cdr(form); next != lisp_NIL; next = lisp_cell_cdr(next)) {
+        lisp_object_t clause = lisp_cell_car(next);
+        lisp_object_t folded_clause = lisp_eval_fold_list(environment, parameters, clause);
+        if (folded_clause != clause) {
+            changed = 1;
+        }
+
+        lisp_object_t test = lisp_cell_car(folded_clause);
+        int constant = lisp_eval_fold_constantp(parameters, test);
+        if (constant && (lisp_eval_fold_constant_value(test) == lisp_NIL)) {
+            /* This clause can never be taken. */
+            changed = 1;
+            continue;
+        }
+
+        lisp_object_t clause_cell = lisp_cell_cons(folded_clause, lisp_NIL);
+        if (clauses == lisp_NIL) {
+            clauses = clause_cell;
+        } else {
+            lisp_cell_rplacd(clauses_last, clause_cell);
+        }
+        clauses_last = clause_cell;
+
+        if (constant) {
+            /* This clause is always taken, so none after it can be. */
+            if (lisp_cell_cdr(next) != lisp_NIL) {
+                changed = 1;
+            }
+            break;
+        }
+    }
+
+    if (clauses == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    return changed ? lisp_cell_cons(lisp_symbol_COND, clauses) : form;
+}
+
+/**
+ Get the pure `SUBR` an atom in function position names, if any.
+
+ The atom must not be a parameter of an enclosing `LAMBDA` and must be
+ bound in just one environment, since otherwise it could name a
+ different function when the form is evaluated. Anything that could
+ make the atom name something else changes the function epoch, after
+ which `lisp_eval_folded_lambda` folds the form again.
+ */
+lisp_object_t lisp_eval_fold_pure_subr(lisp_object_t environment, lisp_object_t parameters, lisp_object_t atom)
+{
+    const char *name = (const char *)lisp_atom_get_value(atom);
+    if (name[0] == ':') {
+        return lisp_NIL;
+    }
+
+    if (lisp_eval_fold_parameterp(parameters, atom)) {
+        return lisp_NIL;
+    }
+
+    if (lisp_environment_binding_count(atom) != 1) {
+        return lisp_NIL;
+    }
+
+    lisp_object_t symbol = lisp_environment_find_symbol(environment, atom, lisp_T);
+    lisp_object_t plist = lisp_cell_cdr(symbol);
+    if ((symbol == lisp_NIL) || (plist == lisp_NIL)) {
+        return lisp_NIL;
+    }
+
+    lisp_object_t subr = lisp_plist_get(plist, lisp_SUBR);
+    if ((subr == lisp_NIL) || (lisp_subr_purep(subr) == lisp_NIL)) {
+        return lisp_NIL;
+    }
+
+    return subr;
+}
+
+/**
+ Indicate whether a form is a constant, which is a quoted form, `T`,
+ `NIL`, a keyword, or a fixnum, character, or string. `T` and `NIL`
+ aren't constant where a parameter shadows them.
+ */
+int lisp_eval_fold_constantp(lisp_object_t parameters, lisp_object_t form)
+{
+    lisp_tag_t tag = lisp_object_get_tag(form);
+
+    switch (tag) {
+        case lisp_tag_cell:
+            return lisp_cell_car(form) == lisp_symbol_QUOTE;
+
+        case lisp_tag_atom: {
+            const char *name = (const char *)lisp_atom_get_value(form);
+            if (name[0] == ':') {
+                return 1;
+            }
+            if ((form == lisp_T) || (form == lisp_NIL)) {
+                return !lisp_eval_fold_parameterp(parameters, form);
+            }
+            return 0;
+        }
+
+        case lisp_tag_fixnum:
+        case lisp_tag_char:
+        case lisp_tag_string:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+/** Get the value of a constant form. */
+lisp_object_t lisp_eval_fold_constant_value(lisp_object_t form)
+{
+    if (lisp_cellp(form) != lisp_NIL) {
+        return lisp_cell_car(lisp_cell_cdr(form));
+    } else {
+        return form;
+    }
+}
+
+/** Get a form that evaluates to a value, quoting it if necessary. */
+lisp_object_t lisp_eval_fold_constant_form(lisp_object_t value)
+{
+    if (lisp_cellp(value) != lisp_NIL) {
+        return lisp_cell_list(lisp_symbol_QUOTE, value, lisp_NIL);
+    }
+
+    if ((lisp_atomp(value) != lisp_NIL) && (value != lisp_T) && (value != lisp_NIL)) {
+        const char *name = (const char *)lisp_atom_get_value(value);
+        if (name[0] != ':') {
+            return lisp_cell_list(lisp_symbol_QUOTE, value, lisp_NIL);
+        }
+    }
+
+    return value;
+}
+
+/** Indicate whether an atom is one of the given parameters. */
+int lisp_eval_fold_parameterp(lisp_object_t parameters, lisp_object_t atom)
+{
+    for (lisp_object_t next = parameters; next != lisp_NIL; next = lisp_cell_cdr(next)) {
+        if (lisp_cell_car(next) == atom) {
+            return 1;
+        }
+    }
+    return 0;
+}
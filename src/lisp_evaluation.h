@@ -17,7 +17,8 @@
 
  This is necessary only when establishing a root environment. It ensures
  that everything necessary for evaluation is set up, so it doesn't need
- to be set up on the fly.
+ to be set up on the fly, including the (empty) cache of the functions
+ named at each call site.
  */
 LISP_EXTERN lisp_object_t lisp_eval_initialize(lisp_object_t environment);
 
@@ -52,4 +53,26 @@ LISP_EXTERN lisp_object_t lisp_apply(lisp_object_t environment,
                                      lisp_object_t arguments);
 
 
+/**
+ Fold the constant subexpressions in the body of a `LAMBDA` form.
+
+ A call to a pure `SUBR` whose arguments are all constants is replaced
+ by its result, and an `IF` or `COND` whose test is constant is replaced
+ by just the forms it can actually evaluate. This is done when a
+ function is defined, so that its body doesn't redo the same work every
+ time it's applied; whenever the function epoch has changed since, it's
+ redone from the original form the next time the result is applied, so
+ a call never uses a `SUBR` that's no longer the one its atom names.
+
+ - Parameters:
+   - environment: The environment in which the function is defined,
+                  which determines the functions that calls name.
+   - lambda: The `LAMBDA` form to fold.
+ - Returns: The `LAMBDA` form itself if nothing in it could be folded,
+            or a new `LAMBDA` form with the folded body.
+ */
+LISP_EXTERN lisp_object_t lisp_eval_fold_lambda(lisp_object_t environment,
+                                                lisp_object_t lambda);
+
+
 #endif  /* __lisp_evaluation__ */
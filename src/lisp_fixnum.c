@@ -8,10 +8,7 @@
 #include "lisp_fixnum.h"
 
 #include "lisp_environment.h"
-#include "lisp_printing.h"
-#include "lisp_string.h"
-
-#include <stdio.h>
+#include "lisp_stream.h"
 
 
 /*
@@ -76,12 +73,76 @@ intptr_t lisp_fixnum_get_value(lisp_object_t object)
 
 lisp_object_t lisp_fixnum_print(lisp_object_t stream, lisp_fixnum_t fixnum_value)
 {
-    char buffer[21];
-    long long print_value = (long long)fixnum_value;
-    snprintf(buffer, 21, "%lld", print_value);
-    lisp_object_t string = lisp_string_create_c(buffer);
-    lisp_string_t string_value = lisp_string_get_value(string);
-    return lisp_string_print_quoted(stream, string_value, lisp_NIL);
+    return lisp_fixnum_print_radix(stream, fixnum_value, 10, 0, ' ');
+}
+
+
+uintptr_t lisp_fixnum_format(char *buffer, lisp_fixnum_t fixnum_value, unsigned int radix)
+{
+    static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    if ((radix < 2) || (radix > 36)) {
+        return 0;
+    }
+
+    /*
+     Work with the magnitude as an unsigned value, so that negating the
+     most negative value can't overflow.
+     */
+    uintptr_t magnitude = (fixnum_value < 0) ? ((uintptr_t)0 - (uintptr_t)fixnum_value) : (uintptr_t)fixnum_value;
+
+    /* Produce the digits from the end of the buffer backwards. */
+    char *end = buffer + LISP_FIXNUM_FORMAT_SIZE;
+    char *start = end;
+    do {
+        start -= 1;
+        *start = digits[magnitude % radix];
+        magnitude = magnitude / radix;
+    } while (magnitude > 0);
+
+    if (fixnum_value < 0) {
+        start -= 1;
+        *start = '-';
+    }
+
+    /* Move them to the front of the buffer. */
+    uintptr_t length = (uintptr_t)(end - start);
+    for (uintptr_t i = 0; i < length; i++) {
+        buffer[i] = start[i];
+    }
+
+    return length;
+}
+
+
+lisp_object_t lisp_fixnum_print_radix(lisp_object_t stream,
+                                      lisp_fixnum_t fixnum_value,
+                                      unsigned int radix,
+                                      uintptr_t width,
+                                      char padding)
+{
+    char buffer[LISP_FIXNUM_FORMAT_SIZE];
+    uintptr_t length = lisp_fixnum_format(buffer, fixnum_value, radix);
+    if (length == 0) {
+        return lisp_NIL;
+    }
+
+    if (width > length) {
+        char padding_buffer[16];
+        for (uintptr_t i = 0; i < sizeof(padding_buffer); i++) {
+            padding_buffer[i] = padding;
+        }
+
+        uintptr_t remaining = width - length;
+        while (remaining > 0) {
+            uintptr_t count = (remaining < sizeof(padding_buffer)) ? remaining : sizeof(padding_buffer);
+            lisp_stream_write_bytes(stream, (const unsigned char *)padding_buffer, count);
+            remaining -= count;
+        }
+    }
+
+    lisp_stream_write_bytes(stream, (const unsigned char *)buffer, length);
+    return lisp_T;
 }
 
 
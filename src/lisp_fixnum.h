@@ -34,6 +34,39 @@ LISP_EXTERN intptr_t lisp_fixnum_get_value(lisp_object_t object);
 /** Prints the fixnum to the given output stream. */
 LISP_EXTERN lisp_object_t lisp_fixnum_print(lisp_object_t stream, lisp_fixnum_t fixnum_value);
 
+/**
+ The size of a buffer large enough for any fixnum formatted by
+ `lisp_fixnum_format`, which is a sign and one digit per bit.
+ */
+#define LISP_FIXNUM_FORMAT_SIZE (1 + (sizeof(lisp_fixnum_t) * 8))
+
+/**
+ Format the digits of a fixnum into a C buffer, without allocating.
+
+ - Parameters:
+   - buffer: The buffer, which must hold `LISP_FIXNUM_FORMAT_SIZE`
+             characters. It isn't `NUL`-terminated.
+   - fixnum_value: The value to format.
+   - radix: The radix to format in, from 2 to 36.
+ - Returns: The number of characters formatted, or `0` if the radix is
+            out of range.
+ */
+LISP_EXTERN uintptr_t lisp_fixnum_format(char *buffer,
+                                         lisp_fixnum_t fixnum_value,
+                                         unsigned int radix);
+
+/**
+ Prints the fixnum to the given output stream in the given radix, padded
+ on the left with the padding character to at least the given width.
+
+ - Returns: `T`, or `NIL` if the radix is out of range.
+ */
+LISP_EXTERN lisp_object_t lisp_fixnum_print_radix(lisp_object_t stream,
+                                                  lisp_fixnum_t fixnum_value,
+                                                  unsigned int radix,
+                                                  uintptr_t width,
+                                                  char padding);
+
 /** Checks two fixnum for equality. */
 LISP_EXTERN lisp_object_t lisp_fixnum_equal(lisp_object_t a, lisp_object_t b);
 
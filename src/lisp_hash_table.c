@@ -0,0 +1,505 @@
+/*
+    File:       lisp_hash_table.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include "lisp_hash_table.h"
+
+#include "lisp_atom.h"
+#include "lisp_cell.h"
+#include "lisp_environment.h"
+#include "lisp_interior.h"
+#include "lisp_memory.h"
+#include "lisp_string.h"
+#include "lisp_struct.h"
+#include "lisp_subr.h"
+#include "lisp_vector.h"
+
+#if LISP_USE_STDLIB
+#include <stdio.h>
+#include <string.h>
+#endif
+
+
+/** The smallest number of slots a hash table is created with. */
+#define LISP_HASH_TABLE_MINIMUM_CAPACITY 8
+
+/** How many old slots each modification moves while growing. */
+#define LISP_HASH_TABLE_MIGRATION_STEP 16
+
+/** How deep into nested structure `EQUAL` hashing looks. */
+#define LISP_HASH_TABLE_EQUAL_DEPTH 4
+
+/** How many elements of a list or vector `EQUAL` hashing looks at. */
+#define LISP_HASH_TABLE_EQUAL_LENGTH 16
+
+/** How many bytes of a struct `EQUAL` hashing looks at. */
+#define LISP_HASH_TABLE_EQUAL_BYTES 64
+
+
+static lisp_hash_table_entry_t lisp_hash_table_allocate(uintptr_t capacity);
+static uint32_t lisp_hash_table_hash(lisp_hash_table_t table_value, lisp_object_t key);
+static lisp_hash_table_entry_t lisp_hash_table_find(lisp_hash_table_t table_value, lisp_hash_table_entry_t entries, uintptr_t capacity, lisp_object_t key, uint32_t hash);
+static void lisp_hash_table_insert(lisp_hash_table_t table_value, lisp_object_t key, lisp_object_t value, uint32_t hash);
+static void lisp_hash_table_delete(lisp_hash_table_t table_value, lisp_hash_table_entry_t entry);
+static void lisp_hash_table_migrate(lisp_hash_table_t table_value, uintptr_t slots);
+static void lisp_hash_table_grow(lisp_hash_table_t table_value);
+
+
+lisp_object_t lisp_hash_table_create(lisp_hash_table_test_t test,
+                                     uintptr_t size)
+{
+    /* Keep the table at most three-quarters full. */
+    uintptr_t capacity = LISP_HASH_TABLE_MINIMUM_CAPACITY;
+    while ((capacity * 3) < (size * 4)) {
+        capacity = capacity * 2;
+    }
+
+    lisp_hash_table_t table_value;
+    lisp_object_t object = lisp_object_allocate(lisp_tag_hash_table, sizeof(struct lisp_hash_table), (void **)&table_value);
+    table_value->test = test;
+    table_value->count = 0;
+    table_value->entries = lisp_hash_table_allocate(capacity);
+    table_value->capacity = capacity;
+    table_value->old_entries = NULL;
+    table_value->old_capacity = 0;
+    table_value->old_index = 0;
+
+    return object;
+}
+
+
+lisp_hash_table_t lisp_hash_table_get_value(lisp_object_t object)
+{
+    uintptr_t raw_value = lisp_object_get_raw_value(object);
+    return (lisp_hash_table_t)raw_value;
+}
+
+
+uintptr_t lisp_hash_table_count(lisp_object_t table)
+{
+    lisp_hash_table_t table_value = lisp_hash_table_get_value(table);
+    return table_value->count;
+}
+
+
+lisp_object_t lisp_hash_table_get(lisp_object_t table,
+                                  lisp_object_t key,
+                                  lisp_object_t default_value)
+{
+    lisp_hash_table_t table_value = lisp_hash_table_get_value(table);
+    const uint32_t hash = lisp_hash_table_hash(table_value, key);
+
+    lisp_hash_table_entry_t entry = lisp_hash_table_find(table_value, table_value->entries, table_value->capacity, key, hash);
+    if ((entry == NULL) && (table_value->old_entries != NULL)) {
+        entry = lisp_hash_table_find(table_value, table_value->old_entries, table_value->old_capacity, key, hash);
+    }
+
+    return (entry != NULL) ? entry->value : default_value;
+}
+
+
+lisp_object_t lisp_hash_table_put(lisp_object_t table,
+                                  lisp_object_t key,
+                                  lisp_object_t value)
+{
+    lisp_hash_table_t table_value = lisp_hash_table_get_value(table);
+    lisp_hash_table_migrate(table_value, LISP_HASH_TABLE_MIGRATION_STEP);
+    const uint32_t hash = lisp_hash_table_hash(table_value, key);
+
+    /* If the key is already present, just replace its value. */
+    lisp_hash_table_entry_t entry = lisp_hash_table_find(table_value, table_value->entries, table_value->capacity, key, hash);
+    if (entry != NULL) {
+        entry->value = value;
+        return value;
+    }
+
+    /* If the key hasn't been moved out of old storage yet, move it now. */
+    if (table_value->old_entries != NULL) {
+        entry = lisp_hash_table_find(table_value, table_value->old_entries, table_value->old_capacity, key, hash);
+        if (entry != NULL) {
+            entry->key = NULL;
+            lisp_hash_table_insert(table_value, key, value, hash);
+            return value;
+        }
+    }
+
+    /* Otherwise add an entry, growing first if the table is too full. */
+    if (((table_value->count + 1) * 4) > (table_value->capacity * 3)) {
+        lisp_hash_table_grow(table_value);
+    }
+    lisp_hash_table_insert(table_value, key, value, hash);
+    table_value->count = table_value->count + 1;
+
+    return value;
+}
+
+
+lisp_object_t lisp_hash_table_remove(lisp_object_t table,
+                                     lisp_object_t key)
+{
+    lisp_hash_table_t table_value = lisp_hash_table_get_value(table);
+    lisp_hash_table_migrate(table_value, LISP_HASH_TABLE_MIGRATION_STEP);
+    const uint32_t hash = lisp_hash_table_hash(table_value, key);
+
+    lisp_hash_table_entry_t entry = lisp_hash_table_find(table_value, table_value->entries, table_value->capacity, key, hash);
+    if (entry != NULL) {
+        lisp_hash_table_delete(table_value, entry);
+        table_value->count = table_value->count - 1;
+        return lisp_T;
+    }
+
+    /*
+     Entries in old storage are only cleared, rather than shifted, so the
+     slots that haven't been moved yet stay where migration expects them.
+     */
+    if (table_value->old_entries != NULL) {
+        entry = lisp_hash_table_find(table_value, table_value->old_entries, table_value->old_capacity, key, hash);
+        if (entry != NULL) {
+            entry->key = NULL;
+            table_value->count = table_value->count - 1;
+            return lisp_T;
+        }
+    }
+
+    return lisp_NIL;
+}
+
+
+void lisp_hash_table_map(lisp_object_t table,
+                         lisp_hash_table_function function,
+                         void *context)
+{
+    lisp_hash_table_t table_value = lisp_hash_table_get_value(table);
+
+    /* Finish growing so every entry is in one place and stays there. */
+    lisp_hash_table_migrate(table_value, table_value->old_capacity);
+
+    /*
+     Start at a slot that doesn't continue a probe sequence, so removing
+     an entry never shifts an entry that's already been visited into a
+     slot that's yet to be visited. There's always an empty slot, so
+     there's always such a slot.
+     */
+    const uintptr_t mask = table_value->capacity - 1;
+    uintptr_t start = 0;
+    while (table_value->entries[start].distance > 1) {
+        start = start + 1;
+    }
+
+    uintptr_t visited = 0;
+    while (visited < table_value->capacity) {
+        lisp_hash_table_entry_t entry = &table_value->entries[(start + visited) & mask];
+        if (entry->distance == 0) {
+            visited = visited + 1;
+            continue;
+        }
+
+        lisp_object_t key = entry->key;
+        (*function)(key, entry->value, context);
+
+        /*
+         If the function removed the entry, the next entry in its probe
+         sequence may have shifted into its slot, so visit it again.
+         */
+        const int removed = (entry->distance == 0) || (entry->key != key);
+        const int shifted = removed && (entry->distance != 0);
+        if (!shifted) {
+            visited = visited + 1;
+        }
+    }
+}
+
+
+/* MARK: - Hashing */
+
+/** Hash an object by identity. */
+static uint32_t lisp_hash_table_hash_eq(lisp_object_t object)
+{
+    /* Multiply by 2^64 / phi so the tag and alignment bits spread out. */
+    uint64_t bits = (uint64_t) (uintptr_t) object;
+    bits = bits * UINT64_C(0x9E3779B97F4A7C15);
+    return (uint32_t) (bits >> 32);
+}
+
+/** Hash some bytes with 32-bit FNV-1a. */
+static uint32_t lisp_hash_table_hash_bytes(uint32_t hash, const unsigned char *bytes, uintptr_t length)
+{
+    for (uintptr_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/** Combine a hash with another value. */
+static uint32_t lisp_hash_table_hash_combine(uint32_t hash, uint32_t value)
+{
+    return hash ^ (value + 0x9E3779B9u + (hash << 6) + (hash >> 2));
+}
+
+/**
+ Hash an object consistently with `EQUAL`, looking no deeper than the
+ given depth into nested structure.
+ */
+static uint32_t lisp_hash_table_hash_equal_bounded(lisp_object_t object, uintptr_t depth)
+{
+    const uint32_t seed = 2166136261u;
+    const lisp_tag_t tag = lisp_object_get_tag(object);
+
+    switch (tag) {
+        case lisp_tag_cell: {
+            if (depth == 0) return (uint32_t) tag;
+
+            uint32_t hash = seed;
+            uintptr_t n = 0;
+            while ((n < LISP_HASH_TABLE_EQUAL_LENGTH) && (lisp_cellp(object) != lisp_NIL)) {
+                hash = lisp_hash_table_hash_combine(hash, lisp_hash_table_hash_equal_bounded(lisp_cell_car(object), depth - 1));
+                object = lisp_cell_cdr(object);
+                n = n + 1;
+            }
+            if (n < LISP_HASH_TABLE_EQUAL_LENGTH) {
+                hash = lisp_hash_table_hash_combine(hash, lisp_hash_table_hash_equal_bounded(object, depth - 1));
+            }
+            return hash;
+        }
+
+        case lisp_tag_vector: {
+            if (depth == 0) return (uint32_t) tag;
+
+            lisp_vector_t vector_value = lisp_vector_get_value(object);
+            uint32_t hash = lisp_hash_table_hash_combine(seed, (uint32_t) vector_value->count);
+            for (uintptr_t i = 0; (i < vector_value->count) && (i < LISP_HASH_TABLE_EQUAL_LENGTH); i++) {
+                hash = lisp_hash_table_hash_combine(hash, lisp_hash_table_hash_equal_bounded(vector_value->values[i], depth - 1));
+            }
+            return hash;
+        }
+
+        case lisp_tag_atom: {
+            const char *name = lisp_atom_get_value(object);
+            return lisp_hash_table_hash_bytes(seed, (const unsigned char *)name, (uintptr_t) strlen(name));
+        }
+
+        case lisp_tag_string: {
+            lisp_string_t string_value = lisp_string_get_value(object);
+            lisp_object_t *chars = (lisp_object_t *)lisp_interior_get_value(string_value->chars);
+            uint32_t hash = seed;
+            for (uintptr_t i = 0; i < string_value->length; i++) {
+                hash = lisp_hash_table_hash_combine(hash, (uint32_t) lisp_char_get_value(chars[i]));
+            }
+            return hash;
+        }
+
+        case lisp_tag_struct: {
+            lisp_struct_t struct_value = lisp_struct_get_value(object);
+            uintptr_t length = struct_value->size;
+            if (length > LISP_HASH_TABLE_EQUAL_BYTES) {
+                length = LISP_HASH_TABLE_EQUAL_BYTES;
+            }
+            uint32_t hash = lisp_hash_table_hash_combine(seed, (uint32_t) struct_value->type);
+            hash = lisp_hash_table_hash_combine(hash, (uint32_t) struct_value->size);
+            return lisp_hash_table_hash_bytes(hash, (const unsigned char *)struct_value->value, length);
+        }
+
+        case lisp_tag_subr: {
+            /* Equal subroutines share a function, so hash that. */
+            lisp_subr_t subr_value = lisp_subr_get_value(object);
+            return lisp_hash_table_hash_eq((lisp_object_t) (uintptr_t) subr_value->function);
+        }
+
+        default: {
+            /* Everything else is only equal when identical. */
+            return lisp_hash_table_hash_eq(object);
+        }
+    }
+}
+
+uintptr_t lisp_hash_table_hash_equal(lisp_object_t object)
+{
+    return (uintptr_t) lisp_hash_table_hash_equal_bounded(object, LISP_HASH_TABLE_EQUAL_DEPTH);
+}
+
+
+/* MARK: - Printing & Equality */
+
+lisp_object_t lisp_hash_table_print(lisp_object_t stream,
+                                    lisp_hash_table_t table_value)
+{
+    /*
+     Print a hash table as #<HASH-TABLE :TEST TEST :COUNT COUNT>, our
+     typical syntax for anything that cannot be directly read.
+     */
+    const char *test_names[] = { "EQ", "EQL", "EQUAL" };
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "#<HASH-TABLE :TEST %s :COUNT %llu>",
+             test_names[table_value->test],
+             (unsigned long long) table_value->count);
+    lisp_object_t buffer_string = lisp_string_create_c(buffer);
+    lisp_string_t buffer_string_value = lisp_string_get_value(buffer_string);
+    return lisp_string_print_quoted(stream, buffer_string_value, lisp_NIL);
+}
+
+
+lisp_object_t lisp_hash_table_equal(lisp_object_t a, lisp_object_t b)
+{
+    if (a == b) {
+        return lisp_T;
+    } else {
+        return lisp_NIL;
+    }
+}
+
+
+/* MARK: - Implementation */
+
+/**
+ Allocate storage for the given number of empty entries on the heap.
+ */
+lisp_hash_table_entry_t lisp_hash_table_allocate(uintptr_t capacity)
+{
+    lisp_hash_table_entry_t entries;
+    const uintptr_t size = sizeof(struct lisp_hash_table_entry) * capacity;
+    lisp_interior_create(size, (void **)&entries);
+    memset(entries, 0, size);
+    return entries;
+}
+
+/**
+ Hash a key according to the table's test.
+ */
+uint32_t lisp_hash_table_hash(lisp_hash_table_t table_value, lisp_object_t key)
+{
+    if (table_value->test == lisp_hash_table_test_equal) {
+        return (uint32_t) lisp_hash_table_hash_equal(key);
+    } else {
+        return lisp_hash_table_hash_eq(key);
+    }
+}
+
+/**
+ Find the entry for a key in some storage.
+
+ A probe can stop as soon as it reaches a slot whose entry is closer to
+ its preferred slot than the key would be, because Robin Hood insertion
+ would have put the key there.
+
+ - Returns: The entry, or `NULL` if the key isn't present.
+ */
+lisp_hash_table_entry_t lisp_hash_table_find(lisp_hash_table_t table_value,
+                                             lisp_hash_table_entry_t entries,
+                                             uintptr_t capacity,
+                                             lisp_object_t key,
+                                             uint32_t hash)
+{
+    const uintptr_t mask = capacity - 1;
+    const int equalp = (table_value->test == lisp_hash_table_test_equal);
+
+    for (uint32_t distance = 1; ; distance++) {
+        lisp_hash_table_entry_t entry = &entries[(hash + distance - 1) & mask];
+        if (entry->distance < distance) {
+            return NULL;
+        }
+
+        /* Cleared entries in old storage have no key. */
+        if ((entry->hash == hash) && (entry->key != NULL)) {
+            if ((entry->key == key) || (equalp && (lisp_equal(entry->key, key) != lisp_NIL))) {
+                return entry;
+            }
+        }
+    }
+}
+
+/**
+ Insert an entry for a key that isn't present into current storage,
+ displacing entries closer to their preferred slots along the way.
+ */
+void lisp_hash_table_insert(lisp_hash_table_t table_value,
+                            lisp_object_t key,
+                            lisp_object_t value,
+                            uint32_t hash)
+{
+    const uintptr_t mask = table_value->capacity - 1;
+    struct lisp_hash_table_entry carried = { key, value, hash, 1 };
+
+    for (uintptr_t index = hash & mask; ; index = (index + 1) & mask) {
+        lisp_hash_table_entry_t entry = &table_value->entries[index];
+        if (entry->distance == 0) {
+            *entry = carried;
+            return;
+        }
+        if (entry->distance < carried.distance) {
+            struct lisp_hash_table_entry displaced = *entry;
+            *entry = carried;
+            carried = displaced;
+        }
+        carried.distance = carried.distance + 1;
+    }
+}
+
+/**
+ Delete an entry from current storage, shifting the rest of its probe
+ sequence back a slot so no tombstone is needed.
+ */
+void lisp_hash_table_delete(lisp_hash_table_t table_value,
+                            lisp_hash_table_entry_t entry)
+{
+    const uintptr_t mask = table_value->capacity - 1;
+    uintptr_t index = (uintptr_t) (entry - table_value->entries);
+
+    for (;;) {
+        const uintptr_t next = (index + 1) & mask;
+        if (table_value->entries[next].distance <= 1) {
+            break;
+        }
+        table_value->entries[index] = table_value->entries[next];
+        table_value->entries[index].distance = table_value->entries[index].distance - 1;
+        index = next;
+    }
+
+    memset(&table_value->entries[index], 0, sizeof(struct lisp_hash_table_entry));
+}
+
+/**
+ Move the entries in up to the given number of old slots into current
+ storage, releasing the old storage once it's empty.
+ */
+void lisp_hash_table_migrate(lisp_hash_table_t table_value, uintptr_t slots)
+{
+    if (table_value->old_entries == NULL) {
+        return;
+    }
+
+    while ((slots > 0) && (table_value->old_index < table_value->old_capacity)) {
+        lisp_hash_table_entry_t entry = &table_value->old_entries[table_value->old_index];
+        if (entry->key != NULL) {
+            lisp_hash_table_insert(table_value, entry->key, entry->value, entry->hash);
+            entry->key = NULL;
+        }
+        table_value->old_index = table_value->old_index + 1;
+        slots = slots - 1;
+    }
+
+    if (table_value->old_index == table_value->old_capacity) {
+        table_value->old_entries = NULL;
+        table_value->old_capacity = 0;
+        table_value->old_index = 0;
+    }
+}
+
+/**
+ Double the capacity of the table, keeping the current storage as old
+ storage to be moved from a few slots at a time.
+ */
+void lisp_hash_table_grow(lisp_hash_table_t table_value)
+{
+    /* Only one generation of old storage is kept. */
+    lisp_hash_table_migrate(table_value, table_value->old_capacity);
+
+    table_value->old_entries = table_value->entries;
+    table_value->old_capacity = table_value->capacity;
+    table_value->old_index = 0;
+
+    table_value->capacity = table_value->capacity * 2;
+    table_value->entries = lisp_hash_table_allocate(table_value->capacity);
+}
@@ -0,0 +1,153 @@
+/*
+    File:       lisp_hash_table.h
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#ifndef __lisp_hash_table__
+#define __lisp_hash_table__ 1
+
+
+#include "lisp_types.h"
+
+
+/**
+ The test a hash table uses to compare keys.
+
+ Since fixnums and characters are immediate, `EQL` compares the same
+ way `EQ` does.
+ */
+typedef enum lisp_hash_table_test {
+    lisp_hash_table_test_eq,
+    lisp_hash_table_test_eql,
+    lisp_hash_table_test_equal,
+} lisp_hash_table_test_t;
+
+/**
+ An entry in a hash table's storage.
+
+ The distance is how far the entry is from the slot its hash prefers,
+ plus one, so that a distance of `0` marks an empty slot.
+ */
+typedef struct lisp_hash_table_entry {
+    lisp_object_t key;
+    lisp_object_t value;
+    uint32_t hash;
+    uint32_t distance;
+} *lisp_hash_table_entry_t;
+
+/**
+ A Lisp hash table maps keys to values using open addressing with Robin
+ Hood probing, which keeps every probe sequence short by letting entries
+ far from their preferred slot displace entries close to theirs.
+
+ The table grows incrementally: when it gets too full, new storage is
+ allocated and the old storage is kept alongside it, and each later
+ modification moves a few of the old entries over. This keeps any one
+ insertion from having to move every entry at once.
+
+ - Note: The keys and values in a hash table *are* subject to garbage
+         collection.
+ */
+typedef struct lisp_hash_table {
+    /** The test used to compare keys. */
+    lisp_hash_table_test_t test;
+
+    /** The number of entries in the table. */
+    uintptr_t count;
+
+    /** The storage for entries, as a raw interior pointer. */
+    lisp_hash_table_entry_t entries;
+
+    /** The number of slots in the storage, a power of two. */
+    uintptr_t capacity;
+
+    /** The storage being moved from while growing, or `NULL`. */
+    lisp_hash_table_entry_t old_entries;
+
+    /** The number of slots in the old storage. */
+    uintptr_t old_capacity;
+
+    /** The next slot in the old storage to move. */
+    uintptr_t old_index;
+} *lisp_hash_table_t;
+
+/** A function to call for each entry in a hash table. */
+typedef void (*lisp_hash_table_function)(lisp_object_t key,
+                                         lisp_object_t value,
+                                         void *context);
+
+
+/**
+ Create an empty hash table using the given test, with room for at least
+ the given number of entries before it grows.
+ */
+LISP_EXTERN lisp_object_t lisp_hash_table_create(lisp_hash_table_test_t test,
+                                                 uintptr_t size);
+
+/** Get the hash table value of the given Lisp object. */
+LISP_EXTERN lisp_hash_table_t lisp_hash_table_get_value(lisp_object_t object);
+
+/** Get the number of entries in the given hash table. */
+LISP_EXTERN uintptr_t lisp_hash_table_count(lisp_object_t table);
+
+/**
+ Get the value for the given key in the hash table.
+
+ - Returns: The value, or `default_value` if the key isn't present.
+ */
+LISP_EXTERN lisp_object_t lisp_hash_table_get(lisp_object_t table,
+                                              lisp_object_t key,
+                                              lisp_object_t default_value);
+
+/**
+ Set the value for the given key in the hash table, adding an entry if
+ the key isn't present.
+
+ - Returns: The value.
+ */
+LISP_EXTERN lisp_object_t lisp_hash_table_put(lisp_object_t table,
+                                              lisp_object_t key,
+                                              lisp_object_t value);
+
+/**
+ Remove the entry for the given key from the hash table.
+
+ - Returns: `T` if there was an entry, `NIL` otherwise.
+ */
+LISP_EXTERN lisp_object_t lisp_hash_table_remove(lisp_object_t table,
+                                                 lisp_object_t key);
+
+/**
+ Call the given function for each entry in the hash table.
+
+ The function may remove the entry it's called for, or change its value,
+ but must not otherwise modify the table.
+ */
+LISP_EXTERN void lisp_hash_table_map(lisp_object_t table,
+                                     lisp_hash_table_function function,
+                                     void *context);
+
+/**
+ Hash an object consistently with `EQUAL`, so objects that are `EQUAL`
+ always have the same hash.
+
+ Only a bounded amount of any structure is examined, so hashing a long
+ or deep structure takes constant time.
+ */
+LISP_EXTERN uintptr_t lisp_hash_table_hash_equal(lisp_object_t object);
+
+/** Prints the hash table to the given output stream. */
+LISP_EXTERN lisp_object_t lisp_hash_table_print(lisp_object_t stream,
+                                                lisp_hash_table_t table_value);
+
+/**
+ Compares two hash tables for equality.
+
+ Hash tables are only equal if they are identical, as in Common Lisp.
+ */
+LISP_EXTERN lisp_object_t lisp_hash_table_equal(lisp_object_t a, lisp_object_t b);
+
+
+#endif  /* __lisp_hash_table__ */
@@ -0,0 +1,659 @@
+/*
+    File:       lisp_image.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include "lisp_image.h"
+
+#include "lisp_atom.h"
+#include "lisp_built_in_streams.h"
+#include "lisp_cell.h"
+#include "lisp_environment.h"
+#include "lisp_fixnum.h"
+#include "lisp_hash_table.h"
+#include "lisp_interior.h"
+#include "lisp_memory.h"
+#include "lisp_stream.h"
+#include "lisp_string.h"
+#include "lisp_subr.h"
+#include "lisp_symbol_table.h"
+#include "lisp_vector.h"
+
+#if LISP_USE_STDLIB
+#include <string.h>
+#endif
+
+
+/*
+    An image is laid out as follows, with every number little-endian:
+
+    -   The magic bytes `GLIMAGE` and a zero byte.
+    -   The format version and the number of objects, each 32 bits.
+    -   The shape of each object, in order:
+        -   `A`, a 32-bit length, and the bytes of an atom's name.
+        -   `S`, a 32-bit length, and a string's characters, 32 bits each.
+        -   `C` for a cell.
+        -   `V` and the 32-bit number of values in a vector.
+        -   `F`, a 32-bit length, and the bytes of a `SUBR` object's name.
+    -   The contents of each cell, its `CAR` and `CDR`, and of each vector,
+        its values, in the same order, all as references.
+    -   A reference to the object the image holds.
+
+    A reference is `O` and a 32-bit object number, `I` and a 64-bit
+    fixnum, or `H` and a 32-bit character.
+*/
+
+/** The magic bytes at the start of an image. */
+static const unsigned char lisp_image_magic[8] = { 'G', 'L', 'I', 'M', 'A', 'G', 'E', 0 };
+
+/** The version of the image format. */
+#define LISP_IMAGE_VERSION 1
+
+/** The size of the buffer an image is written through. */
+#define LISP_IMAGE_BUFFER_SIZE 256
+
+/** The longest name that's read into a buffer on the C stack. */
+#define LISP_IMAGE_NAME_SIZE 128
+
+/** The fewest bytes a reference can take. */
+#define LISP_IMAGE_REFERENCE_SIZE 5
+
+
+/* MARK: - Writing */
+
+/** The state of writing an image, which is buffered. */
+typedef struct lisp_image_writer {
+    lisp_object_t stream;
+    uintptr_t buffered;
+    unsigned char buffer[LISP_IMAGE_BUFFER_SIZE];
+} *lisp_image_writer_t;
+
+static void lisp_image_flush(lisp_image_writer_t writer)
+{
+    if (writer->buffered > 0) {
+        lisp_stream_write_bytes(writer->stream, writer->buffer, writer->buffered);
+        writer->buffered = 0;
+    }
+}
+
+static void lisp_image_write_byte(lisp_image_writer_t writer, unsigned char byte)
+{
+    if (writer->buffered == LISP_IMAGE_BUFFER_SIZE) {
+        lisp_image_flush(writer);
+    }
+    writer->buffer[writer->buffered] = byte;
+    writer->buffered = writer->buffered + 1;
+}
+
+static void lisp_image_write_bytes(lisp_image_writer_t writer, const unsigned char *bytes, uintptr_t length)
+{
+    for (uintptr_t i = 0; i < length; i++) {
+        lisp_image_write_byte(writer, bytes[i]);
+    }
+}
+
+static void lisp_image_write_u32(lisp_image_writer_t writer, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        lisp_image_write_byte(writer, (unsigned char)(value >> (i * 8)));
+    }
+}
+
+static void lisp_image_write_u64(lisp_image_writer_t writer, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) {
+        lisp_image_write_byte(writer, (unsigned char)(value >> (i * 8)));
+    }
+}
+
+/** Write a name, such as an atom's, as a length and its bytes. */
+static void lisp_image_write_name(lisp_image_writer_t writer, const char *name)
+{
+    uintptr_t length = (uintptr_t)strlen(name);
+    lisp_image_write_u32(writer, (uint32_t)length);
+    lisp_image_write_bytes(writer, (const unsigned char *)name, length);
+}
+
+/** Indicate whether an object is stored directly in a reference. */
+static int lisp_image_immediatep(lisp_object_t object)
+{
+    lisp_tag_t tag = lisp_object_get_tag(object);
+    return (tag == lisp_tag_fixnum) || (tag == lisp_tag_char);
+}
+
+/** Indicate whether an object can be numbered in an image. */
+static int lisp_image_storablep(lisp_object_t object)
+{
+    switch (lisp_object_get_tag(object)) {
+        case lisp_tag_atom:
+        case lisp_tag_string:
+        case lisp_tag_cell:
+        case lisp_tag_vector:
+        case lisp_tag_subr:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ Number an object if it hasn't been already, adding it to the objects
+ to write.
+
+ - Returns: Zero if the object can't be stored in an image.
+ */
+static int lisp_image_number(lisp_object_t numbers, lisp_object_t objects, lisp_object_t object)
+{
+    if (lisp_image_immediatep(object)) {
+        return 1;
+    }
+    if (!lisp_image_storablep(object)) {
+        return 0;
+    }
+    if (lisp_hash_table_get(numbers, object, lisp_NIL) == lisp_NIL) {
+        uintptr_t number = lisp_vector_push_extend(objects, object);
+        lisp_hash_table_put(numbers, object, lisp_fixnum_create((lisp_fixnum_t)number));
+    }
+    return 1;
+}
+
+/**
+ Number every object reachable from the given object, in breadth-first
+ order, using the vector of objects itself as the queue.
+
+ - Returns: Zero if any object can't be stored in an image.
+ */
+static int lisp_image_number_all(lisp_object_t numbers, lisp_object_t objects, lisp_object_t object)
+{
+    if (!lisp_image_number(numbers, objects, object)) {
+        return 0;
+    }
+
+    for (uintptr_t i = 0; i < lisp_vector_get_value(objects)->count; i++) {
+        lisp_object_t current = lisp_vector_get_value(objects)->values[i];
+        if (lisp_cellp(current) != lisp_NIL) {
+            lisp_cell_t cell_value = lisp_cell_get_value(current);
+            if (!lisp_image_number(numbers, objects, cell_value->car)) return 0;
+            if (!lisp_image_number(numbers, objects, cell_value->cdr)) return 0;
+        } else if (lisp_vectorp(current) != lisp_NIL) {
+            lisp_vector_t vector_value = lisp_vector_get_value(current);
+            for (uintptr_t j = 0; j < vector_value->count; j++) {
+                if (!lisp_image_number(numbers, objects, vector_value->values[j])) return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+static void lisp_image_write_reference(lisp_image_writer_t writer, lisp_object_t numbers, lisp_object_t object)
+{
+    switch (lisp_object_get_tag(object)) {
+        case lisp_tag_fixnum:
+            lisp_image_write_byte(writer, 'I');
+            lisp_image_write_u64(writer, (uint64_t)(int64_t)lisp_fixnum_get_value(object));
+            break;
+
+        case lisp_tag_char:
+            lisp_image_write_byte(writer, 'H');
+            lisp_image_write_u32(writer, (uint32_t)lisp_char_get_value(object));
+            break;
+
+        default: {
+            lisp_object_t number = lisp_hash_table_get(numbers, object, lisp_NIL);
+            lisp_image_write_byte(writer, 'O');
+            lisp_image_write_u32(writer, (uint32_t)lisp_fixnum_get_value(number));
+        } break;
+    }
+}
+
+static void lisp_image_write_shape(lisp_image_writer_t writer, lisp_object_t object)
+{
+    switch (lisp_object_get_tag(object)) {
+        case lisp_tag_atom:
+            lisp_image_write_byte(writer, 'A');
+            lisp_image_write_name(writer, lisp_atom_get_value(object));
+            break;
+
+        case lisp_tag_string: {
+            lisp_string_t string_value = lisp_string_get_value(object);
+            lisp_object_t *chars = (lisp_object_t *)lisp_interior_get_value(string_value->chars);
+            lisp_image_write_byte(writer, 'S');
+            lisp_image_write_u32(writer, (uint32_t)string_value->length);
+            for (uintptr_t i = 0; i < string_value->length; i++) {
+                lisp_image_write_u32(writer, (uint32_t)lisp_char_get_value(chars[i]));
+            }
+        } break;
+
+        case lisp_tag_cell:
+            lisp_image_write_byte(writer, 'C');
+            break;
+
+        case lisp_tag_vector:
+            lisp_image_write_byte(writer, 'V');
+            lisp_image_write_u32(writer, (uint32_t)lisp_vector_get_value(object)->count);
+            break;
+
+        case lisp_tag_subr: {
+            lisp_subr_t subr_value = lisp_subr_get_value(object);
+            lisp_string_t name_value = lisp_string_get_value(subr_value->name);
+            lisp_object_t *chars = (lisp_object_t *)lisp_interior_get_value(name_value->chars);
+            lisp_image_write_byte(writer, 'F');
+            lisp_image_write_u32(writer, (uint32_t)name_value->length);
+            for (uintptr_t i = 0; i < name_value->length; i++) {
+                lisp_image_write_byte(writer, (unsigned char)lisp_char_get_value(chars[i]));
+            }
+        } break;
+
+        default:
+            break;
+    }
+}
+
+lisp_object_t lisp_image_write(lisp_object_t stream, lisp_object_t object)
+{
+    lisp_object_t numbers = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+    lisp_object_t objects = lisp_vector_create(0, lisp_NIL);
+    if (!lisp_image_number_all(numbers, objects, object)) {
+        return lisp_NIL;
+    }
+
+    struct lisp_image_writer writer;
+    writer.stream = stream;
+    writer.buffered = 0;
+
+    lisp_vector_t objects_value = lisp_vector_get_value(objects);
+    const uintptr_t count = objects_value->count;
+
+    lisp_image_write_bytes(&writer, lisp_image_magic, sizeof(lisp_image_magic));
+    lisp_image_write_u32(&writer, LISP_IMAGE_VERSION);
+    lisp_image_write_u32(&writer, (uint32_t)count);
+
+    for (uintptr_t i = 0; i < count; i++) {
+        lisp_image_write_shape(&writer, objects_value->values[i]);
+    }
+
+    for (uintptr_t i = 0; i < count; i++) {
+        lisp_object_t current = objects_value->values[i];
+        if (lisp_cellp(current) != lisp_NIL) {
+            lisp_cell_t cell_value = lisp_cell_get_value(current);
+            lisp_image_write_reference(&writer, numbers, cell_value->car);
+            lisp_image_write_reference(&writer, numbers, cell_value->cdr);
+        } else if (lisp_vectorp(current) != lisp_NIL) {
+            lisp_vector_t vector_value = lisp_vector_get_value(current);
+            for (uintptr_t j = 0; j < vector_value->count; j++) {
+                lisp_image_write_reference(&writer, numbers, vector_value->values[j]);
+            }
+        }
+    }
+
+    lisp_image_write_reference(&writer, numbers, object);
+    lisp_image_flush(&writer);
+
+    return lisp_T;
+}
+
+
+/* MARK: - Reading */
+
+/**
+ The state of reading an image. The reserved bytes are the fewest the
+ rest of the image must still hold for what's been read so far, such
+ as the shape of each object not yet created and the references of
+ each cell and vector. Reading stops at the first problem, and
+ everything read after that is ignored.
+ */
+typedef struct lisp_image_reader {
+    lisp_object_t environment;
+    lisp_object_t stream;
+    lisp_object_t *objects;
+    uintptr_t count;
+    uintptr_t reserved;
+    int failed;
+} *lisp_image_reader_t;
+
+static void lisp_image_read_bytes(lisp_image_reader_t reader, unsigned char *bytes, uintptr_t length)
+{
+    if (reader->failed) {
+        memset(bytes, 0, length);
+        return;
+    }
+    if (lisp_stream_read_bytes(reader->stream, bytes, length) != length) {
+        memset(bytes, 0, length);
+        reader->failed = 1;
+    }
+}
+
+/**
+ Check that a number of things read from an image, each taking at least
+ `size` bytes of what's left of the image beyond those already reserved
+ and `heap_size` bytes of the heap, could actually be there and fit,
+ so that a corrupt or truncated image is rejected before anything is
+ allocated for it.
+
+ - Returns: Zero if they can't.
+ */
+static int lisp_image_check_length(lisp_image_reader_t reader, uintptr_t length, uintptr_t size, uintptr_t heap_size)
+{
+    const uintptr_t remaining = lisp_stream_remaining(reader->stream);
+    const uintptr_t available = (remaining > reader->reserved) ? (remaining - reader->reserved) : 0;
+    if (reader->failed
+        || (length > available / size)
+        || (length > lisp_heap_available() / heap_size))
+    {
+        reader->failed = 1;
+        return 0;
+    }
+    return 1;
+}
+
+static unsigned char lisp_image_read_byte(lisp_image_reader_t reader)
+{
+    unsigned char byte;
+    lisp_image_read_bytes(reader, &byte, 1);
+    return byte;
+}
+
+static uint32_t lisp_image_read_u32(lisp_image_reader_t reader)
+{
+    unsigned char bytes[4];
+    lisp_image_read_bytes(reader, bytes, 4);
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static uint64_t lisp_image_read_u64(lisp_image_reader_t reader)
+{
+    unsigned char bytes[8];
+    lisp_image_read_bytes(reader, bytes, 8);
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+/** Read a name and get the canonical atom for it. */
+static lisp_object_t lisp_image_read_atom(lisp_image_reader_t reader)
+{
+    const uintptr_t length = lisp_image_read_u32(reader);
+    unsigned char stack_bytes[LISP_IMAGE_NAME_SIZE];
+    unsigned char *bytes = stack_bytes;
+    if (!lisp_image_check_length(reader, length, 1, 1)) {
+        return lisp_NIL;
+    }
+    if (length > LISP_IMAGE_NAME_SIZE) {
+        lisp_interior_create(length, (void **)&bytes);
+    }
+
+    lisp_image_read_bytes(reader, bytes, length);
+    if (reader->failed) {
+        return lisp_NIL;
+    }
+    return lisp_symbol_table_intern_bytes((const char *)bytes, length);
+}
+
+static lisp_object_t lisp_image_read_shape(lisp_image_reader_t reader)
+{
+    switch (lisp_image_read_byte(reader)) {
+        case 'A':
+            return lisp_image_read_atom(reader);
+
+        case 'S': {
+            const uintptr_t length = lisp_image_read_u32(reader);
+            if (!lisp_image_check_length(reader, length, 4, sizeof(lisp_object_t))) {
+                return lisp_NIL;
+            }
+            lisp_object_t *chars;
+            lisp_object_t chars_interior = lisp_interior_create(sizeof(lisp_object_t) * length, (void **)&chars);
+            for (uintptr_t i = 0; i < length; i++) {
+                chars[i] = lisp_char_create((lisp_char_t)lisp_image_read_u32(reader));
+            }
+            return lisp_string_create(chars_interior, length, length);
+        } break;
+
+        case 'C':
+            if (!lisp_image_check_length(reader, 1, 2 * LISP_IMAGE_REFERENCE_SIZE, sizeof(struct lisp_cell))) {
+                return lisp_NIL;
+            }
+            reader->reserved = reader->reserved + (2 * LISP_IMAGE_REFERENCE_SIZE);
+            return lisp_cell_cons(lisp_NIL, lisp_NIL);
+
+        case 'V': {
+            const uintptr_t count = lisp_image_read_u32(reader);
+            if (!lisp_image_check_length(reader, count, LISP_IMAGE_REFERENCE_SIZE, sizeof(lisp_object_t))) {
+                return lisp_NIL;
+            }
+            reader->reserved = reader->reserved + (count * LISP_IMAGE_REFERENCE_SIZE);
+            return lisp_vector_create(count, lisp_NIL);
+        } break;
+
+        case 'F': {
+            lisp_object_t name = lisp_image_read_atom(reader);
+            lisp_object_t subr = lisp_environment_get_symbol_value(reader->environment, name, lisp_SUBR, lisp_T);
+            if (lisp_subrp(subr) == lisp_NIL) {
+                reader->failed = 1;
+            }
+            return subr;
+        } break;
+
+        default:
+            reader->failed = 1;
+            return lisp_NIL;
+    }
+}
+
+static lisp_object_t lisp_image_read_reference(lisp_image_reader_t reader)
+{
+    switch (lisp_image_read_byte(reader)) {
+        case 'O': {
+            const uintptr_t number = lisp_image_read_u32(reader);
+            if (number < reader->count) {
+                return reader->objects[number];
+            }
+        } break;
+
+        case 'I':
+            return lisp_fixnum_create((lisp_fixnum_t)(int64_t)lisp_image_read_u64(reader));
+
+        case 'H':
+            return lisp_char_create((lisp_char_t)lisp_image_read_u32(reader));
+
+        default:
+            break;
+    }
+
+    reader->failed = 1;
+    return lisp_NIL;
+}
+
+lisp_object_t lisp_image_read(lisp_object_t environment,
+                              lisp_object_t stream,
+                              lisp_object_t *object)
+{
+    struct lisp_image_reader reader;
+    reader.environment = environment;
+    reader.stream = stream;
+    reader.objects = NULL;
+    reader.count = 0;
+    reader.reserved = 0;
+    reader.failed = 0;
+    *object = lisp_NIL;
+
+    unsigned char magic[sizeof(lisp_image_magic)];
+    lisp_image_read_bytes(&reader, magic, sizeof(magic));
+    const uint32_t version = lisp_image_read_u32(&reader);
+    if (reader.failed
+        || (memcmp(magic, lisp_image_magic, sizeof(magic)) != 0)
+        || (version != LISP_IMAGE_VERSION))
+    {
+        return lisp_NIL;
+    }
+
+    /* Create every object from its shape, after the reference to the image's object. */
+    const uintptr_t count = lisp_image_read_u32(&reader);
+    reader.reserved = LISP_IMAGE_REFERENCE_SIZE;
+    if (!lisp_image_check_length(&reader, count, 1, sizeof(lisp_object_t))) {
+        return lisp_NIL;
+    }
+    reader.count = count;
+    reader.reserved = reader.reserved + count;
+    lisp_interior_create(sizeof(lisp_object_t) * reader.count, (void **)&reader.objects);
+    for (uintptr_t i = 0; (i < reader.count) && !reader.failed; i++) {
+        reader.reserved = reader.reserved - 1;
+        reader.objects[i] = lisp_image_read_shape(&reader);
+    }
+
+    /* Fill in the contents of each cell and vector, relocating references. */
+    for (uintptr_t i = 0; (i < reader.count) && !reader.failed; i++) {
+        lisp_object_t current = reader.objects[i];
+        if (lisp_cellp(current) != lisp_NIL) {
+            lisp_cell_t cell_value = lisp_cell_get_value(current);
+            cell_value->car = lisp_image_read_reference(&reader);
+            cell_value->cdr = lisp_image_read_reference(&reader);
+        } else if (lisp_vectorp(current) != lisp_NIL) {
+            lisp_vector_t vector_value = lisp_vector_get_value(current);
+            for (uintptr_t j = 0; j < vector_value->count; j++) {
+                vector_value->values[j] = lisp_image_read_reference(&reader);
+            }
+        }
+    }
+
+    lisp_object_t root = lisp_image_read_reference(&reader);
+    if (reader.failed) {
+        return lisp_NIL;
+    }
+
+    *object = root;
+    return lisp_T;
+}
+
+
+/* MARK: - Saving & Loading */
+
+/** Indicate whether everything reachable from an object can be stored in an image. */
+static int lisp_image_storable_allp(lisp_object_t object)
+{
+    lisp_object_t numbers = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+    lisp_object_t objects = lisp_vector_create(0, lisp_NIL);
+    return lisp_image_number_all(numbers, objects, object);
+}
+
+/** Open a file named by a string in the direction named by a C string. */
+static lisp_object_t lisp_image_open(lisp_object_t path, const char *direction)
+{
+    lisp_object_t direction_keyword = lisp_symbol_table_intern_bytes(direction, (uintptr_t)strlen(direction));
+    return lisp_stream_open_file(path, direction_keyword);
+}
+
+lisp_object_t lisp_image_save(lisp_object_t environment, lisp_object_t path)
+{
+    /* Keep only the bindings whose values can all be stored. */
+    lisp_object_t bindings = lisp_NIL;
+    for (lisp_object_t rest = lisp_environment_bindings(environment); rest != lisp_NIL; rest = lisp_cell_cdr(rest)) {
+        lisp_object_t entry = lisp_cell_car(rest);
+        if (lisp_image_storable_allp(lisp_cell_cdr(entry))) {
+            bindings = lisp_cell_cons(entry, bindings);
+        }
+    }
+
+    lisp_object_t stream = lisp_image_open(path, ":OUTPUT");
+    if (stream == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    lisp_object_t result = lisp_image_write(stream, bindings);
+    lisp_stream_close(stream);
+    return result;
+}
+
+/**
+ Determine whether a list is a proper list of cells, following its `CDR`
+ and using Brent's algorithm to notice if it never ends.
+ */
+static int lisp_image_cell_listp(lisp_object_t list)
+{
+    lisp_object_t tortoise = list;
+    lisp_object_t hare = list;
+    uintptr_t power = 1;
+    uintptr_t steps = 0;
+
+    while (lisp_cellp(hare) != lisp_NIL) {
+        if (lisp_cellp(lisp_cell_car(hare)) == lisp_NIL) {
+            return 0;
+        }
+        hare = lisp_cell_cdr(hare);
+        if (hare == tortoise) {
+            return 0;
+        }
+        steps = steps + 1;
+        if (steps == power) {
+            tortoise = hare;
+            power = power * 2;
+            steps = 0;
+        }
+    }
+
+    return (hare == lisp_NIL);
+}
+
+/**
+ Determine whether an image's object is a list of bindings that can be
+ loaded, each a symbol and a list of its types and values. An image can
+ hold any object, including a circular list, so this is checked before
+ anything is bound.
+ */
+static int lisp_image_bindingsp(lisp_object_t bindings)
+{
+    if (!lisp_image_cell_listp(bindings)) {
+        return 0;
+    }
+
+    for (lisp_object_t rest = bindings; rest != lisp_NIL; rest = lisp_cell_cdr(rest)) {
+        lisp_object_t entry = lisp_cell_car(rest);
+        if ((lisp_atomp(lisp_cell_car(entry)) == lisp_NIL) || !lisp_image_cell_listp(lisp_cell_cdr(entry))) {
+            return 0;
+        }
+        for (lisp_object_t plist = lisp_cell_cdr(entry); plist != lisp_NIL; plist = lisp_cell_cdr(plist)) {
+            if (lisp_atomp(lisp_cell_car(lisp_cell_car(plist))) == lisp_NIL) {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+lisp_object_t lisp_image_load(lisp_object_t environment, lisp_object_t path)
+{
+    lisp_object_t stream = lisp_image_open(path, ":INPUT");
+    if (stream == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    lisp_object_t bindings;
+    lisp_object_t result = lisp_image_read(environment, stream, &bindings);
+    lisp_stream_close(stream);
+    if ((result == lisp_NIL) || !lisp_image_bindingsp(bindings)) {
+        return lisp_NIL;
+    }
+
+    for (lisp_object_t rest = bindings; rest != lisp_NIL; rest = lisp_cell_cdr(rest)) {
+        lisp_object_t entry = lisp_cell_car(rest);
+        lisp_object_t symbol = lisp_cell_car(entry);
+        for (lisp_object_t plist = lisp_cell_cdr(entry); plist != lisp_NIL; plist = lisp_cell_cdr(plist)) {
+            lisp_object_t property = lisp_cell_car(plist);
+            lisp_environment_set_symbol_value(environment, symbol,
+                                              lisp_cell_car(property), lisp_cell_cdr(property),
+                                              lisp_NIL);
+        }
+    }
+
+    return lisp_T;
+}
@@ -0,0 +1,89 @@
+/*
+    File:       lisp_image.h
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#ifndef __lisp_image__
+#define __lisp_image__ 1
+
+
+#include "lisp_types.h"
+
+
+/**
+ Images.
+
+ An *image* is a binary serialization of a graph of heap objects, which
+ can be read back much faster than the same objects could be read and
+ evaluated from source. An image can hold cells, atoms, strings,
+ vectors, fixnums, characters, and `SUBR` objects, which are stored by
+ name and looked up again when the image is read. Sharing and cycles
+ among the objects are preserved.
+
+ Every object in an image is numbered, and objects refer to each other
+ by number. An image first describes each object's *shape*, which is
+ enough to create it, and then the *contents* of each cell and vector,
+ so reading an image creates every object and then relocates each
+ reference to the object it names, all in one pass over the image.
+
+ Atoms are interned in the symbol table as they're read, so the atoms
+ in a loaded image are the same atoms the environment already uses.
+ */
+
+/**
+ Write an object and everything it refers to as an image.
+
+ - Parameters:
+   - stream: The stream to write to, which is written as bytes.
+   - object: The object to write.
+ - Returns: `T` upon success, or `NIL` if the object refers to anything
+            that can't be stored in an image, such as a stream, in which
+            case nothing is written.
+ */
+LISP_EXTERN lisp_object_t lisp_image_write(lisp_object_t stream, lisp_object_t object);
+
+/**
+ Read an object and everything it refers to from an image.
+
+ - Parameters:
+   - environment: The environment used to look up `SUBR` objects by name.
+   - stream: The stream to read from, which is read as bytes.
+   - object: Set to the object read.
+ - Returns: `T` upon success, or `NIL` if the image is malformed or
+            truncated, holds more than the heap has room for, or names
+            a `SUBR` the environment doesn't have.
+ */
+LISP_EXTERN lisp_object_t lisp_image_read(lisp_object_t environment,
+                                          lisp_object_t stream,
+                                          lisp_object_t *object);
+
+/**
+ Save the bindings visible in an environment, other than those in the
+ root environment, to an image file.
+
+ A binding with any value that can't be stored in an image, such as the
+ stream bound to `*STANDARD-OUTPUT*`, is left out entirely.
+
+ - Parameters:
+   - environment: The environment whose bindings to save.
+   - path: A string naming the file to write.
+ - Returns: `T` upon success, `NIL` upon failure.
+ */
+LISP_EXTERN lisp_object_t lisp_image_save(lisp_object_t environment, lisp_object_t path);
+
+/**
+ Load the bindings saved in an image file into an environment.
+
+ - Parameters:
+   - environment: The environment to bind the saved symbols in.
+   - path: A string naming the file to read.
+ - Returns: `T` upon success, `NIL` upon failure, including when the
+            image doesn't hold a list of bindings, in which case nothing
+            is bound.
+ */
+LISP_EXTERN lisp_object_t lisp_image_load(lisp_object_t environment, lisp_object_t path);
+
+
+#endif  /* __lisp_image__ */
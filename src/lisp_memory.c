@@ -10,30 +10,31 @@
 #include "lisp_atom.h"
 #include "lisp_string.h"
 #include "lisp_utilities.h"
+#include "lisp_vm.h"
+
+#include <stddef.h>
 
 #if LISP_USE_STDLIB
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 
-/** The raw heap is the actual C allocation, in case it needs to be adjusted for Lisp. */
-static void *raw_heap = NULL;
-
-/** The Lisp heap is where all Lisp allocations come from, keep track of where it starts. */
-static void *lisp_heap_start = NULL;
-
-/** The size of the Lisp heap. */
-static uintptr_t lisp_heap_size = 0;
-
-/** Keep track of the current point in the Lisp heap, so we know where the next allocation comes from. */
-static void *lisp_heap_cur = NULL;
+/* The heap belongs to the current virtual machine. */
+#define raw_heap (lisp_vm_current->raw_heap)
+#define lisp_heap_start (lisp_vm_current->heap_start)
+#define lisp_heap_size (lisp_vm_current->heap_size)
+#define lisp_heap_cur (lisp_vm_current->heap_cur)
+#define lisp_heap_frozen_start (lisp_vm_current->frozen_start)
+#define lisp_heap_frozen_size (lisp_vm_current->frozen_size)
 
 
 /** Collect garbage. */
 static void lisp_heap_garbage_collect(void);
 
 
-void lisp_heap_initialize(uintptr_t size)
+int lisp_heap_initialize(uintptr_t size)
 {
 #if LISP_USE_STDLIB
     /*
@@ -41,6 +42,9 @@ void lisp_heap_initialize(uintptr_t size)
      that's not actually guaranteed. So we have to do the alignment ourselves.
      */
     raw_heap = calloc(size, sizeof(uint8_t));
+    if (raw_heap == NULL) {
+        return 0;
+    }
 
     const uintptr_t raw_heap_val = (uintptr_t)raw_heap;
     void *raw_heap_aligned;
@@ -61,6 +65,7 @@ void lisp_heap_initialize(uintptr_t size)
     lisp_heap_start = raw_heap_aligned;
     lisp_heap_size = size_aligned;
     lisp_heap_cur = lisp_heap_start;
+    return 1;
 }
 
 
@@ -68,6 +73,9 @@ void lisp_heap_finalize(void)
 {
     /* Dispose of the heaps and reset the values. */
 #if LISP_USE_STDLIB
+    if (lisp_heap_frozen_size != 0) {
+        mprotect(lisp_heap_frozen_start, lisp_heap_frozen_size, PROT_READ | PROT_WRITE);
+    }
     free(raw_heap);
 #else
 #warning Implement lisp_heap_finalize without stdlib.
@@ -77,12 +85,76 @@ void lisp_heap_finalize(void)
     lisp_heap_start = NULL;
     lisp_heap_size = 0;
     lisp_heap_cur = NULL;
+    lisp_heap_frozen_start = NULL;
+    lisp_heap_frozen_size = 0;
+}
+
+
+void lisp_heap_freeze(void)
+{
+    /* A frozen heap has no room for anything more. */
+    uintptr_t lisp_heap_start_value = (uintptr_t) lisp_heap_start;
+    uintptr_t lisp_heap_end_value = lisp_heap_start_value + lisp_heap_size;
+    lisp_heap_size = (uintptr_t) lisp_heap_cur - lisp_heap_start_value;
+
+#if LISP_USE_STDLIB
+    /*
+     Only whole pages can be protected, and the heap's first and last ones
+     may be shared with other allocations, so protect just the ones that
+     lie entirely within it.
+     */
+    const uintptr_t page_size = (uintptr_t) sysconf(_SC_PAGESIZE);
+    uintptr_t frozen_start_value = ((lisp_heap_start_value + page_size - 1) / page_size) * page_size;
+    uintptr_t frozen_end_value = lisp_heap_end_value - (lisp_heap_end_value % page_size);
+    if (frozen_end_value > frozen_start_value) {
+        uintptr_t frozen_size = frozen_end_value - frozen_start_value;
+        if (mprotect((void *) frozen_start_value, frozen_size, PROT_READ) == 0) {
+            lisp_heap_frozen_start = (void *) frozen_start_value;
+            lisp_heap_frozen_size = frozen_size;
+        }
+    }
+#endif
+}
+
+
+int lisp_heap_sharedp(lisp_object_t object)
+{
+    uintptr_t object_value = ((uintptr_t) object) & ~((uintptr_t) 0xF);
+    for (lisp_vm_t vm = lisp_vm_current->shared; vm != NULL; vm = vm->shared) {
+        if ((object_value >= (uintptr_t) vm->heap_start) && (object_value < (uintptr_t) vm->heap_cur)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+uintptr_t lisp_heap_available(void)
+{
+#if LISP_DEBUG_ALLOCATION
+    /* Every allocation comes from malloc. */
+    return UINTPTR_MAX;
+#else
+    /* An allocation that reaches the very end of the heap is collected first. */
+    uintptr_t lisp_heap_end_value = (uintptr_t) lisp_heap_start + lisp_heap_size;
+    uintptr_t lisp_heap_cur_value = (uintptr_t) lisp_heap_cur;
+    if (lisp_heap_cur_value >= lisp_heap_end_value) {
+        return 0;
+    }
+    return lisp_heap_end_value - lisp_heap_cur_value - 1;
+#endif
 }
 
 
 void lisp_heap_garbage_collect(void)
 {
 #warning lisp_heap_garbage_collect: Implement.
+#if LISP_USE_STDLIB
+    /* Nothing can be collected, so give up on whatever ran out. */
+    if (lisp_vm_current->out_of_memory != NULL) {
+        longjmp(*lisp_vm_current->out_of_memory, 1);
+    }
+#endif
     exit(1);
 }
 
@@ -13,15 +13,40 @@
 
 
 /**
- Initialize the Lisp heaps to a specific size.
+ Initialize the current virtual machine's Lisp heap to a specific size.
+
+ - Returns: Whether the heap could be allocated.
  */
-LISP_EXTERN void lisp_heap_initialize(uintptr_t size);
+LISP_EXTERN int lisp_heap_initialize(uintptr_t size);
 
 /**
- Finalize the Lisp heap.
+ Finalize the current virtual machine's Lisp heap.
  */
 LISP_EXTERN void lisp_heap_finalize(void);
 
+/**
+ Freeze the current virtual machine's Lisp heap, so nothing more can be
+ allocated in it and, where the system supports it, nothing in it can be
+ changed.
+ */
+LISP_EXTERN void lisp_heap_freeze(void);
+
+/**
+ Indicate whether an object is in the heap of a frozen virtual machine
+ the current one shares. Such an object can't be changed, so anything
+ that changes objects must refuse it, and since it isn't in the current
+ virtual machine's heap, it never needs to be traced or moved by it.
+ */
+LISP_EXTERN int lisp_heap_sharedp(lisp_object_t object);
+
+/**
+ Get the number of bytes that can still be allocated from the current
+ virtual machine's heap before it runs out, so that something reading
+ untrusted data can reject a size that could never fit instead of
+ trying to allocate it.
+ */
+LISP_EXTERN uintptr_t lisp_heap_available(void);
+
 
 /**
  Allocate an object on the heap of the specified size.
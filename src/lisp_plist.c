@@ -105,6 +105,52 @@ lisp_object_t lisp_plist_get(lisp_object_t plist,
 }
 
 
+lisp_object_t lisp_plist_get_first(lisp_object_t plist,
+                                   const lisp_object_t *symbols,
+                                   uintptr_t count)
+{
+    /*
+     Track the most preferred symbol found so far, so that only symbols
+     preferred over it need to be checked against later entries.
+     */
+    uintptr_t found_rank = count;
+    lisp_object_t found_value = lisp_NIL;
+
+    for (lisp_object_t plist_cur = plist; plist_cur != lisp_NIL; plist_cur = lisp_cell_cdr(plist_cur)) {
+        lisp_object_t check_cell = lisp_cell_car(plist_cur);
+        lisp_object_t value = lisp_cell_cdr(check_cell);
+        if (value == lisp_NIL) {
+            continue;
+        }
+
+        /* Symbols are almost always identical, so check that first. */
+        lisp_object_t potential_symbol = lisp_cell_car(check_cell);
+        uintptr_t rank = 0;
+        while ((rank < found_rank) && (symbols[rank] != potential_symbol)) {
+            rank = rank + 1;
+        }
+        if (rank == found_rank) {
+            rank = 0;
+            while ((rank < found_rank) && (lisp_equal(symbols[rank], potential_symbol) == lisp_NIL)) {
+                rank = rank + 1;
+            }
+        }
+
+        if (rank < found_rank) {
+            found_rank = rank;
+            found_value = value;
+
+            /* Nothing can be preferred over the first symbol. */
+            if (rank == 0) {
+                break;
+            }
+        }
+    }
+
+    return found_value;
+}
+
+
 lisp_object_t lisp_plist_set(lisp_object_t plist,
                              lisp_object_t symbol,
                              lisp_object_t value)
@@ -129,11 +175,37 @@ lisp_object_t lisp_plist_set(lisp_object_t plist,
 lisp_object_t lisp_plist_remprop(lisp_object_t plist,
                                  lisp_object_t symbol)
 {
-#warning lisp_plist_remprop: Implement for real.
-    /*
-     Just set the value of the given property to nil. That will have the
-     same effect as removing the property's cell, less efficiently.
-     */
-    lisp_plist_set(plist, symbol, lisp_NIL);
-    return lisp_NIL;
+    /* Look for the cell holding the entry, remembering the one before it. */
+    lisp_object_t previous_cell = lisp_NIL;
+    lisp_object_t plist_cur = plist;
+    while (plist_cur != lisp_NIL) {
+        lisp_object_t check_cell = lisp_cell_car(plist_cur);
+        if (lisp_equal(symbol, lisp_cell_car(check_cell)) != lisp_NIL) {
+            break;
+        }
+        previous_cell = plist_cur;
+        plist_cur = lisp_cell_cdr(plist_cur);
+    }
+
+    if (plist_cur == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    lisp_object_t next_cell = lisp_cell_cdr(plist_cur);
+    if (previous_cell != lisp_NIL) {
+        /* Unlink the cell from the one before it. */
+        lisp_cell_rplacd(previous_cell, next_cell);
+    } else if (next_cell != lisp_NIL) {
+        /*
+         The first cell is how the plist is referred to, so it can't be
+         unlinked; move the second cell's contents into it instead.
+         */
+        lisp_cell_rplaca(plist_cur, lisp_cell_car(next_cell));
+        lisp_cell_rplacd(plist_cur, lisp_cell_cdr(next_cell));
+    } else {
+        /* The only entry can't be removed, so just clear its value. */
+        lisp_cell_rplacd(lisp_cell_car(plist_cur), lisp_NIL);
+    }
+
+    return lisp_T;
 }
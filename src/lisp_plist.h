@@ -30,6 +30,24 @@ LISP_EXTERN lisp_object_t lisp_plist_create(lisp_object_t cell, ...);
 LISP_EXTERN lisp_object_t lisp_plist_get(lisp_object_t plist,
                                          lisp_object_t symbol);
 
+/**
+ Gets the value for the first of the given \a symbols, in order, that
+ has a non-`NIL` value in the property list \a plist.
+
+ This looks for all of the symbols in a single pass over the property
+ list, rather than one pass per symbol.
+
+ - Parameters:
+   - plist: The property list to search.
+   - symbols: The symbols to look for, in order of preference.
+   - count: The number of symbols.
+ - Returns: The value for the first symbol that has one, or `NIL` if
+            none of them do.
+ */
+LISP_EXTERN lisp_object_t lisp_plist_get_first(lisp_object_t plist,
+                                               const lisp_object_t *symbols,
+                                               uintptr_t count);
+
 /**
  Sets the \a value for the given \a symbol in the property list
  / \a plist, returning the given \a value.
@@ -39,7 +57,14 @@ LISP_EXTERN lisp_object_t lisp_plist_set(lisp_object_t plist,
                                          lisp_object_t value);
 
 /**
- Removes the entry for the given \a symbol from the property list.
+ Removes the entry for the given \a symbol from the property list,
+ unlinking its cell so later lookups don't have to pass over it.
+
+ The property list is modified in place, so anything referring to it
+ sees the removal. Since a property list always has at least one entry,
+ its only entry can't be unlinked; its value is set to `NIL` instead.
+
+ - Returns: `T` if an entry was removed, `NIL` if there was none.
  */
 LISP_EXTERN lisp_object_t lisp_plist_remprop(lisp_object_t plist,
                                              lisp_object_t symbol);
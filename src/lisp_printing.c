@@ -7,10 +7,13 @@
 
 #include "lisp_printing.h"
 
+#include "lisp_array.h"
 #include "lisp_atom.h"
+#include "lisp_built_in_streams.h"
 #include "lisp_cell.h"
 #include "lisp_environment.h"
 #include "lisp_fixnum.h"
+#include "lisp_hash_table.h"
 #include "lisp_interior.h"
 #include "lisp_memory.h"
 #include "lisp_stream.h"
@@ -19,11 +22,44 @@
 #include "lisp_subr.h"
 #include "lisp_vector.h"
 
+#if LISP_USE_STDLIB
+#include <string.h>
+#endif
+
+
+/**
+ Define a printer control variable in the given environment, with an
+ initial value of `NIL`.
+ */
+static lisp_object_t lisp_printing_define_variable(lisp_object_t environment, const char *name)
+{
+    lisp_object_t symbol_name = lisp_string_create_c(name);
+    lisp_object_t symbol = lisp_atom_create(symbol_name);
+    lisp_environment_set_symbol_value(environment, symbol, lisp_PNAME, symbol_name, lisp_NIL);
+    lisp_environment_set_symbol_value(environment, symbol, lisp_APVAL, lisp_NIL, lisp_NIL);
+    return symbol;
+}
+
+void lisp_printing_initialize(lisp_object_t environment)
+{
+    lisp_PRINT_CIRCLE = lisp_printing_define_variable(environment, "*PRINT-CIRCLE*");
+    lisp_PRINT_LENGTH = lisp_printing_define_variable(environment, "*PRINT-LENGTH*");
+    lisp_PRINT_LEVEL = lisp_printing_define_variable(environment, "*PRINT-LEVEL*");
+}
+
 
 lisp_object_t lisp_print(lisp_object_t environment, lisp_object_t stream, lisp_object_t object)
 {
     lisp_object_t output_stream = lisp_stream_best_output_stream(environment, stream);
+    if (output_stream == lisp_NIL) {
+        return lisp_NIL;
+    }
 
+    return lisp_print_object(environment, output_stream, object);
+}
+
+lisp_object_t lisp_print_object(lisp_object_t environment, lisp_object_t output_stream, lisp_object_t object)
+{
     lisp_tag_t tag = lisp_object_get_tag(object);
 
     switch (tag) {
@@ -38,18 +74,19 @@ lisp_object_t lisp_print(lisp_object_t environment, lisp_object_t stream, lisp_o
         } break;
 
         case lisp_tag_cell: {
-            lisp_cell_t cell_value = lisp_cell_get_value(object);
-            return lisp_cell_print(environment, output_stream, cell_value);
+            return lisp_print_structure(environment, output_stream, object, lisp_T);
         } break;
 
         case lisp_tag_struct: {
+            if (lisp_arrayp(object) != lisp_NIL) {
+                return lisp_array_print(output_stream, object);
+            }
             lisp_struct_t struct_value = lisp_struct_get_value(object);
             return lisp_struct_print(environment, output_stream, struct_value);
         } break;
 
         case lisp_tag_vector: {
-            lisp_vector_t vector_value = lisp_vector_get_value(object);
-            return lisp_vector_print(environment, output_stream, vector_value);
+            return lisp_print_structure(environment, output_stream, object, lisp_T);
         } break;
 
         case lisp_tag_char: {
@@ -72,9 +109,530 @@ lisp_object_t lisp_print(lisp_object_t environment, lisp_object_t stream, lisp_o
             return lisp_subr_print(output_stream, subr_value);
         } break;
 
+        case lisp_tag_hash_table: {
+            lisp_hash_table_t table_value = lisp_hash_table_get_value(object);
+            return lisp_hash_table_print(output_stream, table_value);
+        } break;
+
         case lisp_tag_interior: {
             lisp_interior_t interior_value = lisp_interior_get_value(object);
             return lisp_interior_print(output_stream, interior_value);
         } break;
     }
+
+    return lisp_NIL;
+}
+
+
+/* MARK: - Structure Printing */
+
+/** The number of frames the printer's stack holds before it must grow. */
+#define LISP_PRINT_STACK_INITIAL_CAPACITY 64
+
+/** What a frame on the printer's stack has left to print. */
+typedef enum lisp_print_step {
+    /** Print the frame's object as an element of a structure. */
+    lisp_print_step_element,
+
+    /** Print the rest of a list, whose next cell is the frame's object. */
+    lisp_print_step_list_rest,
+
+    /** Print the rest of a vector, from the frame's count onward. */
+    lisp_print_step_vector_rest,
+
+    /** Print the dot between a CAR and CDR. */
+    lisp_print_step_dot,
+
+    /** Print a closing parenthesis. */
+    lisp_print_step_close,
+} lisp_print_step_t;
+
+/**
+ A frame on the printer's stack. The count is the number of elements
+ of the object's structure already printed, and the depth is the depth
+ at which its elements are printed.
+ */
+typedef struct lisp_print_frame {
+    lisp_print_step_t step;
+    lisp_object_t object;
+    uintptr_t count;
+    uintptr_t depth;
+} *lisp_print_frame_t;
+
+/**
+ The state of printing one structure.
+
+ The stack starts out in a C array and only moves to the heap if the
+ structure is nested too deeply for that, so printing most structures
+ doesn't allocate at all.
+
+ When `*PRINT-CIRCLE*` is true, the labels are an `EQ` hash table with
+ an entry for every cell and vector in the structure: `NIL` for those
+ seen only once, `T` for those seen more than once but not yet printed,
+ and the fixnum label for those already printed.
+ */
+typedef struct lisp_print_state {
+    lisp_object_t environment;
+    lisp_object_t stream;
+    lisp_object_t compress_dots;
+    lisp_object_t labels;
+    lisp_fixnum_t label_count;
+    intptr_t length;
+    intptr_t level;
+    lisp_print_frame_t frames;
+    uintptr_t count;
+    uintptr_t capacity;
+} *lisp_print_state_t;
+
+
+/** Write a C string to the state's stream. */
+static void lisp_print_text(lisp_print_state_t state, const char *text)
+{
+    lisp_stream_write_bytes(state->stream, (const unsigned char *)text, (uintptr_t)strlen(text));
+}
+
+/** Push a frame on the state's stack, moving the stack to the heap to grow it. */
+static void lisp_print_push(lisp_print_state_t state,
+                            lisp_print_step_t step,
+                            lisp_object_t object,
+                            uintptr_t count,
+                            uintptr_t depth)
+{
+    if (state->count == state->capacity) {
+        lisp_print_frame_t frames;
+        const uintptr_t capacity = state->capacity * 2;
+        lisp_interior_create(sizeof(struct lisp_print_frame) * capacity, (void **)&frames);
+        memcpy(frames, state->frames, sizeof(struct lisp_print_frame) * state->count);
+        state->frames = frames;
+        state->capacity = capacity;
+    }
+
+    lisp_print_frame_t frame = &state->frames[state->count];
+    frame->step = step;
+    frame->object = object;
+    frame->count = count;
+    frame->depth = depth;
+    state->count = state->count + 1;
+}
+
+/** Indicate whether an object is a structure the printer descends into. */
+static int lisp_print_structurep(lisp_object_t object)
+{
+    lisp_tag_t tag = lisp_object_get_tag(object);
+    return (tag == lisp_tag_cell) || (tag == lisp_tag_vector);
+}
+
+/** Get a printer control variable that must be a non-negative fixnum, or -1. */
+static intptr_t lisp_print_limit(lisp_object_t environment, lisp_object_t symbol)
+{
+    if (symbol == NULL) return -1;
+    lisp_object_t value = lisp_environment_get_symbol_value(environment, symbol, lisp_APVAL, lisp_T);
+    if (lisp_fixnump(value) == lisp_NIL) return -1;
+    lisp_fixnum_t limit = lisp_fixnum_get_value(value);
+    return (limit < 0) ? -1 : (intptr_t)limit;
+}
+
+/**
+ Find every cell and vector reachable from an object more than once,
+ for `*PRINT-CIRCLE*`, using the state's stack for the traversal.
+ */
+static void lisp_print_find_shared(lisp_print_state_t state, lisp_object_t object)
+{
+    /* The table itself is never in the structure, so it marks absence. */
+    lisp_object_t absent = state->labels;
+
+    lisp_print_push(state, lisp_print_step_element, object, 0, 0);
+    while (state->count > 0) {
+        state->count = state->count - 1;
+        lisp_object_t current = state->frames[state->count].object;
+        if (!lisp_print_structurep(current)) {
+            continue;
+        }
+
+        if (lisp_hash_table_get(state->labels, current, absent) != absent) {
+            lisp_hash_table_put(state->labels, current, lisp_T);
+            continue;
+        }
+        lisp_hash_table_put(state->labels, current, lisp_NIL);
+
+        if (lisp_cellp(current) != lisp_NIL) {
+            lisp_cell_t cell_value = lisp_cell_get_value(current);
+            lisp_print_push(state, lisp_print_step_element, cell_value->cdr, 0, 0);
+            lisp_print_push(state, lisp_print_step_element, cell_value->car, 0, 0);
+        } else {
+            lisp_vector_t vector_value = lisp_vector_get_value(current);
+            for (uintptr_t i = vector_value->count; i > 0; i--) {
+                lisp_print_push(state, lisp_print_step_element, vector_value->values[i - 1], 0, 0);
+            }
+        }
+    }
+}
+
+/** Indicate whether an object has a label under `*PRINT-CIRCLE*`. */
+static int lisp_print_sharedp(lisp_print_state_t state, lisp_object_t object)
+{
+    return (state->labels != lisp_NIL)
+        && (lisp_hash_table_get(state->labels, object, lisp_NIL) != lisp_NIL);
+}
+
+/**
+ Print an object as an element of a structure at the given depth.
+
+ Atoms are printed directly, with characters and strings quoted so they
+ can be read back. Structures are opened, with frames pushed to print
+ their contents.
+ */
+static void lisp_print_element(lisp_print_state_t state, lisp_object_t object, uintptr_t depth)
+{
+    switch (lisp_object_get_tag(object)) {
+        case lisp_tag_char: {
+            lisp_char_t char_value = lisp_char_get_value(object);
+            lisp_char_print_quoted(state->stream, char_value, lisp_T);
+            return;
+        } break;
+
+        case lisp_tag_string: {
+            lisp_string_t string_value = lisp_string_get_value(object);
+            lisp_string_print_quoted(state->stream, string_value, lisp_T);
+            return;
+        } break;
+
+        case lisp_tag_cell:
+        case lisp_tag_vector:
+            break;
+
+        default:
+            lisp_print_object(state->environment, state->stream, object);
+            return;
+    }
+
+    if ((state->level >= 0) && (depth >= (uintptr_t)state->level)) {
+        lisp_print_text(state, "#");
+        return;
+    }
+
+    if (state->labels != lisp_NIL) {
+        lisp_object_t label = lisp_hash_table_get(state->labels, object, lisp_NIL);
+        if (lisp_fixnump(label) != lisp_NIL) {
+            lisp_print_text(state, "#");
+            lisp_fixnum_print(state->stream, lisp_fixnum_get_value(label));
+            lisp_print_text(state, "#");
+            return;
+        } else if (label != lisp_NIL) {
+            state->label_count = state->label_count + 1;
+            lisp_hash_table_put(state->labels, object, lisp_fixnum_create(state->label_count));
+            lisp_print_text(state, "#");
+            lisp_fixnum_print(state->stream, state->label_count);
+            lisp_print_text(state, "=");
+        }
+    }
+
+    if (lisp_cellp(object) != lisp_NIL) {
+        lisp_cell_t cell_value = lisp_cell_get_value(object);
+        if (state->compress_dots == lisp_NIL) {
+            lisp_print_text(state, "(");
+            lisp_print_push(state, lisp_print_step_close, lisp_NIL, 0, depth);
+            lisp_print_push(state, lisp_print_step_element, cell_value->cdr, 0, depth + 1);
+            lisp_print_push(state, lisp_print_step_dot, lisp_NIL, 0, depth);
+            lisp_print_push(state, lisp_print_step_element, cell_value->car, 0, depth + 1);
+        } else if (state->length == 0) {
+            lisp_print_text(state, "(...)");
+        } else {
+            lisp_print_text(state, "(");
+            lisp_print_push(state, lisp_print_step_list_rest, cell_value->cdr, 1, depth + 1);
+            lisp_print_push(state, lisp_print_step_element, cell_value->car, 0, depth + 1);
+        }
+    } else {
+        lisp_print_text(state, "#(");
+        lisp_print_push(state, lisp_print_step_vector_rest, object, 0, depth + 1);
+    }
+}
+
+/**
+ Print the rest of a list, given the CDR of the last cell printed.
+
+ The CDR is printed after a dot if it isn't a cell, or if it's a cell
+ that's labeled and so must be printed as a reference to its label.
+ */
+static void lisp_print_list_rest(lisp_print_state_t state, lisp_print_frame_t frame)
+{
+    lisp_object_t rest = frame->object;
+
+    if (rest == lisp_NIL) {
+        lisp_print_text(state, ")");
+    } else if ((lisp_cellp(rest) != lisp_NIL) && !lisp_print_sharedp(state, rest)) {
+        if ((state->length >= 0) && (frame->count >= (uintptr_t)state->length)) {
+            lisp_print_text(state, " ...)");
+        } else {
+            lisp_cell_t cell_value = lisp_cell_get_value(rest);
+            lisp_print_text(state, " ");
+            lisp_print_push(state, lisp_print_step_list_rest, cell_value->cdr, frame->count + 1, frame->depth);
+            lisp_print_push(state, lisp_print_step_element, cell_value->car, 0, frame->depth);
+        }
+    } else {
+        lisp_print_text(state, " . ");
+        lisp_print_push(state, lisp_print_step_close, lisp_NIL, 0, frame->depth);
+        lisp_print_push(state, lisp_print_step_element, rest, 0, frame->depth - 1);
+    }
+}
+
+/** Print the rest of a vector, starting from the frame's count. */
+static void lisp_print_vector_rest(lisp_print_state_t state, lisp_print_frame_t frame)
+{
+    lisp_vector_t vector_value = lisp_vector_get_value(frame->object);
+    const uintptr_t index = frame->count;
+
+    if (index >= vector_value->count) {
+        lisp_print_text(state, ")");
+    } else if ((state->length >= 0) && (index >= (uintptr_t)state->length)) {
+        lisp_print_text(state, (index == 0) ? "...)" : " ...)");
+    } else {
+        if (index > 0) {
+            lisp_print_text(state, " ");
+        }
+        lisp_print_push(state, lisp_print_step_vector_rest, frame->object, index + 1, frame->depth);
+        lisp_print_push(state, lisp_print_step_element, vector_value->values[index], 0, frame->depth);
+    }
+}
+
+lisp_object_t lisp_print_structure(lisp_object_t environment,
+                                   lisp_object_t stream,
+                                   lisp_object_t object,
+                                   lisp_object_t compress_dots)
+{
+    struct lisp_print_frame initial_frames[LISP_PRINT_STACK_INITIAL_CAPACITY];
+    struct lisp_print_state state;
+    state.environment = environment;
+    state.stream = stream;
+    state.compress_dots = compress_dots;
+    state.labels = lisp_NIL;
+    state.label_count = 0;
+    state.length = lisp_print_limit(environment, lisp_PRINT_LENGTH);
+    state.level = lisp_print_limit(environment, lisp_PRINT_LEVEL);
+    state.frames = initial_frames;
+    state.count = 0;
+    state.capacity = LISP_PRINT_STACK_INITIAL_CAPACITY;
+
+    if ((lisp_PRINT_CIRCLE != NULL)
+        && (lisp_environment_get_symbol_value(environment, lisp_PRINT_CIRCLE, lisp_APVAL, lisp_T) != lisp_NIL))
+    {
+        state.labels = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+        lisp_print_find_shared(&state, object);
+    }
+
+    lisp_print_element(&state, object, 0);
+
+    while (state.count > 0) {
+        state.count = state.count - 1;
+        struct lisp_print_frame frame = state.frames[state.count];
+
+        switch (frame.step) {
+            case lisp_print_step_element:
+                lisp_print_element(&state, frame.object, frame.depth);
+                break;
+
+            case lisp_print_step_list_rest:
+                lisp_print_list_rest(&state, &frame);
+                break;
+
+            case lisp_print_step_vector_rest:
+                lisp_print_vector_rest(&state, &frame);
+                break;
+
+            case lisp_print_step_dot:
+                lisp_print_text(&state, " . ");
+                break;
+
+            case lisp_print_step_close:
+                lisp_print_text(&state, ")");
+                break;
+        }
+    }
+
+    return lisp_T;
+}
+
+
+/* MARK: - Formatted Printing */
+
+/** The most parameters any directive takes. */
+#define LISP_FORMAT_PARAMETERS_MAX 3
+
+/** The size of the buffer used to write runs of literal characters. */
+#define LISP_FORMAT_BUFFER_SIZE 64
+
+/**
+ Print one argument as a fixnum in the given radix, or just print it if
+ it isn't a fixnum.
+ */
+static lisp_object_t lisp_format_fixnum(lisp_object_t environment,
+                                        lisp_object_t stream,
+                                        lisp_object_t argument,
+                                        intptr_t radix,
+                                        intptr_t width,
+                                        intptr_t padding)
+{
+    if (lisp_fixnump(argument) == lisp_NIL) {
+        return lisp_print_object(environment, stream, argument);
+    }
+
+    if (radix < 0) radix = 10;
+    if (width < 0) width = 0;
+    if (padding < 0) padding = ' ';
+
+    return lisp_fixnum_print_radix(stream, lisp_fixnum_get_value(argument),
+                                   (unsigned int)radix, (uintptr_t)width, (char)padding);
+}
+
+lisp_object_t lisp_format(lisp_object_t environment,
+                          lisp_object_t destination,
+                          lisp_object_t control,
+                          lisp_object_t arguments)
+{
+    if (lisp_stringp(control) == lisp_NIL) {
+        return lisp_NIL;
+    }
+
+    lisp_object_t stream;
+    if (destination == lisp_NIL) {
+        stream = lisp_stream_create_string_output();
+    } else {
+        stream = lisp_stream_best_output_stream(environment, destination);
+        if (stream == lisp_NIL) {
+            return lisp_NIL;
+        }
+    }
+
+    lisp_string_t control_value = lisp_string_get_value(control);
+    const uintptr_t length = control_value->length;
+    lisp_object_t *chars = (lisp_object_t *)lisp_interior_get_value(control_value->chars);
+
+    unsigned char buffer[LISP_FORMAT_BUFFER_SIZE];
+    uintptr_t buffered = 0;
+
+    uintptr_t i = 0;
+    while (i < length) {
+        lisp_char_t ch = lisp_char_get_value(chars[i]);
+        i = i + 1;
+
+        /* Collect runs of literal characters to write all at once. */
+        if (ch != '~') {
+            buffer[buffered] = (unsigned char)ch;
+            buffered = buffered + 1;
+            if (buffered == LISP_FORMAT_BUFFER_SIZE) {
+                lisp_stream_write_bytes(stream, buffer, buffered);
+                buffered = 0;
+            }
+            continue;
+        }
+
+        if (buffered > 0) {
+            lisp_stream_write_bytes(stream, buffer, buffered);
+            buffered = 0;
+        }
+
+        /* Parse the directive's parameters, where -1 means unsupplied. */
+        intptr_t parameters[LISP_FORMAT_PARAMETERS_MAX] = { -1, -1, -1 };
+        uintptr_t parameter_count = 0;
+        lisp_char_t directive = 0;
+        while (i < length) {
+            ch = lisp_char_get_value(chars[i]);
+            i = i + 1;
+
+            intptr_t parameter = -1;
+            if (ch == '\'') {
+                if (i == length) return lisp_NIL;
+                parameter = (intptr_t)lisp_char_get_value(chars[i]);
+                i = i + 1;
+                ch = (i < length) ? lisp_char_get_value(chars[i]) : 0;
+                i = i + 1;
+            } else if ((ch >= '0') && (ch <= '9')) {
+                parameter = 0;
+                while ((ch >= '0') && (ch <= '9')) {
+                    parameter = (parameter * 10) + (intptr_t)(ch - '0');
+                    ch = (i < length) ? lisp_char_get_value(chars[i]) : 0;
+                    i = i + 1;
+                }
+            }
+
+            if (parameter_count < LISP_FORMAT_PARAMETERS_MAX) {
+                parameters[parameter_count] = parameter;
+            }
+            parameter_count = parameter_count + 1;
+
+            if (ch != ',') {
+                directive = ch;
+                break;
+            }
+        }
+
+        /* Directives are case-insensitive. */
+        if ((directive >= 'a') && (directive <= 'z')) {
+            directive = directive - ('a' - 'A');
+        }
+
+        lisp_object_t argument = lisp_cell_car(arguments);
+        lisp_object_t result = lisp_T;
+        switch (directive) {
+            case 'D':
+                result = lisp_format_fixnum(environment, stream, argument, 10, parameters[0], parameters[1]);
+                arguments = lisp_cell_cdr(arguments);
+                break;
+
+            case 'B':
+                result = lisp_format_fixnum(environment, stream, argument, 2, parameters[0], parameters[1]);
+                arguments = lisp_cell_cdr(arguments);
+                break;
+
+            case 'O':
+                result = lisp_format_fixnum(environment, stream, argument, 8, parameters[0], parameters[1]);
+                arguments = lisp_cell_cdr(arguments);
+                break;
+
+            case 'X':
+                result = lisp_format_fixnum(environment, stream, argument, 16, parameters[0], parameters[1]);
+                arguments = lisp_cell_cdr(arguments);
+                break;
+
+            case 'R':
+                result = lisp_format_fixnum(environment, stream, argument, parameters[0], parameters[1], parameters[2]);
+                arguments = lisp_cell_cdr(arguments);
+                break;
+
+            case 'A':
+            case 'S':
+                result = lisp_print_object(environment, stream, argument);
+                arguments = lisp_cell_cdr(arguments);
+                break;
+
+            case '%': {
+                intptr_t count = (parameters[0] < 0) ? 1 : parameters[0];
+                for (intptr_t n = 0; n < count; n++) {
+                    lisp_stream_write_char(stream, lisp_char_create(char_newline));
+                }
+            } break;
+
+            case '~': {
+                const unsigned char tilde = '~';
+                lisp_stream_write_bytes(stream, &tilde, 1);
+            } break;
+
+            default:
+                return lisp_NIL;
+        }
+
+        if (result == lisp_NIL) {
+            return lisp_NIL;
+        }
+    }
+
+    if (buffered > 0) {
+        lisp_stream_write_bytes(stream, buffer, buffered);
+    }
+
+    if (destination == lisp_NIL) {
+        return lisp_stream_get_output_string(stream);
+    } else {
+        return lisp_T;
+    }
 }
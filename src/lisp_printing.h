@@ -10,6 +10,49 @@
 
 
 #include "lisp_types.h"
+#include "lisp_vm.h"
+
+
+/**
+ The well-known `*PRINT-CIRCLE*` symbol.
+
+ If its `APVAL` is true, cells and vectors that appear more than once in
+ a printed structure are labeled with `#n=` where they first appear and
+ referred to with `#n#` after that, so circular structures can be printed.
+
+ - Warning: This is a symbol! It must be looked up in the current
+            environment!
+ */
+#define lisp_PRINT_CIRCLE (lisp_vm_current->PRINT_CIRCLE)
+
+/**
+ The well-known `*PRINT-LENGTH*` symbol.
+
+ If its `APVAL` is a fixnum, at most that many elements of any list or
+ vector are printed, followed by `...` if there are more.
+
+ - Warning: This is a symbol! It must be looked up in the current
+            environment!
+ */
+#define lisp_PRINT_LENGTH (lisp_vm_current->PRINT_LENGTH)
+
+/**
+ The well-known `*PRINT-LEVEL*` symbol.
+
+ If its `APVAL` is a fixnum, lists and vectors nested that deeply are
+ printed as `#` rather than with their contents.
+
+ - Warning: This is a symbol! It must be looked up in the current
+            environment!
+ */
+#define lisp_PRINT_LEVEL (lisp_vm_current->PRINT_LEVEL)
+
+
+/**
+ Define the printer control variables in the given environment, all
+ initially `NIL`. This happens when a root environment is created.
+ */
+LISP_EXTERN void lisp_printing_initialize(lisp_object_t environment);
 
 
 /**
@@ -24,5 +67,76 @@
  */
 LISP_EXTERN lisp_object_t lisp_print(lisp_object_t environment, lisp_object_t stream, lisp_object_t object);
 
+/**
+ Print a Lisp object to an output stream that has already been resolved
+ from a stream designator, as `lisp_print` does once before printing.
+ Anything that prints the parts of an object uses this, so that printing
+ a large object resolves its stream only once.
+
+ - Parameters:
+   - environment: The environment providing context for printing.
+   - stream: The stream to print on, which must be a stream.
+   - object: The object to print.
+ - Returns: `T` upon success, `NIL` upon failure.
+ */
+LISP_EXTERN lisp_object_t lisp_print_object(lisp_object_t environment, lisp_object_t stream, lisp_object_t object);
+
+/**
+ Print a cell or vector to an output stream that has already been
+ resolved, along with everything it contains.
+
+ Structures are printed using an explicit stack rather than recursion,
+ so arbitrarily long and deeply nested structures can be printed, and
+ printing is subject to `*PRINT-CIRCLE*`, `*PRINT-LENGTH*`, and
+ `*PRINT-LEVEL*` in the environment. Only `*PRINT-CIRCLE*` requires
+ allocation, for the table of labels.
+
+ - Parameters:
+   - environment: The environment providing context for printing.
+   - stream: The stream to print on, which must be a stream.
+   - object: The structure to print.
+   - compress_dots: Whether to print lists as `(A B)` rather than
+                    structurally as `(A . (B . NIL))`.
+ - Returns: `T` upon success, `NIL` upon failure.
+ */
+LISP_EXTERN lisp_object_t lisp_print_structure(lisp_object_t environment,
+                                               lisp_object_t stream,
+                                               lisp_object_t object,
+                                               lisp_object_t compress_dots);
+
+
+/**
+ Print objects to an output stream as directed by a control string.
+
+ The control string is printed as-is except for _directives_, each of
+ which starts with a tilde and ends with a character naming it. Between
+ them, a directive may have comma-separated parameters, each either a
+ decimal number or a quote followed by a character. Supported are:
+
+ - `~mincol,padcharD`, `~B`, `~O`, and `~X`: Print a fixnum argument in
+   decimal, binary, octal, or hexadecimal, padded on the left to at
+   least _mincol_ characters with _padchar_ (by default a space).
+ - `~radix,mincol,padcharR`: Print a fixnum argument in the given radix.
+ - `~A` and `~S`: Print any argument.
+ - `~n%`: Print _n_ newlines (by default one).
+ - `~~`: Print a tilde.
+
+ A numeric directive given an argument that isn't a fixnum prints it as
+ `~A` would.
+
+ - Parameters:
+   - environment: The environment providing context for printing.
+   - destination: The stream to print on, `T` for `*TERMINAL-IO*`, or
+                  `NIL` to print to a new string.
+   - control: The control string.
+   - arguments: The list of arguments consumed by directives.
+ - Returns: The string printed to if _destination_ is `NIL`, otherwise
+            `T`; `NIL` upon failure, such as an unknown directive.
+ */
+LISP_EXTERN lisp_object_t lisp_format(lisp_object_t environment,
+                                      lisp_object_t destination,
+                                      lisp_object_t control,
+                                      lisp_object_t arguments);
+
 
 #endif  /* __lisp_printing__ */
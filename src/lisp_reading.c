@@ -14,6 +14,8 @@
 #include "lisp_fixnum.h"
 #include "lisp_stream.h"
 #include "lisp_string.h"
+#include "lisp_symbol_table.h"
+#include "lisp_vector.h"
 
 #include "lisp_built_in_sforms.h"
 
@@ -53,16 +55,98 @@
  tokens except those written a_b in the grammar.
  */
 
+/** The kinds of token the parser works with. */
+typedef enum lisp_read_token {
+    /** A complete object, such as an atom, fixnum, or string. */
+    lisp_read_token_object,
+
+    /** The start of a list. */
+    lisp_read_token_list_open,
+
+    /** The start of a vector, which ends like a list. */
+    lisp_read_token_vector_open,
+
+    /** The end of a list. */
+    lisp_read_token_list_close,
+
+    /** A quote of the next object. */
+    lisp_read_token_quote,
+
+    /** The end of the stream. */
+    lisp_read_token_end,
+} lisp_read_token_t;
+
 static lisp_object_t lisp_read_object(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep);
+static lisp_read_token_t lisp_read_token(lisp_object_t environment, lisp_object_t stream, lisp_object_t *read_object);
 static lisp_object_t lisp_read_atom(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep);
 static lisp_object_t lisp_read_fixnum(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep);
-static lisp_object_t lisp_read_list(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep);
 static lisp_object_t lisp_read_string(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep);
-static lisp_object_t lisp_read_vector(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep);
 static lisp_object_t lisp_read_character(lisp_object_t stream);
-static lisp_object_t lisp_read_quote(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep);
 static void lisp_skip_whitespace_and_comments(lisp_object_t stream);
 static void lisp_skip_comment(lisp_object_t stream);
+static int lisp_read_buffered_token(lisp_object_t environment, lisp_object_t stream, lisp_object_t *read_object);
+static int lisp_read_buffered_string(lisp_object_t stream, const unsigned char *bytes, uintptr_t length, lisp_object_t *read_object);
+static int lisp_skip_buffered_whitespace_and_comments(lisp_object_t stream);
+
+
+/* MARK: - Character Classes */
+
+/*
+ When a stream provides direct access to its buffered bytes, the reader
+ tokenizes them in bulk using a table of character classes rather than
+ reading and classifying a tagged character at a time. Any byte with no
+ class is an atom constituent.
+ */
+enum {
+    /** Skipped between tokens. */
+    lisp_read_class_whitespace  = 0x01,
+
+    /** Ends an atom without being part of it. */
+    lisp_read_class_terminator  = 0x02,
+
+    /** Part of a fixnum. */
+    lisp_read_class_digit       = 0x04,
+
+    /** May introduce a fixnum. */
+    lisp_read_class_sign        = 0x08,
+
+    /** Ends or escapes within a string. */
+    lisp_read_class_string      = 0x10,
+};
+
+static const unsigned char lisp_read_classes[256] = {
+    [' ']  = lisp_read_class_whitespace | lisp_read_class_terminator,
+    ['\n'] = lisp_read_class_whitespace | lisp_read_class_terminator,
+    ['\t'] = lisp_read_class_whitespace | lisp_read_class_terminator,
+    [';']  = lisp_read_class_terminator,
+    ['(']  = lisp_read_class_terminator,
+    [')']  = lisp_read_class_terminator,
+    ['#']  = lisp_read_class_terminator,
+    ['0']  = lisp_read_class_digit,
+    ['1']  = lisp_read_class_digit,
+    ['2']  = lisp_read_class_digit,
+    ['3']  = lisp_read_class_digit,
+    ['4']  = lisp_read_class_digit,
+    ['5']  = lisp_read_class_digit,
+    ['6']  = lisp_read_class_digit,
+    ['7']  = lisp_read_class_digit,
+    ['8']  = lisp_read_class_digit,
+    ['9']  = lisp_read_class_digit,
+    ['+']  = lisp_read_class_sign,
+    ['-']  = lisp_read_class_sign,
+    ['"']  = lisp_read_class_string,
+    ['\\'] = lisp_read_class_string,
+};
+
+/**
+ The maximum number of decimal digits in a fixnum, which depends on the
+ bit width of the system as described in `lisp_read_fixnum`.
+ */
+#if __LP64__
+#define LISP_READ_FIXNUM_DIGITS_MAX 18
+#else
+#define LISP_READ_FIXNUM_DIGITS_MAX 9
+#endif
 
 
 /* MARK: - Reader */
@@ -77,20 +161,147 @@ lisp_object_t lisp_read(lisp_object_t environment,
     return lisp_read_object(environment, input_stream, recursivep);
 }
 
+lisp_object_t lisp_read_finishedp(lisp_object_t environment,
+                                  lisp_object_t stream)
+{
+    lisp_object_t input_stream = lisp_stream_best_input_stream(environment, stream);
+
+    lisp_skip_whitespace_and_comments(input_stream);
+    return lisp_stream_eofp(input_stream);
+}
+
 
 /* MARK: - Parser */
 
+/*
+ Lists, vectors, and quotes are read without recursion, so arbitrarily
+ deep input needs only constant C stack. The parser keeps a stack of the
+ lists, vectors, and quotes it's in the middle of reading, as a list of
+ frames on the Lisp heap, and completes the innermost one as each object
+ is read.
+
+ Each frame is a cell whose CAR is its kind, as a fixnum, and whose CDR
+ is a cell with the frame's state: for a list or vector, the head and
+ tail of the list of elements read so far; for a quote, nothing.
+ */
+enum {
+    lisp_read_frame_list = 0,
+    lisp_read_frame_quote = 1,
+    lisp_read_frame_vector = 2,
+};
+
 lisp_object_t lisp_read_object(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep)
 {
-    lisp_object_t read_object;
+    lisp_object_t stack = lisp_NIL;
+
+    for (;;) {
+        lisp_object_t read_object = lisp_NIL;
+        lisp_read_token_t token = lisp_read_token(environment, stream, &read_object);
+
+        switch (token) {
+            case lisp_read_token_end: {
+                /* The stream ended, possibly in the middle of an object. */
+                return lisp_NIL;
+            } break;
+
+            case lisp_read_token_list_open:
+            case lisp_read_token_vector_open: {
+                /* Start a new list or vector, whose elements are read next. */
+                lisp_fixnum_t kind = ((token == lisp_read_token_list_open)
+                                      ? lisp_read_frame_list
+                                      : lisp_read_frame_vector);
+                lisp_object_t state = lisp_cell_cons(lisp_NIL, lisp_NIL);
+                lisp_object_t frame = lisp_cell_cons(lisp_fixnum_create(kind), state);
+                stack = lisp_cell_cons(frame, stack);
+                continue;
+            } break;
+
+            case lisp_read_token_quote: {
+                /* Quote whatever object is read next. */
+                lisp_object_t frame = lisp_cell_cons(lisp_fixnum_create(lisp_read_frame_quote), lisp_NIL);
+                stack = lisp_cell_cons(frame, stack);
+                continue;
+            } break;
+
+            case lisp_read_token_list_close: {
+                /*
+                 Finish the innermost list or vector. Outside of any, return
+                 the caller's end-of-list marker, or NIL to indicate an error.
+                 */
+                if (stack == lisp_NIL) {
+                    return recursivep;
+                }
+                lisp_object_t frame = lisp_cell_car(stack);
+                lisp_fixnum_t kind = lisp_fixnum_get_value(lisp_cell_car(frame));
+                if (kind == lisp_read_frame_quote) {
+                    return lisp_NIL;
+                }
+                read_object = lisp_cell_car(lisp_cell_cdr(frame));
+                if (kind == lisp_read_frame_vector) {
+                    read_object = lisp_vector_create_from_list(read_object);
+                }
+                stack = lisp_cell_cdr(stack);
+            } break;
+
+            case lisp_read_token_object: {
+                /* Fall through to complete the innermost frame. */
+            } break;
+        }
 
+        /*
+         An object was read; add it to the innermost list or vector, or finish
+         as many quotes as it completes. With no frames left, it's the result.
+         */
+        while (stack != lisp_NIL) {
+            lisp_object_t frame = lisp_cell_car(stack);
+            if (lisp_fixnum_get_value(lisp_cell_car(frame)) != lisp_read_frame_quote) {
+                lisp_object_t state = lisp_cell_cdr(frame);
+                lisp_object_t read_cell = lisp_cell_cons(read_object, lisp_NIL);
+                if (lisp_cell_car(state) == lisp_NIL) {
+                    lisp_cell_rplaca(state, read_cell);
+                } else {
+                    lisp_cell_rplacd(lisp_cell_cdr(state), read_cell);
+                }
+                lisp_cell_rplacd(state, read_cell);
+                break;
+            } else {
+                /*
+                 Return a quoted version of the object, which is the CAR of the
+                 CDR in a QUOTE special form. This is used to prevent evaluation.
+                 */
+                read_object = lisp_cell_list(lisp_symbol_QUOTE, read_object, lisp_NIL);
+                stack = lisp_cell_cdr(stack);
+            }
+        }
+        if (stack == lisp_NIL) {
+            return read_object;
+        }
+    }
+}
+
+/**
+ Read the next token from the stream: either a complete object that
+ doesn't contain other objects, or the syntax that starts or ends one
+ that does.
+
+ - Parameters:
+   - read_object: Set to the object read for `lisp_read_token_object`.
+ - Returns: The kind of token read.
+ */
+lisp_read_token_t lisp_read_token(lisp_object_t environment, lisp_object_t stream, lisp_object_t *read_object)
+{
     /* Skip to the first non-whitespace non-comment character. */
     lisp_skip_whitespace_and_comments(stream);
 
+    /* Read an atom, fixnum, or string in bulk if the stream allows it. */
+    if (lisp_read_buffered_token(environment, stream, read_object)) {
+        return lisp_read_token_object;
+    }
+
     /* Read another character. */
     lisp_object_t ch = lisp_stream_read_char(stream);
     if (ch == lisp_NIL) {
-        return lisp_NIL;
+        return lisp_read_token_end;
     }
     lisp_char_t ch_value = lisp_char_get_value(ch);
 
@@ -108,7 +319,7 @@ lisp_object_t lisp_read_object(lisp_object_t environment, lisp_object_t stream,
         case char_9:{
             /* It's a number! Restore the stream and read the number. */
             lisp_stream_unread_char(stream, ch);
-            read_object = lisp_read_fixnum(environment, stream, recursivep);
+            *read_object = lisp_read_fixnum(environment, stream, lisp_NIL);
         } break;
 
         case char_plus:
@@ -122,58 +333,50 @@ lisp_object_t lisp_read_object(lisp_object_t environment, lisp_object_t stream,
             lisp_stream_unread_char(stream, next_ch);
             lisp_stream_unread_char(stream, ch);
             if ((next_ch_value >= '0') && (next_ch_value <= '9')) {
-                read_object = lisp_read_fixnum(environment, stream, recursivep);
+                *read_object = lisp_read_fixnum(environment, stream, lisp_NIL);
             } else {
-                read_object = lisp_read_atom(environment, stream, recursivep);
+                *read_object = lisp_read_atom(environment, stream, lisp_NIL);
             }
         } break;
 
         case char_single_quote: {
-            /* It's a QUOTE! Restore the stream and read the expression. */
-            lisp_stream_unread_char(stream, ch);
-            read_object = lisp_read_quote(environment, stream, recursivep);
+            /* It's a QUOTE! The quoted object is read next. */
+            return lisp_read_token_quote;
         } break;
 
         case char_paren_open: {
-            /* It's a list! Restore the stream and read the list. */
-            lisp_stream_unread_char(stream, ch);
-            read_object = lisp_read_list(environment, stream, recursivep);
+            /* It's a list! Its elements are read next. */
+            return lisp_read_token_list_open;
         } break;
 
         case char_paren_close: {
-            /*
-             It's an EOL marker! If an EOL marker was passed as recursivep,
-             return that, otherwise indicate an error by returning NIL.
-             */
-            return recursivep;
+            /* It's the end of a list. */
+            return lisp_read_token_list_close;
         } break;
 
         case char_double_quote: {
             /* It's a string! Restore the stream and read the string. */
             lisp_stream_unread_char(stream, ch);
-            read_object = lisp_read_string(environment, stream, recursivep);
+            *read_object = lisp_read_string(environment, stream, lisp_NIL);
         } break;
 
         case char_octothorpe: {
             /* It's either a vector or a character, read another to decide. */
             lisp_object_t ch2 = lisp_stream_read_char(stream);
             if (ch2 == lisp_NIL) {
-                return lisp_NIL;
+                return lisp_read_token_end;
             }
             lisp_char_t ch2_value = lisp_char_get_value(ch2);
             switch (ch2_value) {
                 case char_paren_open:
-                    /* Restore the stream and read the vector. */
-                    lisp_stream_unread_char(stream, ch2);
-                    lisp_stream_unread_char(stream, ch);
-                    read_object = lisp_read_vector(environment, stream, recursivep);
-                    break;
+                    /* It's a vector! Its elements are read next. */
+                    return lisp_read_token_vector_open;
 
                 case char_backslash:
                     /* Restore the stream and read the character. */
                     lisp_stream_unread_char(stream, ch2);
                     lisp_stream_unread_char(stream, ch);
-                    read_object = lisp_read_character(stream);
+                    *read_object = lisp_read_character(stream);
                     break;
 
                 default:
@@ -186,11 +389,11 @@ lisp_object_t lisp_read_object(lisp_object_t environment, lisp_object_t stream,
         default: {
             /* It's an atom! Restore the stream and read the atom. */
             lisp_stream_unread_char(stream, ch);
-            read_object = lisp_read_atom(environment, stream, recursivep);
+            *read_object = lisp_read_atom(environment, stream, lisp_NIL);
         } break;
     }
 
-    return read_object;
+    return lisp_read_token_object;
 }
 
 lisp_object_t lisp_read_atom(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep)
@@ -245,19 +448,13 @@ lisp_object_t lisp_read_atom(lisp_object_t environment, lisp_object_t stream, li
 
     if (atom_name != lisp_NIL) {
         /*
-         Once we have a full atom name, create an atom and return it. Since we
-         have access to the complete environment, if the read atom is equal to
-         an existing atom, return the existing atom. If it doesn't, intern it
-         so that reading `(A A)` returns the same atom for both the CAR and
-         CADR.
+         Once we have a full atom name, create an atom and return the atom
+         the symbol table has for that name, so that reading `(A A)` returns
+         the same atom for both the CAR and CADR. This doesn't bind anything
+         in the environment.
          */
         lisp_object_t read_atom = lisp_atom_create(atom_name);
-        lisp_object_t atom_symbol = lisp_environment_find_symbol(environment, read_atom, lisp_T);
-        if (atom_symbol != lisp_NIL) {
-            read_object = lisp_cell_car(atom_symbol);
-        } else {
-            read_object = lisp_environment_intern_symbol(environment, read_atom);
-        }
+        read_object = lisp_symbol_table_intern(read_atom);
     } else {
         read_object = lisp_NIL;
     }
@@ -348,65 +545,6 @@ lisp_object_t lisp_read_fixnum(lisp_object_t environment, lisp_object_t stream,
     return read_object;
 }
 
-lisp_object_t lisp_read_list(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep)
-{
-    lisp_object_t read_object = lisp_NIL;
-
-    lisp_object_t ch;
-
-    /* Create a list in which to place read objects. */
-    lisp_object_t list_head = lisp_NIL;
-    lisp_object_t list_cur = lisp_NIL;
-
-    /* Read the list introducer. */
-    ch = lisp_stream_read_char(stream);
-    if ((ch == lisp_NIL) || (ch != lisp_char_create(char_paren_open))) {
-        return lisp_NIL;
-    }
-
-    /*
-     Read all of the contained objects until the final close parenthesis.
-     This is indicated by passing a brand-new, uninterned atom as the
-     `recursivep` argument to lisp_read_object, which is then returned as
-     the read object.
-     */
-    lisp_object_t eol_signifier = lisp_atom_create_c("%SI:END-OF-LIST");
-    int done = 0;
-    do {
-        /* Read one object from the stream. */
-        lisp_object_t one_object = lisp_read_object(environment, stream, eol_signifier);
-        if (one_object != eol_signifier) {
-            /*
-             If the read object is not our EOL marker, create a cell with the
-             read object as the CAR and a NIL CDR, and append that to the list.
-             */
-            lisp_object_t read_cell = lisp_cell_cons(one_object, lisp_NIL);
-
-            if (list_cur == lisp_NIL) {
-                /*
-                 If we haven't read any objects, use this as the first cell in
-                 the list.
-                 */
-                list_head = read_cell;
-            } else {
-                /* Just append to the current cell. */
-                lisp_cell_rplacd(list_cur, read_cell);
-            }
-
-            /* The read object is now our current cell. */
-            list_cur = read_cell;
-        } else {
-            /*
-             If the read object is our EOL marker, we're done.
-             */
-            read_object = list_head;
-            done = 1;
-        }
-    } while (!done);
-
-    return read_object;
-}
-
 lisp_object_t lisp_read_string(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep)
 {
     lisp_object_t read_object;
@@ -461,12 +599,6 @@ lisp_object_t lisp_read_string(lisp_object_t environment, lisp_object_t stream,
     return read_object;
 }
 
-lisp_object_t lisp_read_vector(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep)
-{
-#warning lisp_read_vector: Implement.
-    return lisp_NIL;
-}
-
 /**
  Read a character token from the input stream.
  */
@@ -500,42 +632,16 @@ lisp_object_t lisp_read_character(lisp_object_t stream)
     return read_object;
 }
 
-/**
- Read a quoted object from the input stream, returning the object within
- a `QUOTE` special form. This happens at the reading level to make the
- syntax extra-convenient, otherwise it would add extra parentheses in
- many places.
- */
-lisp_object_t lisp_read_quote(lisp_object_t environment, lisp_object_t stream, lisp_object_t recursivep)
-{
-    lisp_object_t read_object;
-
-    lisp_object_t ch;
-
-    /* Read the QUOTE introducer. */
-    ch = lisp_stream_read_char(stream);
-    if (ch != lisp_char_create(char_single_quote)) {
-        return lisp_NIL;
-    }
-
-    /* Read the the object to quote. */
-    lisp_object_t object = lisp_read(environment, stream, recursivep);
-
-    /*
-     Return a quoted version of the object, which is the CAR of the CDR in
-     a QUOTE special form. This is used to prevent evaluation.
-     */
-
-    read_object = lisp_cell_list(lisp_symbol_QUOTE, object, lisp_NIL);
-
-    return read_object;
-}
-
 /**
  Read the input stream forward until the next non-whitespace character or the end of an end-of-line comment.
  */
 void lisp_skip_whitespace_and_comments(lisp_object_t stream)
 {
+    /* Skip in bulk if the stream allows it. */
+    if (lisp_skip_buffered_whitespace_and_comments(stream)) {
+        return;
+    }
+
     int done = 0;
     do {
         /* Read the next character. */
@@ -604,3 +710,134 @@ void lisp_skip_comment(lisp_object_t stream)
         }
     } while (!done);
 }
+
+
+/* MARK: - Buffered Reading */
+
+/**
+ Try to read an atom, fixnum, or string directly from the bytes buffered
+ by the stream, finding the end of the token in bulk. Atoms already in
+ the symbol table are found without allocating anything.
+
+ - Returns: Nonzero if an object was read into `read_object`, zero if
+            nothing was consumed and the caller should read the object a
+            character at a time instead. That happens if the stream has
+            no buffer or characters pushed back, the next object is some
+            other kind, or the token may continue past the buffer.
+ */
+int lisp_read_buffered_token(lisp_object_t environment, lisp_object_t stream, lisp_object_t *read_object)
+{
+    uintptr_t length;
+    const unsigned char *bytes = lisp_stream_buffer(stream, &length);
+    if (bytes == NULL) {
+        return 0;
+    }
+
+    unsigned char first_class = lisp_read_classes[bytes[0]];
+
+    if (bytes[0] == char_double_quote) {
+        return lisp_read_buffered_string(stream, bytes, length, read_object);
+    }
+
+    /* Lists, vectors, characters, and quotes have their own readers. */
+    if ((first_class & lisp_read_class_terminator) || (bytes[0] == char_single_quote)) {
+        return 0;
+    }
+
+    /* A digit, or a sign followed by a digit, introduces a fixnum. */
+    uintptr_t digits_start = (first_class & lisp_read_class_sign) ? 1 : 0;
+    if ((digits_start < length) && (lisp_read_classes[bytes[digits_start]] & lisp_read_class_digit)) {
+        lisp_fixnum_t value = 0;
+        uintptr_t end = digits_start;
+        while ((end < length) && (lisp_read_classes[bytes[end]] & lisp_read_class_digit)) {
+            if ((end - digits_start) == LISP_READ_FIXNUM_DIGITS_MAX) {
+                return 0;
+            }
+            value = (value * 10) + (bytes[end] - '0');
+            end = end + 1;
+        }
+        if (end == length) {
+            return 0;
+        }
+
+        *read_object = lisp_fixnum_create((bytes[0] == char_minus) ? -value : value);
+        lisp_stream_consume(stream, end);
+        return 1;
+    }
+
+    /* Anything else is an atom, which runs until a terminator. */
+    uintptr_t end = 1;
+    while ((end < length) && !(lisp_read_classes[bytes[end]] & lisp_read_class_terminator)) {
+        end = end + 1;
+    }
+    if (end == length) {
+        return 0;
+    }
+
+    *read_object = lisp_symbol_table_intern_bytes((const char *)bytes, end);
+    lisp_stream_consume(stream, end);
+    return 1;
+}
+
+/**
+ Try to read a string without escapes directly from the given buffered
+ bytes, which start with the string introducer.
+
+ - Returns: Nonzero if a string was read into `read_object`, zero if the
+            string has escapes or may continue past the buffer.
+ */
+int lisp_read_buffered_string(lisp_object_t stream, const unsigned char *bytes, uintptr_t length, lisp_object_t *read_object)
+{
+    uintptr_t end = 1;
+    while ((end < length) && !(lisp_read_classes[bytes[end]] & lisp_read_class_string)) {
+        end = end + 1;
+    }
+    if ((end == length) || (bytes[end] != char_double_quote)) {
+        return 0;
+    }
+
+    *read_object = lisp_string_create_bytes((const char *)bytes + 1, end - 1);
+    lisp_stream_consume(stream, end + 1);
+    return 1;
+}
+
+/**
+ Skip whitespace and end-of-line comments directly in the bytes buffered
+ by the stream, refilling the buffer as it's exhausted.
+
+ - Returns: Nonzero if everything up to the next token was skipped, zero
+            if the stream can't be read this way right now.
+ */
+int lisp_skip_buffered_whitespace_and_comments(lisp_object_t stream)
+{
+    uintptr_t length;
+    const unsigned char *bytes = lisp_stream_buffer(stream, &length);
+    if (bytes == NULL) {
+        return 0;
+    }
+
+    int in_comment = 0;
+    do {
+        for (uintptr_t i = 0; i < length; i++) {
+            unsigned char byte = bytes[i];
+            if (in_comment) {
+                /* A newline ends the comment. */
+                if (byte == char_newline) {
+                    in_comment = 0;
+                }
+            } else if (byte == char_semicolon) {
+                in_comment = 1;
+            } else if (!(lisp_read_classes[byte] & lisp_read_class_whitespace)) {
+                /* Anything else starts the next token. */
+                lisp_stream_consume(stream, i);
+                return 1;
+            }
+        }
+
+        /* Skip the whole buffer and look at the next. */
+        lisp_stream_consume(stream, length);
+        bytes = lisp_stream_buffer(stream, &length);
+    } while (bytes != NULL);
+
+    return 1;
+}
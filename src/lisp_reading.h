@@ -43,5 +43,20 @@ LISP_EXTERN lisp_object_t lisp_read(lisp_object_t environment,
                                     lisp_object_t stream,
                                     lisp_object_t recursivep);
 
+/**
+ Skip whitespace and end-of-line comments, and indicate whether there
+ are no more forms to read from a stream. Code that reads every form in
+ a stream should check this rather than `lisp_stream_eofp`, which is
+ still false when nothing but whitespace or a comment is left, as it
+ is at the end of most files.
+
+ - Parameters:
+   - environment: The environment in which the read takes place.
+   - stream: The stream to read from, or `T` for `*STANDARD-INPUT*`.
+ - Returns: `T` if there are no more forms to read, `NIL` otherwise.
+ */
+LISP_EXTERN lisp_object_t lisp_read_finishedp(lisp_object_t environment,
+                                              lisp_object_t stream);
+
 
 #endif  /* __lisp_reading__ */
@@ -0,0 +1,76 @@
+/*
+    File:       lisp_root.h
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#ifndef __lisp_root__
+#define __lisp_root__ 1
+
+
+#include "lisp_types.h"
+#include "lisp_cell.h"
+#include "lisp_string.h"
+#include "lisp_subr.h"
+
+
+/**
+ The static root environment.
+
+ The root environment, the atoms it binds, their `PNAME` strings, and
+ the built-in `SUBR` objects are all constant data generated at build
+ time by `lisp_root_generator` from `lisp_built_in_sforms.def` and
+ `lisp_built_in_subrs.def`. None of it is on the heap, so creating a
+ root environment doesn't have to construct any of it, a garbage
+ collector never has to scan or move any of it, and every interpreter
+ in a process shares it.
+
+ Since the data is constant, the root environment can never be changed;
+ `lisp_environment_create_root` returns a child of it for that.
+ */
+LISP_EXTERN const lisp_object_t lisp_root_environment;
+
+/**
+ Every atom the root environment binds, in the order it binds them.
+ The well-known atoms such as `T` and `NIL` are first.
+ */
+LISP_EXTERN const lisp_object_t lisp_root_atoms[];
+
+/** The number of atoms in `lisp_root_atoms`. */
+LISP_EXTERN const uintptr_t lisp_root_atom_count;
+
+/**
+ The symbol whose `APVAL` in an environment is its parent, which is
+ `NIL` in the root environment.
+ */
+LISP_EXTERN lisp_object_t const lisp_SI_PARENT_ENVIRONMENT;
+
+
+/* MARK: - Generated Data Support */
+
+/**
+ Every object in the generated data is aligned as the heap aligns it,
+ leaving the low four bits of its address free for its tag.
+ */
+#define LISP_ROOT_ALIGNED _Alignas(16)
+
+/**
+ A tagged reference to an object in the generated data. The object is
+ aligned, so adding the tag is the same as mixing it in, and the result
+ is still a constant the compiler and linker can resolve.
+ */
+#define LISP_ROOT_OBJECT(object, tag) \
+    ((lisp_object_t)((const char *)&(object) + (tag)))
+
+/** A character, as `lisp_char_create` would create it. */
+#define LISP_ROOT_CHAR(c) \
+    ((lisp_object_t)((((uintptr_t)(c)) << 4) | (uintptr_t)lisp_tag_char))
+
+/** A cell in the generated data, padded so every cell in an array is aligned. */
+typedef struct lisp_root_cell {
+    LISP_ROOT_ALIGNED struct lisp_cell cell;
+} lisp_root_cell_t;
+
+
+#endif  /* __lisp_root__ */
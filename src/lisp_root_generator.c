@@ -0,0 +1,387 @@
+/*
+    File:       lisp_root_generator.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+/*
+ Generate the static root environment as C source on standard output.
+
+ This is a build tool, not part of Lisp itself. It lays out the root
+ environment exactly as it would be constructed on the heap:
+
+     ((T . ((PNAME . "T")
+            (APVAL . T)))
+      (NIL . ((PNAME . "NIL")
+              (APVAL . NIL)))
+      ...
+      (%SI:PARENT-ENVIRONMENT . ((PNAME . "%SI:PARENT-ENVIRONMENT")
+                                 (APVAL . NIL)))
+      (AND . ((APVAL . NIL)))
+      ...
+      (CAR . ((SUBR . #<SUBR CAR>)
+              (PNAME . "CAR")))
+      ...)
+
+ and writes every object in it as constant data, using the macros in
+ `lisp_root.h` to align and tag it, along with a named constant for each
+ well-known atom and each special form's symbol.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** A named constant for one of the atoms in the root environment. */
+struct lisp_root_constant {
+    const char *variable;
+    const char *name;
+};
+
+/** The built-in special forms, by the constant for each one's symbol. */
+static const struct lisp_root_constant lisp_root_special_forms[] = {
+#define LISP_BUILT_IN_SPECIAL_FORM(symbol, name, function) { #symbol, name },
+#include "lisp_built_in_sforms.def"
+#undef LISP_BUILT_IN_SPECIAL_FORM
+};
+
+/** The built-in SUBRs. */
+static const struct lisp_root_subr_definition {
+    const char *function;
+    const char *name;
+    int pure;
+} lisp_root_subr_definitions[] = {
+#define LISP_BUILT_IN_SUBR(function, name, pure) { #function, name, pure },
+#include "lisp_built_in_subrs.def"
+#undef LISP_BUILT_IN_SUBR
+};
+
+/** The well-known atoms, which are always the first in the root environment. */
+static const struct lisp_root_constant lisp_root_well_known_atoms[] = {
+    { "lisp_T", "T" },
+    { "lisp_NIL", "NIL" },
+    { "lisp_PNAME", "PNAME" },
+    { "lisp_APVAL", "APVAL" },
+    { "lisp_EXPR", "EXPR" },
+    { "lisp_SUBR", "SUBR" },
+    { "lisp_SI_PARENT_ENVIRONMENT", "%SI:PARENT-ENVIRONMENT" },
+};
+
+enum { ATOM_T, ATOM_NIL, ATOM_PNAME, ATOM_APVAL, ATOM_EXPR, ATOM_SUBR, ATOM_SI_PARENT_ENVIRONMENT };
+
+#define COUNT_OF(array) (sizeof(array) / sizeof((array)[0]))
+
+#define MAX_ENTRIES 512
+#define MAX_PROPERTIES 4
+
+
+/* MARK: - Model */
+
+/** What kind of object a property's value is. */
+typedef enum lisp_root_value_kind {
+    lisp_root_value_atom,
+    lisp_root_value_string,
+    lisp_root_value_subr,
+} lisp_root_value_kind_t;
+
+/** A `(type . value)` property, where the type is an atom index. */
+struct lisp_root_property {
+    int type;
+    lisp_root_value_kind_t kind;
+    int index;
+};
+
+/** A `(symbol . plist)` entry; each entry's symbol is the atom of the same index. */
+struct lisp_root_entry {
+    const char *name;
+    struct lisp_root_property properties[MAX_PROPERTIES];
+    int property_count;
+};
+
+/** A `SUBR`, whose name is a string index. */
+struct lisp_root_subr {
+    const char *function;
+    int name;
+    int pure;
+};
+
+static struct lisp_root_entry entries[MAX_ENTRIES];
+static int entry_count = 0;
+
+static const char *strings[MAX_ENTRIES];
+static int string_count = 0;
+
+static struct lisp_root_subr subrs[MAX_ENTRIES];
+static int subr_count = 0;
+
+static void lisp_root_fail(const char *message)
+{
+    fprintf(stderr, "lisp_root_generator: %s\n", message);
+    exit(EXIT_FAILURE);
+}
+
+/** Find or add the entry for a symbol, returning its index. */
+static int lisp_root_entry(const char *name)
+{
+    for (int i = 0; i < entry_count; i++) {
+        if (strcmp(entries[i].name, name) == 0) {
+            return i;
+        }
+    }
+    if (entry_count == MAX_ENTRIES) {
+        lisp_root_fail("too many entries");
+    }
+    entries[entry_count].name = name;
+    entries[entry_count].property_count = 0;
+    entry_count = entry_count + 1;
+    return entry_count - 1;
+}
+
+/** Set a property of an entry, replacing any existing value of that type. */
+static void lisp_root_set(int entry, int type, lisp_root_value_kind_t kind, int index)
+{
+    struct lisp_root_entry *e = &entries[entry];
+    int p = 0;
+    while ((p < e->property_count) && (e->properties[p].type != type)) {
+        p++;
+    }
+    if (p == MAX_PROPERTIES) {
+        lisp_root_fail("too many properties");
+    }
+    if (p == e->property_count) {
+        e->property_count = e->property_count + 1;
+    }
+    e->properties[p].type = type;
+    e->properties[p].kind = kind;
+    e->properties[p].index = index;
+}
+
+static int lisp_root_string(const char *text)
+{
+    if (string_count == MAX_ENTRIES) {
+        lisp_root_fail("too many strings");
+    }
+    strings[string_count] = text;
+    string_count = string_count + 1;
+    return string_count - 1;
+}
+
+static void lisp_root_build(void)
+{
+    for (int i = 0; i < (int)COUNT_OF(lisp_root_well_known_atoms); i++) {
+        const char *name = lisp_root_well_known_atoms[i].name;
+        int entry = lisp_root_entry(name);
+        lisp_root_set(entry, ATOM_PNAME, lisp_root_value_string, lisp_root_string(name));
+
+        /* Each is its own APVAL, except that the root has no parent. */
+        int apval = (entry == ATOM_SI_PARENT_ENVIRONMENT) ? ATOM_NIL : entry;
+        lisp_root_set(entry, ATOM_APVAL, lisp_root_value_atom, apval);
+    }
+
+    for (int i = 0; i < (int)COUNT_OF(lisp_root_special_forms); i++) {
+        int entry = lisp_root_entry(lisp_root_special_forms[i].name);
+        lisp_root_set(entry, ATOM_APVAL, lisp_root_value_atom, ATOM_NIL);
+    }
+
+    for (int i = 0; i < (int)COUNT_OF(lisp_root_subr_definitions); i++) {
+        const struct lisp_root_subr_definition *definition = &lisp_root_subr_definitions[i];
+        int entry = lisp_root_entry(definition->name);
+        int name = lisp_root_string(definition->name);
+        subrs[subr_count].function = definition->function;
+        subrs[subr_count].name = name;
+        subrs[subr_count].pure = definition->pure;
+        lisp_root_set(entry, ATOM_SUBR, lisp_root_value_subr, subr_count);
+        lisp_root_set(entry, ATOM_PNAME, lisp_root_value_string, name);
+        subr_count = subr_count + 1;
+    }
+}
+
+
+/* MARK: - Output */
+
+static void lisp_root_print_atom(int index)
+{
+    printf("LISP_ROOT_OBJECT(lisp_root_name_%d, lisp_tag_atom)", index);
+}
+
+static void lisp_root_print_cell(int index)
+{
+    printf("LISP_ROOT_OBJECT(lisp_root_cells[%d], lisp_tag_cell)", index);
+}
+
+static void lisp_root_print_value(const struct lisp_root_property *property)
+{
+    switch (property->kind) {
+        case lisp_root_value_atom:
+            lisp_root_print_atom(property->index);
+            break;
+
+        case lisp_root_value_string:
+            printf("LISP_ROOT_OBJECT(lisp_root_string_%d, lisp_tag_string)", property->index);
+            break;
+
+        case lisp_root_value_subr:
+            printf("LISP_ROOT_OBJECT(lisp_root_subr_%d, lisp_tag_subr)", property->index);
+            break;
+    }
+}
+
+/** Print the definition of a named constant for an atom. */
+static void lisp_root_print_constant(const struct lisp_root_constant *constant)
+{
+    printf("lisp_object_t const %s = ", constant->variable);
+    lisp_root_print_atom(lisp_root_entry(constant->name));
+    printf(";\n");
+}
+
+/** Print a C string literal, escaping anything that needs it. */
+static void lisp_root_print_literal(const char *text)
+{
+    putchar('"');
+    for (const char *c = text; *c != '\0'; c++) {
+        if ((*c == '"') || (*c == '\\')) {
+            putchar('\\');
+        }
+        putchar(*c);
+    }
+    putchar('"');
+}
+
+static void lisp_root_print(void)
+{
+    printf("/*\n"
+           "    File:       lisp_root.c\n"
+           "\n"
+           "    Generated by lisp_root_generator; do not edit.\n"
+           " */\n"
+           "\n"
+           "#include \"lisp_root.h\"\n"
+           "\n"
+           "#include \"lisp_environment.h\"\n"
+           "\n"
+           "#include \"lisp_built_in_sforms.h\"\n"
+           "#include \"lisp_built_in_subrs.h\"\n"
+           "\n");
+
+    printf("\n/* MARK: - Atoms */\n\n");
+    for (int i = 0; i < entry_count; i++) {
+        printf("static LISP_ROOT_ALIGNED const char lisp_root_name_%d[] = ", i);
+        lisp_root_print_literal(entries[i].name);
+        printf(";\n");
+    }
+
+    printf("\n\n/* MARK: - Strings */\n\n");
+    for (int i = 0; i < string_count; i++) {
+        const size_t length = strlen(strings[i]);
+        printf("static LISP_ROOT_ALIGNED const lisp_object_t lisp_root_chars_%d[] = {", i);
+        for (size_t c = 0; c < length; c++) {
+            printf("%s LISP_ROOT_CHAR(%u)", (c > 0) ? "," : "", (unsigned int)(unsigned char)strings[i][c]);
+        }
+        printf(" };\n");
+        printf("static LISP_ROOT_ALIGNED const struct lisp_string lisp_root_string_%d = {\n"
+               "    LISP_ROOT_OBJECT(lisp_root_chars_%d, lisp_tag_interior), %u, %u\n"
+               "};\n",
+               i, i, (unsigned int)length, (unsigned int)length);
+    }
+
+    printf("\n\n/* MARK: - SUBRs */\n\n");
+    for (int i = 0; i < subr_count; i++) {
+        printf("static LISP_ROOT_ALIGNED const struct lisp_subr lisp_root_subr_%d = {\n"
+               "    %s,\n"
+               "    LISP_ROOT_OBJECT(lisp_root_string_%d, lisp_tag_string),\n"
+               "    ",
+               i, subrs[i].function, subrs[i].name);
+        lisp_root_print_atom(subrs[i].pure ? ATOM_T : ATOM_NIL);
+        printf("\n};\n");
+    }
+
+    /*
+     Each entry is its cell in the environment's list, the cell holding
+     the symbol and its plist, and then a pair of cells per property: the
+     cell in the plist and the cell holding its type and value.
+     */
+    int cell_count = 0;
+    for (int i = 0; i < entry_count; i++) {
+        cell_count = cell_count + 2 + (2 * entries[i].property_count);
+    }
+
+    printf("\n\n/* MARK: - Environment */\n\n");
+    printf("static const lisp_root_cell_t lisp_root_cells[%d] = {\n", cell_count);
+    int cell = 0;
+    for (int i = 0; i < entry_count; i++) {
+        const struct lisp_root_entry *e = &entries[i];
+        const int next_entry = cell + 2 + (2 * e->property_count);
+
+        printf("    /* %s */\n", e->name);
+        printf("    { { ");
+        lisp_root_print_cell(cell + 1);
+        printf(", ");
+        if (i + 1 < entry_count) {
+            lisp_root_print_cell(next_entry);
+        } else {
+            lisp_root_print_atom(ATOM_NIL);
+        }
+        printf(" } },\n");
+
+        printf("    { { ");
+        lisp_root_print_atom(i);
+        printf(", ");
+        lisp_root_print_cell(cell + 2);
+        printf(" } },\n");
+
+        for (int p = 0; p < e->property_count; p++) {
+            const int plist_cell = cell + 2 + (2 * p);
+            printf("    { { ");
+            lisp_root_print_cell(plist_cell + 1);
+            printf(", ");
+            if (p + 1 < e->property_count) {
+                lisp_root_print_cell(plist_cell + 2);
+            } else {
+                lisp_root_print_atom(ATOM_NIL);
+            }
+            printf(" } },\n");
+
+            printf("    { { ");
+            lisp_root_print_atom(e->properties[p].type);
+            printf(", ");
+            lisp_root_print_value(&e->properties[p]);
+            printf(" } },\n");
+        }
+
+        cell = next_entry;
+    }
+    printf("};\n");
+
+    printf("\nconst lisp_object_t lisp_root_environment = ");
+    lisp_root_print_cell(0);
+    printf(";\n");
+
+    printf("\nconst lisp_object_t lisp_root_atoms[] = {\n");
+    for (int i = 0; i < entry_count; i++) {
+        printf("    ");
+        lisp_root_print_atom(i);
+        printf(",\n");
+    }
+    printf("};\n");
+
+    printf("\nconst uintptr_t lisp_root_atom_count = %d;\n", entry_count);
+
+    printf("\n\n/* MARK: - Constants */\n\n");
+    for (int i = 0; i < (int)COUNT_OF(lisp_root_well_known_atoms); i++) {
+        lisp_root_print_constant(&lisp_root_well_known_atoms[i]);
+    }
+    printf("\n");
+    for (int i = 0; i < (int)COUNT_OF(lisp_root_special_forms); i++) {
+        lisp_root_print_constant(&lisp_root_special_forms[i]);
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    lisp_root_build();
+    lisp_root_print();
+    return (fflush(stdout) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -11,18 +11,38 @@
 #include "lisp_interior.h"
 #include "lisp_memory.h"
 #include "lisp_string.h"
+#include "lisp_vm.h"
 
 #if LISP_USE_STDLIB
 #include <stdio.h>
+#include <string.h>
 #endif
 
 
+/** The well-known streams, in the order they're cached. */
+typedef enum lisp_stream_designated {
+    lisp_stream_designated_terminal_io = 0,
+    lisp_stream_designated_standard_input = 1,
+    lisp_stream_designated_standard_output = 2,
+} lisp_stream_designated_t;
+
+/*
+ The well-known streams as seen from the environment they were last
+ looked up in, in the order of `lisp_stream_designated_t`, and the
+ stream epoch when they were.
+ */
+#define lisp_stream_designator_environment (lisp_vm_current->stream_designator_environment)
+#define lisp_stream_designator_epoch (lisp_vm_current->stream_designator_epoch)
+#define lisp_stream_designator_streams (lisp_vm_current->stream_designator_streams)
+
+
 lisp_object_t lisp_stream_create(lisp_object_t functions)
 {
     lisp_stream_t underlying;
     lisp_object_t object = lisp_object_allocate(lisp_tag_stream, sizeof(struct lisp_stream), (void **)&underlying);
     underlying->functions = functions;
     underlying->flags = 0;
+    underlying->pushback_count = 0;
     return object;
 }
 
@@ -43,6 +63,10 @@ lisp_stream_functions_t lisp_stream_get_functions(lisp_object_t object)
 
 lisp_object_t lisp_stream_open(lisp_object_t stream, lisp_object_t readable, lisp_object_t writable)
 {
+    if (lisp_heap_sharedp(stream)) {
+        return lisp_NIL;
+    }
+
     lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
     lisp_object_t result = functions->open(stream, readable, writable);
 
@@ -61,6 +85,10 @@ lisp_object_t lisp_stream_open(lisp_object_t stream, lisp_object_t readable, lis
 
 lisp_object_t lisp_stream_close(lisp_object_t stream)
 {
+    if (lisp_heap_sharedp(stream)) {
+        return lisp_NIL;
+    }
+
     lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
     lisp_object_t result = functions->close(stream);
 
@@ -70,35 +98,155 @@ lisp_object_t lisp_stream_close(lisp_object_t stream)
     flags = flags & ~lisp_stream_flags_readable;
     flags = flags & ~lisp_stream_flags_writable;
     stream_value->flags = flags;
+    stream_value->pushback_count = 0;
 
     return result;
 }
 
 lisp_object_t lisp_stream_read_char(lisp_object_t stream)
 {
+    if (lisp_heap_sharedp(stream)) {
+        return lisp_NIL;
+    }
+
+    /* Anything that was unread is read again first. */
+    lisp_stream_t stream_value = lisp_stream_get_value(stream);
+    if (stream_value->pushback_count > 0) {
+        stream_value->pushback_count -= 1;
+        return stream_value->pushback[stream_value->pushback_count];
+    }
+
     lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
     return functions->read_char(stream);
 }
 
 lisp_object_t lisp_stream_unread_char(lisp_object_t stream, lisp_object_t character)
 {
-    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
-    return functions->unread_char(stream, character);
+    /* Unreading end-of-stream is a no-op. */
+    if ((character == lisp_NIL) || lisp_heap_sharedp(stream)) {
+        return lisp_NIL;
+    }
+
+    lisp_stream_t stream_value = lisp_stream_get_value(stream);
+    if (stream_value->pushback_count == LISP_STREAM_PUSHBACK_SIZE) {
+        return lisp_NIL;
+    }
+
+    stream_value->pushback[stream_value->pushback_count] = character;
+    stream_value->pushback_count += 1;
+    return character;
 }
 
 lisp_object_t lisp_stream_peek_char(lisp_object_t stream)
 {
-    lisp_object_t character = lisp_stream_read_char(stream);
+    if (lisp_heap_sharedp(stream)) {
+        return lisp_NIL;
+    }
+
+    lisp_stream_t stream_value = lisp_stream_get_value(stream);
+    if (stream_value->pushback_count > 0) {
+        return stream_value->pushback[stream_value->pushback_count - 1];
+    }
+
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    lisp_object_t character = functions->read_char(stream);
     lisp_stream_unread_char(stream, character);
     return character;
 }
 
+const unsigned char *lisp_stream_buffer(lisp_object_t stream, uintptr_t *length)
+{
+    /* Pushed-back characters must be read before anything buffered. */
+    lisp_stream_t stream_value = lisp_stream_get_value(stream);
+    if ((stream_value->pushback_count > 0) || lisp_heap_sharedp(stream)) {
+        return NULL;
+    }
+
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    if (functions->buffer == NULL) {
+        return NULL;
+    }
+
+    return functions->buffer(stream, length);
+}
+
+void lisp_stream_consume(lisp_object_t stream, uintptr_t count)
+{
+    if ((count > 0) && !lisp_heap_sharedp(stream)) {
+        lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+        functions->consume(stream, count);
+    }
+}
+
 lisp_object_t lisp_stream_write_char(lisp_object_t stream, lisp_object_t value)
 {
+    if (lisp_heap_sharedp(stream)) {
+        return lisp_NIL;
+    }
+
     lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
     return functions->write_char(stream, value);
 }
 
+uintptr_t lisp_stream_read_bytes(lisp_object_t stream, unsigned char *bytes, uintptr_t length)
+{
+    uintptr_t count = 0;
+    while (count < length) {
+        uintptr_t available = 0;
+        const unsigned char *buffer = lisp_stream_buffer(stream, &available);
+        if ((buffer != NULL) && (available > 0)) {
+            uintptr_t n = length - count;
+            if (n > available) n = available;
+            memcpy(bytes + count, buffer, n);
+            lisp_stream_consume(stream, n);
+            count = count + n;
+            continue;
+        }
+
+        lisp_object_t ch = lisp_stream_read_char(stream);
+        if (ch == lisp_NIL) {
+            break;
+        }
+        bytes[count] = (unsigned char)lisp_char_get_value(ch);
+        count = count + 1;
+    }
+    return count;
+}
+
+uintptr_t lisp_stream_remaining(lisp_object_t stream)
+{
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    if (functions->remaining == NULL) {
+        return UINTPTR_MAX;
+    }
+
+    lisp_stream_t stream_value = lisp_stream_get_value(stream);
+    const uintptr_t remaining = functions->remaining(stream);
+    if (remaining > UINTPTR_MAX - stream_value->pushback_count) {
+        return UINTPTR_MAX;
+    }
+    return remaining + stream_value->pushback_count;
+}
+
+lisp_object_t lisp_stream_write_bytes(lisp_object_t stream, const unsigned char *bytes, uintptr_t length)
+{
+    if (lisp_heap_sharedp(stream)) {
+        return lisp_NIL;
+    }
+
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    if (functions->write_bytes != NULL) {
+        return functions->write_bytes(stream, bytes, length);
+    }
+
+    for (uintptr_t i = 0; i < length; i++) {
+        if (functions->write_char(stream, lisp_char_create((lisp_char_t)bytes[i])) == lisp_NIL) {
+            return lisp_NIL;
+        }
+    }
+    return stream;
+}
+
 lisp_object_t lisp_stream_write_string(lisp_object_t stream, lisp_object_t value)
 {
     lisp_string_t string_value = lisp_string_get_value(value);
@@ -107,7 +255,9 @@ lisp_object_t lisp_stream_write_string(lisp_object_t stream, lisp_object_t value
         lisp_interior_t chars_interior = lisp_interior_get_value(string_value->chars);
         lisp_object_t *chars = (lisp_object_t *)chars_interior;
         for (uintptr_t i = 0; i < length; i++) {
-            lisp_stream_write_char(stream, chars[i]);
+            if (lisp_stream_write_char(stream, chars[i]) == lisp_NIL) {
+                return lisp_NIL;
+            }
         }
     }
     return stream;
@@ -115,8 +265,18 @@ lisp_object_t lisp_stream_write_string(lisp_object_t stream, lisp_object_t value
 
 lisp_object_t lisp_stream_eofp(lisp_object_t stream)
 {
-    /* If the stream is already at EOF, just indicate that. */
+    /* A shared stream can't be read, so it's always at EOF. */
+    if (lisp_heap_sharedp(stream)) {
+        return lisp_T;
+    }
+
+    /* A stream with characters pushed back can't be at EOF. */
     lisp_stream_t stream_value = lisp_stream_get_value(stream);
+    if (stream_value->pushback_count > 0) {
+        return lisp_NIL;
+    }
+
+    /* If the stream is already at EOF, just indicate that. */
     if ((stream_value->flags & lisp_stream_flags_at_eof) != 0) {
         return lisp_T;
     }
@@ -172,17 +332,52 @@ lisp_object_t lisp_stream_equal(lisp_object_t a, lisp_object_t b)
 }
 
 
+void lisp_stream_initialize(void)
+{
+    lisp_stream_designator_environment = NULL;
+}
+
+
+/**
+ Get the stream a well-known stream symbol is bound to as seen from an
+ environment, using the cache if it's still valid.
+
+ The cache holds all three well-known streams for only the environment
+ they were last looked up in, since an environment that resolves one is
+ likely to resolve the others, and it's overwritten in place for any
+ other environment so it never grows.
+ */
+static lisp_object_t lisp_stream_designated(lisp_object_t environment,
+                                            lisp_stream_designated_t designated)
+{
+    const uintptr_t epoch = lisp_environment_stream_epoch();
+
+    if ((lisp_stream_designator_environment != environment) || (lisp_stream_designator_epoch != epoch)) {
+        lisp_stream_designator_streams[lisp_stream_designated_terminal_io]
+            = lisp_environment_get_symbol_value(environment, lisp_TERMINAL_IO, lisp_APVAL, lisp_T);
+        lisp_stream_designator_streams[lisp_stream_designated_standard_input]
+            = lisp_environment_get_symbol_value(environment, lisp_STANDARD_INPUT, lisp_APVAL, lisp_T);
+        lisp_stream_designator_streams[lisp_stream_designated_standard_output]
+            = lisp_environment_get_symbol_value(environment, lisp_STANDARD_OUTPUT, lisp_APVAL, lisp_T);
+        lisp_stream_designator_environment = environment;
+        lisp_stream_designator_epoch = epoch;
+    }
+
+    return lisp_stream_designator_streams[designated];
+}
+
+
 lisp_object_t lisp_stream_best_input_stream(lisp_object_t environment,
                                             lisp_object_t stream_designator)
 {
     lisp_object_t input_stream;
 
-    if (stream_designator == lisp_T) {
-        input_stream = lisp_environment_get_symbol_value(environment, lisp_TERMINAL_IO, lisp_APVAL, lisp_T);
-    } else if (stream_designator == lisp_NIL) {
-        input_stream = lisp_environment_get_symbol_value(environment, lisp_STANDARD_INPUT, lisp_APVAL, lisp_T);
-    } else if (lisp_streamp(stream_designator)) {
+    if (lisp_streamp(stream_designator) != lisp_NIL) {
         input_stream = stream_designator;
+    } else if (stream_designator == lisp_T) {
+        input_stream = lisp_stream_designated(environment, lisp_stream_designated_terminal_io);
+    } else if (stream_designator == lisp_NIL) {
+        input_stream = lisp_stream_designated(environment, lisp_stream_designated_standard_input);
     } else {
         input_stream = lisp_NIL;
     }
@@ -196,16 +391,15 @@ lisp_object_t lisp_stream_best_output_stream(lisp_object_t environment,
 {
     lisp_object_t output_stream;
 
-    if (stream_designator == lisp_T) {
-        output_stream = lisp_environment_get_symbol_value(environment, lisp_TERMINAL_IO, lisp_APVAL, lisp_T);
-    } else if (stream_designator == lisp_NIL) {
-        output_stream = lisp_environment_get_symbol_value(environment, lisp_STANDARD_OUTPUT, lisp_APVAL, lisp_T);
-    } else if (lisp_streamp(stream_designator)) {
+    if (lisp_streamp(stream_designator) != lisp_NIL) {
         output_stream = stream_designator;
+    } else if (stream_designator == lisp_T) {
+        output_stream = lisp_stream_designated(environment, lisp_stream_designated_terminal_io);
+    } else if (stream_designator == lisp_NIL) {
+        output_stream = lisp_stream_designated(environment, lisp_stream_designated_standard_output);
     } else {
         output_stream = lisp_NIL;
     }
 
     return output_stream;
 }
-
@@ -41,13 +41,6 @@ typedef struct lisp_stream_functions {
     */
     lisp_object_t (*read_char)(lisp_object_t stream);
 
-    /**
-     A function to "unread" a character from the stream.
-
-     - Returns: The character "unread."
-    */
-    lisp_object_t (*unread_char)(lisp_object_t stream, lisp_object_t ch);
-
     /**
      A function to write a character to the stream.
 
@@ -62,6 +55,37 @@ typedef struct lisp_stream_functions {
     */
     lisp_object_t (*eofp)(lisp_object_t stream);
 
+    /**
+     An optional function to get direct access to the bytes the stream
+     has buffered for reading, refilling its buffer first if it's empty.
+     May be `NULL` if the stream doesn't read from a byte buffer.
+
+     - Parameters:
+       - length: Set to the number of bytes available.
+     - Returns: A pointer to the next byte to read, or `NULL` at end.
+    */
+    const unsigned char *(*buffer)(lisp_object_t stream, uintptr_t *length);
+
+    /**
+     An optional function to consume bytes obtained from `buffer`, as if
+     they had been read. May be `NULL` if `buffer` is `NULL`.
+    */
+    void (*consume)(lisp_object_t stream, uintptr_t count);
+
+    /**
+     An optional function to write a run of bytes to the stream at once.
+     May be `NULL`, in which case each byte is written with `write_char`.
+
+     - Returns: The stream itself.
+    */
+    lisp_object_t (*write_bytes)(lisp_object_t stream, const unsigned char *bytes, uintptr_t length);
+
+    /**
+     An optional function to get the number of bytes left to read from
+     the stream. May be `NULL` if the stream can't know that in advance.
+    */
+    uintptr_t (*remaining)(lisp_object_t stream);
+
 } *lisp_stream_functions_t;
 
 
@@ -80,12 +104,25 @@ typedef enum lisp_stream_flags {
 } lisp_stream_flags_t;
 
 
+/** The number of characters that can be "unread" onto a stream. */
+#define LISP_STREAM_PUSHBACK_SIZE 8
+
+
 /**
  A Lisp stream.
 
  A _stream_ may be either opened or closed, and may be opened for
  reading, for writing, or both. Only sequential read/write and "unread"
  operations are supported on streams at this time.
+
+ Characters that are "unread" are kept by the stream itself rather than
+ passed back to its underlying functions, so every kind of stream
+ supports the same amount of pushback and peeking never requires more
+ than one call to the underlying functions.
+
+ Reading or writing a stream changes it, so a stream shared from a
+ frozen virtual machine can't be opened, closed, read, or written; it's
+ always at end, and writing to it fails.
  */
 typedef struct lisp_stream {
     /**
@@ -96,6 +133,15 @@ typedef struct lisp_stream {
 
     /** Flags describing the stream. */
     lisp_stream_flags_t flags;
+
+    /** The number of characters in the pushback buffer. */
+    uintptr_t pushback_count;
+
+    /**
+     Characters that have been "unread," which are read again in the
+     reverse of the order in which they were unread.
+     */
+    lisp_object_t pushback[LISP_STREAM_PUSHBACK_SIZE];
 } *lisp_stream_t;
 
 
@@ -120,16 +166,69 @@ LISP_EXTERN lisp_object_t lisp_stream_close(lisp_object_t stream);
 /** Read one character from the given stream. */
 LISP_EXTERN lisp_object_t lisp_stream_read_char(lisp_object_t stream);
 
-/** Put a character back on the stream. */
+/**
+ Put a character back on the stream, so it will be the next character
+ read. Up to `LISP_STREAM_PUSHBACK_SIZE` characters may be put back.
+
+ - Returns: The character, or `NIL` if there is no room to put it back.
+ */
 LISP_EXTERN lisp_object_t lisp_stream_unread_char(lisp_object_t stream, lisp_object_t character);
 
 /** Peek a character from the stream. */
 LISP_EXTERN lisp_object_t lisp_stream_peek_char(lisp_object_t stream);
 
-/** Write one character to the given stream. */
+/**
+ Get direct access to the bytes buffered for reading from the stream,
+ for tokenizing input in bulk rather than a character at a time.
+
+ - Parameters:
+   - stream: The stream to read from.
+   - length: Set to the number of bytes available.
+ - Returns: A pointer to the next byte to read, or `NULL` if the stream
+            doesn't support buffered access, has characters pushed back
+            that must be read first, or is at end.
+ - Warning: Bytes are only read once passed to `lisp_stream_consume`.
+            The pointer is only valid until the stream is next used.
+ */
+LISP_EXTERN const unsigned char *lisp_stream_buffer(lisp_object_t stream, uintptr_t *length);
+
+/**
+ Consume bytes obtained from `lisp_stream_buffer` as if they had been
+ read from the stream one character at a time.
+ */
+LISP_EXTERN void lisp_stream_consume(lisp_object_t stream, uintptr_t count);
+
+/**
+ Read a run of bytes from the given stream, each from one character,
+ copying them directly from the stream's buffer if it has one.
+
+ - Returns: The number of bytes read, which is less than the number
+            requested only at end-of-stream.
+ */
+LISP_EXTERN uintptr_t lisp_stream_read_bytes(lisp_object_t stream, unsigned char *bytes, uintptr_t length);
+
+/**
+ Get the most bytes that can still be read from the given stream, so a
+ reader can reject a length no stream of that size could hold before
+ allocating anything for it.
+
+ - Returns: The number of bytes left, including any characters pushed
+            back, or `UINTPTR_MAX` if the stream can't know that.
+ */
+LISP_EXTERN uintptr_t lisp_stream_remaining(lisp_object_t stream);
+
+/** Write one character to the given stream, returning `NIL` if it can't be written. */
 LISP_EXTERN lisp_object_t lisp_stream_write_char(lisp_object_t stream, lisp_object_t value);
 
-/** Write an entire string to the given stream. */
+/**
+ Write a run of bytes to the given stream, each as one character, in a
+ single call to the stream if it supports that. This lets callers that
+ produce text in a C buffer, like the printer, avoid creating a Lisp
+ character or string for it.
+ */
+LISP_EXTERN lisp_object_t lisp_stream_write_bytes(lisp_object_t stream, const unsigned char *bytes, uintptr_t length);
+
+/** Write an entire string to the given stream, returning `NIL` if it can't all be written. */
 LISP_EXTERN lisp_object_t lisp_stream_write_string(lisp_object_t stream, lisp_object_t value);
 
 /** Check whether the stream has hit EOF. */
@@ -152,27 +251,44 @@ LISP_EXTERN lisp_object_t lisp_stream_print(lisp_object_t stream, lisp_stream_t
 LISP_EXTERN lisp_object_t lisp_stream_equal(lisp_object_t a, lisp_object_t b);
 
 
+/**
+ Initialize the cache of the streams that stream designators resolve to.
+
+ This happens when the built-in streams are added to a new root
+ environment, since the cached streams are allocated on the heap the
+ root environment is created in.
+ */
+LISP_EXTERN void lisp_stream_initialize(void);
+
 /**
  Determine the best input stream given a stream designator (which may
  itself be a stream).
 
+ The streams that `T` and `NIL` designate are cached for the last
+ environment they were resolved in, until it's another environment or
+ any environment changes the binding of `*TERMINAL-IO*`,
+ `*STANDARD-INPUT*`, or `*STANDARD-OUTPUT*`.
+
  - Returns: `*TERMINAL-IO*` if the designator is `T`, `*STANDARD-INPUT*`
             if the designator is `NIL`, the passed stream if a stream is
             passed, and `NIL` otherwise.
  */
-lisp_object_t lisp_stream_best_input_stream(lisp_object_t environment,
-                                            lisp_object_t stream_designator);
+LISP_EXTERN lisp_object_t lisp_stream_best_input_stream(lisp_object_t environment,
+                                                        lisp_object_t stream_designator);
 
 /**
- Determine the best input stream given a stream designator (which may
+ Determine the best output stream given a stream designator (which may
  itself be a stream).
 
+ The streams that `T` and `NIL` designate are cached as for
+ `lisp_stream_best_input_stream`.
+
  - Returns: `*TERMINAL-IO*` if the designator is `T`,
             `*STANDARD-OUTPUT*` if the designator is `NIL`, the passed
             stream if a stream is passed, and `NIL` otherwise.
  */
-lisp_object_t lisp_stream_best_output_stream(lisp_object_t environment,
-                                             lisp_object_t stream_designator);
+LISP_EXTERN lisp_object_t lisp_stream_best_output_stream(lisp_object_t environment,
+                                                         lisp_object_t stream_designator);
 
 
 #endif  /* __lisp_stream__ */
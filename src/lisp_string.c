@@ -55,10 +55,8 @@ lisp_char_t lisp_char_get_value(lisp_object_t object)
 lisp_object_t lisp_char_print_quoted(lisp_object_t stream, lisp_char_t char_value, lisp_object_t should_quote)
 {
     if (should_quote != lisp_NIL) {
-        const lisp_object_t octothorpe  = lisp_char_create(char_octothorpe);
-        const lisp_object_t backslash   = lisp_char_create(char_backslash);
-        lisp_stream_write_char(stream, octothorpe);
-        lisp_stream_write_char(stream, backslash);
+        const unsigned char prefix[2] = { char_octothorpe, char_backslash };
+        lisp_stream_write_bytes(stream, prefix, 2);
     }
 
     lisp_object_t object = lisp_char_create(char_value);
@@ -109,13 +107,17 @@ lisp_object_t lisp_string_create(lisp_object_t chars,
 
 lisp_object_t lisp_string_create_c(const char *cstring)
 {
-    const uintptr_t length = (uintptr_t) strlen(cstring);
+    return lisp_string_create_bytes(cstring, (uintptr_t) strlen(cstring));
+}
+
+lisp_object_t lisp_string_create_bytes(const char *bytes, uintptr_t length)
+{
     uintptr_t capacity = lisp_round_to_next_multiple(length, 16);
     lisp_object_t *chars_buffer;
     lisp_object_t chars = lisp_interior_create(sizeof(lisp_object_t) * capacity, (void **)&chars_buffer);
 
     for (uintptr_t i = 0; i < length; i++) {
-        char ch = cstring[i];
+        char ch = bytes[i];
         lisp_char_t lisp_ch = (lisp_char_t) ch;
         chars_buffer[i] = lisp_char_create(lisp_ch);
     }
@@ -137,25 +139,116 @@ lisp_string_t lisp_string_get_value(lisp_object_t object)
     return (lisp_string_t)ptr_value;
 }
 
+uintptr_t lisp_string_get_c(lisp_object_t string, char *buffer, uintptr_t size)
+{
+    lisp_string_t string_value = lisp_string_get_value(string);
+    lisp_object_t *chars = (lisp_object_t *)lisp_interior_get_value(string_value->chars);
+
+    uintptr_t length = string_value->length;
+    if (length > (size - 1)) {
+        length = size - 1;
+    }
+
+    for (uintptr_t i = 0; i < length; i++) {
+        buffer[i] = (char)lisp_char_get_value(chars[i]);
+    }
+    buffer[length] = '\0';
+
+    return length;
+}
+
 lisp_object_t lisp_string_print(lisp_object_t stream, lisp_string_t string_value)
 {
     return lisp_string_print_quoted(stream, string_value, lisp_NIL);
 }
 
+/** The number of characters of a string printed at once. */
+#define LISP_STRING_PRINT_CHUNK_SIZE 256
+
+/**
+ Write bytes from a string, preceding each double-quote and backslash
+ with a backslash so it can be read back.
+
+ The bytes are searched for characters that need escaping with `memchr`,
+ and everything between them is written in a single run.
+ */
+static void lisp_string_write_escaped(lisp_object_t stream, const unsigned char *bytes, uintptr_t length)
+{
+    const unsigned char backslash = char_backslash;
+    const unsigned char *p = bytes;
+    const unsigned char *end = bytes + length;
+    const unsigned char *next_quote = memchr(p, char_double_quote, length);
+    const unsigned char *next_backslash = memchr(p, char_backslash, length);
+
+    for (;;) {
+        const unsigned char *special = end;
+        if ((next_quote != NULL) && (next_quote < special)) special = next_quote;
+        if ((next_backslash != NULL) && (next_backslash < special)) special = next_backslash;
+
+        if (special > p) {
+            lisp_stream_write_bytes(stream, p, (uintptr_t)(special - p));
+        }
+        if (special == end) {
+            break;
+        }
+
+        /* Escape the character, which then starts the next run. */
+        lisp_stream_write_bytes(stream, &backslash, 1);
+        p = special;
+        if (special == next_quote) {
+            next_quote = memchr(special + 1, char_double_quote, (uintptr_t)(end - (special + 1)));
+        } else {
+            next_backslash = memchr(special + 1, char_backslash, (uintptr_t)(end - (special + 1)));
+        }
+    }
+}
+
 lisp_object_t lisp_string_print_quoted(lisp_object_t stream, lisp_string_t string_value, lisp_object_t should_quote)
 {
-    if (should_quote != lisp_NIL) lisp_char_print_quoted(stream, char_double_quote, lisp_NIL);
-    {
-        lisp_object_t chars_interior = string_value->chars;
-        lisp_object_t *chars = lisp_interior_get_value(chars_interior);
-        const uintptr_t length = string_value->length;
-        for (uintptr_t i = 0; i < length; i++) {
-            lisp_object_t ch_object = chars[i];
-            lisp_char_t ch = lisp_char_get_value(ch_object);
-            lisp_char_print_quoted(stream, ch, lisp_NIL);
+    const unsigned char double_quote = char_double_quote;
+    unsigned char bytes[LISP_STRING_PRINT_CHUNK_SIZE];
+
+    if (should_quote != lisp_NIL) lisp_stream_write_bytes(stream, &double_quote, 1);
+
+    lisp_object_t *chars = lisp_interior_get_value(string_value->chars);
+    const uintptr_t length = string_value->length;
+    for (uintptr_t start = 0; start < length; start += LISP_STRING_PRINT_CHUNK_SIZE) {
+        uintptr_t count = length - start;
+        if (count > LISP_STRING_PRINT_CHUNK_SIZE) {
+            count = LISP_STRING_PRINT_CHUNK_SIZE;
+        }
+
+        /*
+         Narrow a chunk of characters to bytes, noting whether any didn't
+         fit; this is a straight loop over the chunk so it vectorizes.
+         */
+        lisp_char_t wide = 0;
+        for (uintptr_t i = 0; i < count; i++) {
+            lisp_char_t ch = lisp_char_get_value(chars[start + i]);
+            bytes[i] = (unsigned char)ch;
+            wide = wide | (ch & ~((lisp_char_t) 0xFF));
+        }
+
+        if (wide != 0) {
+            /* Characters beyond a byte are written individually. */
+            for (uintptr_t i = 0; i < count; i++) {
+                lisp_char_t ch = lisp_char_get_value(chars[start + i]);
+                if (ch > 0xFF) {
+                    lisp_stream_write_char(stream, chars[start + i]);
+                } else if (should_quote != lisp_NIL) {
+                    lisp_string_write_escaped(stream, &bytes[i], 1);
+                } else {
+                    lisp_stream_write_bytes(stream, &bytes[i], 1);
+                }
+            }
+        } else if (should_quote != lisp_NIL) {
+            lisp_string_write_escaped(stream, bytes, count);
+        } else {
+            lisp_stream_write_bytes(stream, bytes, count);
         }
     }
-    if (should_quote != lisp_NIL) lisp_char_print_quoted(stream, char_double_quote, lisp_NIL);
+
+    if (should_quote != lisp_NIL) lisp_stream_write_bytes(stream, &double_quote, 1);
 
     return lisp_T;
 }
@@ -193,7 +286,12 @@ static void lisp_string_reallocate(lisp_string_t string_value)
 {
     const uintptr_t old_capacity = string_value->capacity;
     lisp_object_t *old_chars_buffer = (lisp_object_t *)lisp_interior_get_value(string_value->chars);
-    const uintptr_t new_capacity = old_capacity + 16;
+    /*
+     Grow by at least 16 characters, but geometrically once the string is
+     large so appending n characters is O(n) overall.
+     */
+    const uintptr_t growth = (old_capacity > 16) ? old_capacity : 16;
+    const uintptr_t new_capacity = old_capacity + growth;
     lisp_object_t *new_chars_buffer;
     lisp_object_t new_chars = lisp_interior_create(sizeof(lisp_object_t) * new_capacity, (void **)&new_chars_buffer);
     memcpy(new_chars_buffer, old_chars_buffer, sizeof(lisp_object_t) * old_capacity);
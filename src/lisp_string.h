@@ -95,12 +95,28 @@ LISP_EXTERN lisp_object_t lisp_string_create(lisp_object_t chars,
 /** Create a string given a C string. */
 LISP_EXTERN lisp_object_t lisp_string_create_c(const char *cstring);
 
+/** Create a string given a span of bytes, which need not be terminated. */
+LISP_EXTERN lisp_object_t lisp_string_create_bytes(const char *bytes, uintptr_t length);
+
 /** Create an empty string. */
 LISP_EXTERN lisp_object_t lisp_string_create_empty(void);
 
 /** Get the string value of the given Lisp object. */
 LISP_EXTERN lisp_string_t lisp_string_get_value(lisp_object_t object);
 
+/**
+ Copy a string into a C buffer, truncating each character to 8 bits.
+
+ - Parameters:
+   - string: The string to copy.
+   - buffer: The buffer to copy into, which is always `NUL`-terminated.
+   - size: The size of the buffer, including room for the terminator.
+ - Returns: The number of characters copied, excluding the terminator.
+ */
+LISP_EXTERN uintptr_t lisp_string_get_c(lisp_object_t string,
+                                        char *buffer,
+                                        uintptr_t size);
+
 /** Prints the string to the given output stream, with quoting. */
 LISP_EXTERN lisp_object_t lisp_string_print(lisp_object_t stream, lisp_string_t string_value);
 
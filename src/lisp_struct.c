@@ -13,6 +13,7 @@
 
 #if LISP_USE_STDLIB
 #include <stdio.h>
+#include <string.h>
 #endif
 
 
@@ -50,6 +51,16 @@ lisp_object_t lisp_struct_print(lisp_object_t environment,
 
 lisp_object_t lisp_struct_equal(lisp_object_t a, lisp_object_t b)
 {
-#warning lisp_struct_equal: Implement.
-    return lisp_NIL;
+    /* Structures are equal if they have the same type and contents. */
+    lisp_struct_t a_value = lisp_struct_get_value(a);
+    lisp_struct_t b_value = lisp_struct_get_value(b);
+    if ((a_value->type != b_value->type) || (a_value->size != b_value->size)) {
+        return lisp_NIL;
+    }
+    if ((a_value->value != b_value->value)
+        && (memcmp(a_value->value, b_value->value, a_value->size) != 0))
+    {
+        return lisp_NIL;
+    }
+    return lisp_T;
 }
@@ -13,13 +13,14 @@
 #include "lisp_string.h"
 
 
-lisp_object_t lisp_subr_create(lisp_callable function, lisp_object_t name)
+lisp_object_t lisp_subr_create(lisp_callable function, lisp_object_t name, lisp_object_t pure)
 {
     lisp_subr_t underlying;
     lisp_object_t object = lisp_object_allocate(lisp_tag_subr, sizeof(struct lisp_subr), (void **)&underlying);
 
     underlying->function = function;
     underlying->name = name;
+    underlying->pure = (pure != lisp_NIL) ? lisp_T : lisp_NIL;
 
     return object;
 }
@@ -32,6 +33,13 @@ lisp_subr_t lisp_subr_get_value(lisp_object_t object)
 }
 
 
+lisp_object_t lisp_subr_purep(lisp_object_t subr)
+{
+    lisp_subr_t subr_value = lisp_subr_get_value(subr);
+    return subr_value->pure;
+}
+
+
 lisp_object_t lisp_subr_print(lisp_object_t stream, lisp_subr_t subr_value)
 {
     /*
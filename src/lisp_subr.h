@@ -33,11 +33,21 @@ typedef lisp_object_t (*lisp_callable)(lisp_object_t environment, lisp_object_t
 typedef struct lisp_subr {
     lisp_callable function;
     lisp_object_t name;
+    lisp_object_t pure;
 } *lisp_subr_t;
 
 
-/** Create a Lisp `SUBR` object with the given function and name. */
-LISP_EXTERN lisp_object_t lisp_subr_create(lisp_callable function, lisp_object_t name);
+/**
+ Create a Lisp `SUBR` object with the given function and name.
+
+ A _pure_ `SUBR` has no side-effects and always produces an equal result
+ from equal arguments, so a call to it whose arguments are all constants
+ can be replaced by its result before it's ever evaluated.
+ */
+LISP_EXTERN lisp_object_t lisp_subr_create(lisp_callable function, lisp_object_t name, lisp_object_t pure);
+
+/** Indicate whether the `SUBR` is pure, `T` or `NIL`. */
+LISP_EXTERN lisp_object_t lisp_subr_purep(lisp_object_t subr);
 
 /** Gets the `SUBR` value of the given Lisp object.  */
 LISP_EXTERN lisp_subr_t lisp_subr_get_value(lisp_object_t object);
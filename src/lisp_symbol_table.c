@@ -0,0 +1,233 @@
+/*
+    File:       lisp_symbol_table.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include "lisp_symbol_table.h"
+
+#include "lisp_atom.h"
+#include "lisp_environment.h"
+#include "lisp_interior.h"
+#include "lisp_vm.h"
+
+#if LISP_USE_STDLIB
+#include <ctype.h>
+#include <string.h>
+#endif
+
+
+/**
+ An entry in the symbol table, which is empty if its atom is `NULL`.
+ The hash of the atom's name is kept so the table can grow without
+ rehashing every name.
+ */
+typedef struct lisp_symbol_table_entry {
+    uintptr_t hash;
+    lisp_object_t atom;
+} *lisp_symbol_table_entry_t;
+
+/** The initial number of entries in the table, a power of two. */
+#define LISP_SYMBOL_TABLE_INITIAL_CAPACITY 256
+
+/* The symbol table belongs to the current virtual machine. */
+#define lisp_symbol_table_entries (lisp_vm_current->symbol_table_entries)
+#define lisp_symbol_table_capacity (lisp_vm_current->symbol_table_capacity)
+#define lisp_symbol_table_entry_count (lisp_vm_current->symbol_table_entry_count)
+
+
+static lisp_symbol_table_entry_t lisp_symbol_table_allocate(uintptr_t capacity);
+static uintptr_t lisp_symbol_table_hash(const char *bytes, uintptr_t length);
+static lisp_symbol_table_entry_t lisp_symbol_table_probe(lisp_vm_t vm, const char *bytes, uintptr_t length, uintptr_t hash);
+static lisp_object_t lisp_symbol_table_find_shared(const char *bytes, uintptr_t length, uintptr_t hash);
+static void lisp_symbol_table_insert(lisp_symbol_table_entry_t entry, uintptr_t hash, lisp_object_t atom);
+static void lisp_symbol_table_grow(void);
+
+
+void lisp_symbol_table_initialize(void)
+{
+    lisp_symbol_table_entries = lisp_symbol_table_allocate(LISP_SYMBOL_TABLE_INITIAL_CAPACITY);
+    lisp_symbol_table_capacity = LISP_SYMBOL_TABLE_INITIAL_CAPACITY;
+    lisp_symbol_table_entry_count = 0;
+}
+
+
+lisp_object_t lisp_symbol_table_intern_bytes(const char *bytes, uintptr_t length)
+{
+    uintptr_t hash = lisp_symbol_table_hash(bytes, length);
+    lisp_symbol_table_entry_t entry = lisp_symbol_table_probe(lisp_vm_current, bytes, length, hash);
+    if (entry->atom != NULL) {
+        return entry->atom;
+    }
+
+    lisp_object_t shared_atom = lisp_symbol_table_find_shared(bytes, length, hash);
+    if (shared_atom != NULL) {
+        return shared_atom;
+    }
+
+    lisp_object_t atom = lisp_atom_create_bytes(bytes, length);
+    lisp_symbol_table_insert(entry, hash, atom);
+    return atom;
+}
+
+
+lisp_object_t lisp_symbol_table_intern(lisp_object_t atom)
+{
+    const char *name = lisp_atom_get_value(atom);
+    uintptr_t length = (uintptr_t) strlen(name);
+
+    uintptr_t hash = lisp_symbol_table_hash(name, length);
+    lisp_symbol_table_entry_t entry = lisp_symbol_table_probe(lisp_vm_current, name, length, hash);
+    if (entry->atom != NULL) {
+        return entry->atom;
+    }
+
+    lisp_object_t shared_atom = lisp_symbol_table_find_shared(name, length, hash);
+    if (shared_atom != NULL) {
+        return shared_atom;
+    }
+
+    lisp_symbol_table_insert(entry, hash, atom);
+    return atom;
+}
+
+
+lisp_object_t lisp_symbol_table_find_bytes(const char *bytes, uintptr_t length)
+{
+    uintptr_t hash = lisp_symbol_table_hash(bytes, length);
+    lisp_symbol_table_entry_t entry = lisp_symbol_table_probe(lisp_vm_current, bytes, length, hash);
+    if (entry->atom != NULL) {
+        return entry->atom;
+    }
+
+    lisp_object_t shared_atom = lisp_symbol_table_find_shared(bytes, length, hash);
+    if (shared_atom != NULL) {
+        return shared_atom;
+    } else {
+        return lisp_NIL;
+    }
+}
+
+
+uintptr_t lisp_symbol_table_count(void)
+{
+    return lisp_symbol_table_entry_count;
+}
+
+
+/* MARK: - Implementation */
+
+/**
+ Allocate an array of empty entries on the heap.
+ */
+lisp_symbol_table_entry_t lisp_symbol_table_allocate(uintptr_t capacity)
+{
+    lisp_symbol_table_entry_t entries;
+    const uintptr_t size = sizeof(struct lisp_symbol_table_entry) * capacity;
+    lisp_interior_create(size, (void **)&entries);
+    memset(entries, 0, size);
+    return entries;
+}
+
+/**
+ Hash a name, uppercasing it as atom creation does so that names that
+ differ only in case hash the same.
+
+ This is the 32-bit FNV-1a hash.
+ */
+uintptr_t lisp_symbol_table_hash(const char *bytes, uintptr_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (uintptr_t i = 0; i < length; i++) {
+        unsigned char ch = (unsigned char) toupper((unsigned char) bytes[i]);
+        hash = (hash ^ ch) * 16777619u;
+    }
+    return (uintptr_t) hash;
+}
+
+/**
+ Find the entry for a name in a virtual machine's table using linear
+ probing.
+
+ - Returns: The entry holding the name's atom, or the empty entry where
+            the name's atom would be inserted.
+ */
+lisp_symbol_table_entry_t lisp_symbol_table_probe(lisp_vm_t vm, const char *bytes, uintptr_t length, uintptr_t hash)
+{
+    const uintptr_t mask = vm->symbol_table_capacity - 1;
+    for (uintptr_t index = hash & mask; ; index = (index + 1) & mask) {
+        lisp_symbol_table_entry_t entry = &vm->symbol_table_entries[index];
+        if (entry->atom == NULL) {
+            return entry;
+        }
+        if (entry->hash != hash) {
+            continue;
+        }
+
+        /* Atom names are already uppercase, so only the name needs it. */
+        const char *name = lisp_atom_get_value(entry->atom);
+        uintptr_t i = 0;
+        while ((i < length) && (name[i] == (char) toupper((unsigned char) bytes[i]))) {
+            i = i + 1;
+        }
+        if ((i == length) && (name[length] == '\0')) {
+            return entry;
+        }
+    }
+}
+
+/**
+ Find the atom for a name in the tables of the frozen virtual machines
+ the current one shares, which never change, so they're only read.
+
+ - Returns: The atom for the name, or `NULL` if none of them has one.
+ */
+lisp_object_t lisp_symbol_table_find_shared(const char *bytes, uintptr_t length, uintptr_t hash)
+{
+    for (lisp_vm_t vm = lisp_vm_current->shared; vm != NULL; vm = vm->shared) {
+        lisp_symbol_table_entry_t entry = lisp_symbol_table_probe(vm, bytes, length, hash);
+        if (entry->atom != NULL) {
+            return entry->atom;
+        }
+    }
+    return NULL;
+}
+
+/**
+ Fill in an empty entry, growing the table if it's become too full.
+ */
+void lisp_symbol_table_insert(lisp_symbol_table_entry_t entry, uintptr_t hash, lisp_object_t atom)
+{
+    entry->hash = hash;
+    entry->atom = atom;
+    lisp_symbol_table_entry_count = lisp_symbol_table_entry_count + 1;
+
+    /* Keep the table at most three-quarters full so probes stay short. */
+    if ((lisp_symbol_table_entry_count * 4) >= (lisp_symbol_table_capacity * 3)) {
+        lisp_symbol_table_grow();
+    }
+}
+
+/**
+ Double the capacity of the table, moving every entry to its new slot.
+ */
+void lisp_symbol_table_grow(void)
+{
+    lisp_symbol_table_entry_t old_entries = lisp_symbol_table_entries;
+    const uintptr_t old_capacity = lisp_symbol_table_capacity;
+
+    lisp_symbol_table_capacity = old_capacity * 2;
+    lisp_symbol_table_entries = lisp_symbol_table_allocate(lisp_symbol_table_capacity);
+
+    const uintptr_t mask = lisp_symbol_table_capacity - 1;
+    for (uintptr_t i = 0; i < old_capacity; i++) {
+        if (old_entries[i].atom != NULL) {
+            uintptr_t index = old_entries[i].hash & mask;
+            while (lisp_symbol_table_entries[index].atom != NULL) {
+                index = (index + 1) & mask;
+            }
+            lisp_symbol_table_entries[index] = old_entries[i];
+        }
+    }
+}
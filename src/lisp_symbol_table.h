@@ -0,0 +1,72 @@
+/*
+    File:       lisp_symbol_table.h
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#ifndef __lisp_symbol_table__
+#define __lisp_symbol_table__ 1
+
+
+#include "lisp_types.h"
+
+
+/**
+ The symbol table.
+
+ The *symbol table* maps names to a single canonical atom for each name,
+ so that the reader can return the same atom every time it reads the
+ same name without binding anything in an environment. It's separate
+ from the environment so that reading a large amount of data doesn't
+ grow the property lists that every evaluation has to search.
+
+ The table is a hash table keyed by name, allocated on the Lisp heap.
+ Atoms used as keys in an environment are registered with it, so that
+ reading a name yields the atom the environment (and, for example, the
+ special form dispatcher) already uses for it.
+
+ A virtual machine that shares a frozen one looks names up in the frozen
+ one's table too, and only registers names that aren't already there.
+ */
+
+/**
+ Initialize an empty symbol table.
+
+ This happens when a root environment is created, since the table is
+ allocated on the heap the root environment is created in.
+ */
+LISP_EXTERN void lisp_symbol_table_initialize(void);
+
+/**
+ Get the canonical atom for the given name, creating and registering a
+ new atom if there isn't one. Names are case-insensitive, as with atom
+ creation.
+
+ - Parameters:
+   - bytes: The name, which need not be terminated.
+   - length: The number of bytes in the name.
+ - Returns: The canonical atom for the name.
+ */
+LISP_EXTERN lisp_object_t lisp_symbol_table_intern_bytes(const char *bytes, uintptr_t length);
+
+/**
+ Get the canonical atom for the given atom's name, registering the given
+ atom as canonical if there isn't one already.
+
+ - Returns: The canonical atom for the name.
+ */
+LISP_EXTERN lisp_object_t lisp_symbol_table_intern(lisp_object_t atom);
+
+/**
+ Find the canonical atom for the given name without creating one.
+
+ - Returns: The canonical atom for the name, or `NIL` if there is none.
+ */
+LISP_EXTERN lisp_object_t lisp_symbol_table_find_bytes(const char *bytes, uintptr_t length);
+
+/** Get the number of atoms registered in the symbol table. */
+LISP_EXTERN uintptr_t lisp_symbol_table_count(void);
+
+
+#endif  /* __lisp_symbol_table__ */
@@ -11,6 +11,7 @@
 #include "lisp_cell.h"
 #include "lisp_environment.h"
 #include "lisp_fixnum.h"
+#include "lisp_hash_table.h"
 #include "lisp_interior.h"
 #include "lisp_stream.h"
 #include "lisp_string.h"
@@ -18,6 +19,10 @@
 #include "lisp_subr.h"
 #include "lisp_vector.h"
 
+#if LISP_USE_STDLIB
+#include <string.h>
+#endif
+
 
 /* The mask to get a tag. */
 #define LISP_TAG_MASK   ((uintptr_t) 0xF)
@@ -94,6 +99,11 @@ lisp_object_t lisp_subrp(lisp_object_t object)
     return lisp_object_has_tag(object, lisp_tag_subr);
 }
 
+lisp_object_t lisp_hash_tablep(lisp_object_t object)
+{
+    return lisp_object_has_tag(object, lisp_tag_hash_table);
+}
+
 lisp_object_t lisp_interiorp(lisp_object_t object)
 {
     return lisp_object_has_tag(object, lisp_tag_interior);
@@ -109,6 +119,195 @@ lisp_object_t lisp_eq(lisp_object_t a, lisp_object_t b)
     }
 }
 
+/* MARK: - Structural Equality */
+
+/** The number of pairs the comparison stack holds before it must grow. */
+#define LISP_EQUAL_STACK_INITIAL_CAPACITY 64
+
+/**
+ The number of nested pairs compared before the comparison starts
+ remembering them, so that it stops on structure that's circular
+ through its CARs or vector elements.
+ */
+#define LISP_EQUAL_CIRCULARITY_THRESHOLD 1024
+
+/** A pair of cells or vectors, with the same tag, still to compare. */
+typedef struct lisp_equal_pair {
+    lisp_object_t a;
+    lisp_object_t b;
+} *lisp_equal_pair_t;
+
+/**
+ The state of comparing two structures.
+
+ The stack starts out in a C array and only moves to the heap if there
+ are too many nested structures pending at once. Once enough pairs have
+ been pushed, every pair pushed is also remembered in an `EQ` hash table
+ mapping each object to the list of objects it's been paired with, and
+ a pair already seen isn't pushed again.
+ */
+typedef struct lisp_equal_state {
+    lisp_equal_pair_t pairs;
+    uintptr_t count;
+    uintptr_t capacity;
+    uintptr_t pushed;
+    lisp_object_t seen;
+} *lisp_equal_state_t;
+
+
+/** Push a pair to compare, unless it's already been seen. */
+static void lisp_equal_push(lisp_equal_state_t state, lisp_object_t a, lisp_object_t b)
+{
+    state->pushed = state->pushed + 1;
+    if (state->pushed > LISP_EQUAL_CIRCULARITY_THRESHOLD) {
+        if (state->seen == lisp_NIL) {
+            state->seen = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+        }
+        lisp_object_t partners = lisp_hash_table_get(state->seen, a, lisp_NIL);
+        for (lisp_object_t p = partners; p != lisp_NIL; p = lisp_cell_cdr(p)) {
+            if (lisp_cell_car(p) == b) return;
+        }
+        lisp_hash_table_put(state->seen, a, lisp_cell_cons(b, partners));
+    }
+
+    if (state->count == state->capacity) {
+        lisp_equal_pair_t pairs;
+        const uintptr_t capacity = state->capacity * 2;
+        lisp_interior_create(sizeof(struct lisp_equal_pair) * capacity, (void **)&pairs);
+        memcpy(pairs, state->pairs, sizeof(struct lisp_equal_pair) * state->count);
+        state->pairs = pairs;
+        state->capacity = capacity;
+    }
+
+    state->pairs[state->count].a = a;
+    state->pairs[state->count].b = b;
+    state->count = state->count + 1;
+}
+
+/**
+ Compare two elements of structures, pushing them to compare later if
+ they're structures themselves.
+
+ - Returns: `NIL` if they're definitely not equal, otherwise `T`.
+ */
+static lisp_object_t lisp_equal_element(lisp_equal_state_t state, lisp_object_t a, lisp_object_t b)
+{
+    if (a == b) {
+        return lisp_T;
+    }
+
+    lisp_tag_t a_tag = lisp_object_get_tag(a);
+    if (a_tag != lisp_object_get_tag(b)) {
+        return lisp_NIL;
+    }
+
+    if ((a_tag == lisp_tag_cell) || (a_tag == lisp_tag_vector)) {
+        lisp_equal_push(state, a, b);
+        return lisp_T;
+    }
+
+    return lisp_equal(a, b);
+}
+
+/**
+ Compare two lists, walking their CDR chains together.
+
+ Brent's algorithm stops the walk if the pair of CDRs ever comes back
+ around to an earlier pair, in which case the lists are equal if the
+ walk found no difference before then.
+ */
+static lisp_object_t lisp_equal_list(lisp_equal_state_t state, lisp_object_t a, lisp_object_t b)
+{
+    lisp_object_t tortoise_a = a;
+    lisp_object_t tortoise_b = b;
+    uintptr_t power = 1;
+    uintptr_t steps = 0;
+
+    for (;;) {
+        lisp_cell_t a_value = lisp_cell_get_value(a);
+        lisp_cell_t b_value = lisp_cell_get_value(b);
+        if (lisp_equal_element(state, a_value->car, b_value->car) == lisp_NIL) {
+            return lisp_NIL;
+        }
+
+        a = a_value->cdr;
+        b = b_value->cdr;
+        if ((a == b) || (lisp_cellp(a) == lisp_NIL) || (lisp_cellp(b) == lisp_NIL)) {
+            return lisp_equal_element(state, a, b);
+        }
+
+        if ((a == tortoise_a) && (b == tortoise_b)) {
+            return lisp_T;
+        }
+        steps = steps + 1;
+        if (steps == power) {
+            tortoise_a = a;
+            tortoise_b = b;
+            power = power * 2;
+            steps = 0;
+        }
+    }
+}
+
+/** Compare two vectors, which must have equal lengths and elements. */
+static lisp_object_t lisp_equal_vector(lisp_equal_state_t state, lisp_object_t a, lisp_object_t b)
+{
+    lisp_vector_t a_value = lisp_vector_get_value(a);
+    lisp_vector_t b_value = lisp_vector_get_value(b);
+
+    /* Capacities aren't taken into account, and shared values are equal. */
+    if (a_value->count != b_value->count) {
+        return lisp_NIL;
+    }
+    if (a_value->values == b_value->values) {
+        return lisp_T;
+    }
+
+    for (uintptr_t i = 0; i < a_value->count; i++) {
+        if (lisp_equal_element(state, a_value->values[i], b_value->values[i]) == lisp_NIL) {
+            return lisp_NIL;
+        }
+    }
+
+    return lisp_T;
+}
+
+/**
+ Compare two cells or vectors with the same tag, using an explicit stack
+ of pairs still to compare rather than recursion, and returning as soon
+ as any difference is found.
+ */
+static lisp_object_t lisp_equal_structure(lisp_object_t a, lisp_object_t b)
+{
+    struct lisp_equal_pair initial_pairs[LISP_EQUAL_STACK_INITIAL_CAPACITY];
+    struct lisp_equal_state state;
+    state.pairs = initial_pairs;
+    state.count = 0;
+    state.capacity = LISP_EQUAL_STACK_INITIAL_CAPACITY;
+    state.pushed = 0;
+    state.seen = lisp_NIL;
+
+    lisp_equal_push(&state, a, b);
+    while (state.count > 0) {
+        state.count = state.count - 1;
+        lisp_object_t pair_a = state.pairs[state.count].a;
+        lisp_object_t pair_b = state.pairs[state.count].b;
+
+        lisp_object_t result;
+        if (lisp_cellp(pair_a) != lisp_NIL) {
+            result = lisp_equal_list(&state, pair_a, pair_b);
+        } else {
+            result = lisp_equal_vector(&state, pair_a, pair_b);
+        }
+        if (result == lisp_NIL) {
+            return lisp_NIL;
+        }
+    }
+
+    return lisp_T;
+}
+
+
 lisp_object_t lisp_equal(lisp_object_t a, lisp_object_t b)
 {
     /* Check whether they're EQ, for quick acceptance. */
@@ -129,7 +328,7 @@ lisp_object_t lisp_equal(lisp_object_t a, lisp_object_t b)
 
     switch (a_tag) {
         case lisp_tag_cell:
-            return lisp_cell_equal(a, b);
+            return lisp_equal_structure(a, b);
 
         case lisp_tag_atom:
             return lisp_atom_equal(a, b);
@@ -147,7 +346,7 @@ lisp_object_t lisp_equal(lisp_object_t a, lisp_object_t b)
             return lisp_struct_equal(a, b);
 
         case lisp_tag_vector:
-            return lisp_vector_equal(a, b);
+            return lisp_equal_structure(a, b);
 
         case lisp_tag_string:
             return lisp_string_equal(a, b);
@@ -157,6 +356,10 @@ lisp_object_t lisp_equal(lisp_object_t a, lisp_object_t b)
             return lisp_subr_equal(a, b);
             break;
 
+        case lisp_tag_hash_table:
+            return lisp_hash_table_equal(a, b);
+            break;
+
         case lisp_tag_interior:
             return lisp_interior_equal(a, b);
             break;
@@ -75,9 +75,13 @@ typedef enum lisp_tag {
      */
     lisp_tag_subr       = 0x8,
 
+    /**
+     A hash table, mapping keys to values.
+     */
+    lisp_tag_hash_table = 0x9,
+
     /** Reserved.  Commented out to avoid warnings. */
     /*
-    lisp_tag_reserved_9 = 0x9,
     lisp_tag_reserved_A = 0xA,
     lisp_tag_reserved_B = 0xB,
     lisp_tag_reserved_C = 0xC,
@@ -127,6 +131,9 @@ LISP_EXTERN lisp_object_t lisp_streamp(lisp_object_t object);
 /** Tests whether a Lisp object is a compiled or kernel function. */
 LISP_EXTERN lisp_object_t lisp_subrp(lisp_object_t object);
 
+/** Tests whether a Lisp object is a hash table. */
+LISP_EXTERN lisp_object_t lisp_hash_tablep(lisp_object_t object);
+
 /** Tests whether a Lisp object is an interior pointer. */
 LISP_EXTERN lisp_object_t lisp_interiorp(lisp_object_t object);
 
@@ -138,6 +145,11 @@ LISP_EXTERN lisp_object_t lisp_eq(lisp_object_t a, lisp_object_t b);
 
 /**
  Tests whether two objects are _equivalent_.
+
+ Lists and vectors are compared element by element using an explicit
+ stack, walking along `CDR` chains, so comparing long or deeply nested
+ structures doesn't use the C stack. Circular structures that can't be
+ told apart by walking them are equal.
  */
 LISP_EXTERN lisp_object_t lisp_equal(lisp_object_t a, lisp_object_t b);
 
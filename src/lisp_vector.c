@@ -7,62 +7,148 @@
 
 #include "lisp_vector.h"
 
+#include "lisp_cell.h"
 #include "lisp_environment.h"
+#include "lisp_interior.h"
+#include "lisp_memory.h"
 #include "lisp_printing.h"
 #include "lisp_string.h"
 
+#if LISP_USE_STDLIB
+#include <string.h>
+#endif
 
-lisp_vector_t lisp_vector_get_value(lisp_object_t object)
+
+/** The smallest capacity a vector is created with. */
+#define LISP_VECTOR_MINIMUM_CAPACITY 4
+
+
+/**
+ Allocate storage for the given number of values on the heap.
+
+ The values are kept in an interior pointer so they're contiguous and
+ can be indexed directly.
+ */
+static lisp_object_t *lisp_vector_allocate_values(uintptr_t capacity)
 {
-    uintptr_t raw_value = lisp_object_get_raw_value(object);
-    return (lisp_vector_t)raw_value;
+    lisp_object_t *values;
+    lisp_interior_create(sizeof(lisp_object_t) * capacity, (void **)&values);
+    return values;
 }
 
 
-lisp_object_t lisp_vector_print(lisp_object_t environment,
-                                lisp_object_t stream,
-                                lisp_vector_t vector_value)
+lisp_object_t lisp_vector_create(uintptr_t count,
+                                 lisp_object_t initial_value)
 {
-    lisp_char_print_quoted(stream, char_octothorpe, lisp_NIL);
-    lisp_char_print_quoted(stream, char_paren_open, lisp_NIL);
-    const uintptr_t c = vector_value->count;
-    for (uintptr_t i = 0; i < c; i++) {
-        lisp_print(environment, stream, vector_value->values[i]);
-        if ((i != 0) && (i == (c - 1))) {
-            lisp_char_print_quoted(stream, char_space, lisp_NIL);
-        }
+    uintptr_t capacity = count;
+    if (capacity < LISP_VECTOR_MINIMUM_CAPACITY) {
+        capacity = LISP_VECTOR_MINIMUM_CAPACITY;
+    }
+
+    lisp_vector_t vector;
+    lisp_object_t object = lisp_object_allocate(lisp_tag_vector, sizeof(struct lisp_vector), (void **)&vector);
+    vector->values = lisp_vector_allocate_values(capacity);
+    vector->capacity = capacity;
+    vector->count = count;
+
+    for (uintptr_t i = 0; i < count; i++) {
+        vector->values[i] = initial_value;
     }
-    lisp_char_print_quoted(stream, char_paren_close, lisp_NIL);
 
-    return lisp_T;
+    return object;
 }
 
 
-lisp_object_t lisp_vector_equal(lisp_object_t a, lisp_object_t b)
+lisp_object_t lisp_vector_create_from_list(lisp_object_t list)
 {
-    lisp_vector_t a_value = lisp_vector_get_value(a);
-    lisp_vector_t b_value = lisp_vector_get_value(b);
+    uintptr_t count = 0;
+    for (lisp_object_t iter = list; iter != lisp_NIL; iter = lisp_cell_cdr(iter)) {
+        count = count + 1;
+    }
+
+    lisp_object_t object = lisp_vector_create(count, lisp_NIL);
+    lisp_vector_t vector = lisp_vector_get_value(object);
+
+    uintptr_t i = 0;
+    for (lisp_object_t iter = list; iter != lisp_NIL; iter = lisp_cell_cdr(iter)) {
+        vector->values[i] = lisp_cell_car(iter);
+        i = i + 1;
+    }
+
+    return object;
+}
 
-    /*
-     For two vectors to be equal, they must have both equal lengths and
-     equal components. Their capacities are not taken into account.
-     */
 
-    if (a_value->count != b_value->count) {
+lisp_vector_t lisp_vector_get_value(lisp_object_t object)
+{
+    uintptr_t raw_value = lisp_object_get_raw_value(object);
+    return (lisp_vector_t)raw_value;
+}
+
+
+lisp_object_t lisp_vector_ref(lisp_object_t vector,
+                              uintptr_t index)
+{
+    lisp_vector_t vector_value = lisp_vector_get_value(vector);
+    if (index >= vector_value->count) {
         return lisp_NIL;
     }
 
-    /* If the vectors share value pointers, they're definitely equal. */
-    if (a_value->values == b_value->values) {
-        return lisp_T;
+    return vector_value->values[index];
+}
+
+
+lisp_object_t lisp_vector_set(lisp_object_t vector,
+                              uintptr_t index,
+                              lisp_object_t value)
+{
+    lisp_vector_t vector_value = lisp_vector_get_value(vector);
+    if (index >= vector_value->count) {
+        return lisp_NIL;
     }
 
-    /* Iterate over the contents and check each for equality. */
-    for (uintptr_t i = 0; i < a_value->count; i++) {
-        if (lisp_equal(a_value->values[i], b_value->values[i]) == lisp_NIL) {
-            return lisp_NIL;
-        }
+    vector_value->values[index] = value;
+    return value;
+}
+
+
+uintptr_t lisp_vector_push_extend(lisp_object_t vector,
+                                  lisp_object_t value)
+{
+    lisp_vector_t vector_value = lisp_vector_get_value(vector);
+
+    /* Double the storage when it's full. */
+    if (vector_value->count == vector_value->capacity) {
+        const uintptr_t new_capacity = vector_value->capacity * 2;
+        lisp_object_t *new_values = lisp_vector_allocate_values(new_capacity);
+        memcpy(new_values, vector_value->values, sizeof(lisp_object_t) * vector_value->count);
+        vector_value->values = new_values;
+        vector_value->capacity = new_capacity;
     }
 
-    return lisp_T;
+    const uintptr_t index = vector_value->count;
+    vector_value->values[index] = value;
+    vector_value->count = index + 1;
+
+    return index;
+}
+
+
+/**
+ Print a value in a vector, quoting strings and characters the same way
+ as they are within a list.
+ */
+lisp_object_t lisp_vector_print(lisp_object_t environment,
+                                lisp_object_t stream,
+                                lisp_vector_t vector_value)
+{
+    lisp_object_t vector = (lisp_object_t)((uintptr_t)vector_value | lisp_tag_vector);
+    return lisp_print_structure(environment, stream, vector, lisp_T);
+}
+
+
+lisp_object_t lisp_vector_equal(lisp_object_t a, lisp_object_t b)
+{
+    /* Structures are compared iteratively by EQUAL itself. */
+    return lisp_equal(a, b);
 }
@@ -34,9 +34,46 @@ typedef struct lisp_vector {
 } *lisp_vector_t;
 
 
+/**
+ Create a vector holding the given number of values, each of which is
+ the given initial value.
+ */
+LISP_EXTERN lisp_object_t lisp_vector_create(uintptr_t count,
+                                             lisp_object_t initial_value);
+
+/** Create a vector holding the values in the given list, in order. */
+LISP_EXTERN lisp_object_t lisp_vector_create_from_list(lisp_object_t list);
+
 /** Get the raw vector value of the given Lisp object. */
 LISP_EXTERN lisp_vector_t lisp_vector_get_value(lisp_object_t object);
 
+/**
+ Get the value at the given index in the vector.
+
+ - Returns: The value, or `NIL` if the index is out of range.
+ */
+LISP_EXTERN lisp_object_t lisp_vector_ref(lisp_object_t vector,
+                                          uintptr_t index);
+
+/**
+ Set the value at the given index in the vector.
+
+ - Returns: The value, or `NIL` if the index is out of range.
+ */
+LISP_EXTERN lisp_object_t lisp_vector_set(lisp_object_t vector,
+                                          uintptr_t index,
+                                          lisp_object_t value);
+
+/**
+ Add a value to the end of the vector, growing its storage if needed.
+
+ Storage grows geometrically, so adding n values takes O(n) time.
+
+ - Returns: The index of the added value.
+ */
+LISP_EXTERN uintptr_t lisp_vector_push_extend(lisp_object_t vector,
+                                              lisp_object_t value);
+
 /** Prints the vector to the given output stream. */
 LISP_EXTERN lisp_object_t lisp_vector_print(lisp_object_t environment,
                                             lisp_object_t stream,
@@ -0,0 +1,125 @@
+/*
+    File:       lisp_vm.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include "lisp_vm.h"
+
+#include "lisp_built_in_sforms.h"
+#include "lisp_environment.h"
+#include "lisp_memory.h"
+
+#include <stddef.h>
+
+#if LISP_USE_STDLIB
+#include <stdlib.h>
+#endif
+
+
+LISP_THREAD_LOCAL lisp_vm_t lisp_vm_current = NULL;
+
+#if !LISP_USE_STDLIB
+/**
+ Without the C library there's nothing to allocate a virtual machine
+ from, so there's only this one, which is in use until it's disposed of.
+ */
+static struct lisp_vm lisp_vm_only;
+static int lisp_vm_only_in_use = 0;
+#endif
+
+
+lisp_vm_t lisp_vm_create(uintptr_t heap_size)
+{
+    return lisp_vm_create_sharing(heap_size, NULL);
+}
+
+
+lisp_vm_t lisp_vm_create_sharing(uintptr_t heap_size, lisp_vm_t shared)
+{
+#if LISP_USE_STDLIB
+    lisp_vm_t vm = calloc(1, sizeof(struct lisp_vm));
+    if (vm == NULL) {
+        return NULL;
+    }
+#else
+    if (lisp_vm_only_in_use) {
+        return NULL;
+    }
+    lisp_vm_only_in_use = 1;
+    lisp_vm_t vm = &lisp_vm_only;
+    lisp_vm_only = (struct lisp_vm){ 0 };
+#endif
+    vm->shared = shared;
+
+    /*
+     Everything the heap and the root environment set up goes into the
+     current virtual machine, so the new one has to be current first.
+     */
+    lisp_vm_t previous = lisp_vm_set_current(vm);
+    if (!lisp_heap_initialize(heap_size)) {
+        lisp_vm_set_current(previous);
+#if LISP_USE_STDLIB
+        free(vm);
+#else
+        lisp_vm_only_in_use = 0;
+#endif
+        return NULL;
+    }
+    vm->environment = lisp_environment_create_root();
+
+    return vm;
+}
+
+
+void lisp_vm_freeze(lisp_vm_t vm)
+{
+    lisp_vm_t previous = lisp_vm_set_current(vm);
+
+    /* A stream can't be closed once its heap is frozen, so close them now. */
+    lisp_eval_unwind(lisp_NIL);
+    lisp_heap_freeze();
+    lisp_vm_set_current((previous == vm) ? NULL : previous);
+}
+
+
+void lisp_vm_dispose(lisp_vm_t vm)
+{
+    lisp_vm_t previous = lisp_vm_set_current(vm);
+
+    /* Files left open by WITH-OPEN-FILE are closed along with the heap. */
+    lisp_eval_unwind(lisp_NIL);
+    lisp_environment_dispose(vm->environment);
+    lisp_heap_finalize();
+
+#if LISP_USE_STDLIB
+    free(vm);
+#else
+    lisp_vm_only_in_use = 0;
+#endif
+
+    lisp_vm_set_current((previous == vm) ? NULL : previous);
+}
+
+
+lisp_vm_t lisp_vm_set_current(lisp_vm_t vm)
+{
+    lisp_vm_t previous = lisp_vm_current;
+    lisp_vm_current = vm;
+    return previous;
+}
+
+
+#if LISP_USE_STDLIB
+void lisp_vm_set_out_of_memory(lisp_vm_t vm, jmp_buf *out_of_memory)
+{
+    vm->out_of_memory = out_of_memory;
+}
+#endif
+
+
+lisp_object_t lisp_vm_get_environment(lisp_vm_t vm)
+{
+    return vm->environment;
+}
@@ -0,0 +1,215 @@
+/*
+    File:       lisp_vm.h
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#ifndef __lisp_vm__
+#define __lisp_vm__ 1
+
+
+#include "lisp_types.h"
+
+#if LISP_USE_STDLIB
+#include <setjmp.h>
+#endif
+
+
+/**
+ Virtual machines.
+
+ A *virtual machine* is one independent Lisp interpreter: its heap, its
+ symbol table, its environments, and everything that caches what's in
+ them. A process can host any number of them, such as one per worker
+ thread. Nothing allocated in one may be used in another; only the
+ static root environment and the atoms it binds are shared by all of
+ them, and those can't change.
+
+ A virtual machine can also be *frozen*, after which nothing in it can
+ change, and then *shared* by any number of others in any thread. A
+ virtual machine sharing a frozen one sees its bindings and atoms, with
+ no copying, as if its environment were the frozen one's child; setting
+ something bound there binds it anew instead, and removing it fails.
+ Changing an object in it, such as with `RPLACA`, `PUTHASH`, or by
+ writing to a stream, fails too.
+ This lets many workers refer to one copy of a large library or data
+ set, such as everything a file defines when it's loaded.
+
+ Lisp always runs in the calling thread's *current* virtual machine,
+ which is where everything it allocates or interns comes from. A
+ virtual machine may be current in only one thread at a time.
+ */
+typedef struct lisp_vm *lisp_vm_t;
+
+/**
+ The state of a virtual machine.
+
+ Each module that keeps state refers to its own part of the current
+ virtual machine's state through a macro, so the code using it reads
+ just as it would for a process with a single interpreter.
+ */
+struct lisp_vm {
+    /* MARK: Heap */
+
+    /** The raw heap is the actual C allocation, in case it needs to be adjusted for Lisp. */
+    void *raw_heap;
+
+    /** The Lisp heap is where all Lisp allocations come from, keep track of where it starts. */
+    void *heap_start;
+
+    /** The size of the Lisp heap. */
+    uintptr_t heap_size;
+
+    /** Keep track of the current point in the Lisp heap, so we know where the next allocation comes from. */
+    void *heap_cur;
+
+    /** The part of a frozen heap protected from writes, if the system can protect memory. */
+    void *frozen_start;
+    uintptr_t frozen_size;
+
+#if LISP_USE_STDLIB
+    /** Where to jump when the heap runs out, or `NULL` to exit instead. */
+    jmp_buf *out_of_memory;
+#endif
+
+    /* MARK: Sharing */
+
+    /** The frozen virtual machine this one shares, or `NULL` if it shares none. */
+    struct lisp_vm *shared;
+
+    /* MARK: Symbol Table */
+
+    struct lisp_symbol_table_entry *symbol_table_entries;
+    uintptr_t symbol_table_capacity;
+    uintptr_t symbol_table_entry_count;
+
+    /* MARK: Environments */
+
+    /** The environment `lisp_environment_create_root` created for this virtual machine. */
+    lisp_object_t environment;
+
+    /** How many environments bind each symbol, keyed by name. */
+    lisp_object_t binding_counts;
+
+    /** Changes whenever the function a symbol names might change. */
+    uintptr_t function_epoch;
+
+    /** Changes whenever the stream a well-known stream symbol names might change. */
+    uintptr_t stream_epoch;
+
+    lisp_object_t TERMINAL_IO;
+    lisp_object_t STANDARD_INPUT;
+    lisp_object_t STANDARD_OUTPUT;
+
+    /* MARK: Evaluation */
+
+    /** The function each call site last called, keyed by the call's cell. */
+    lisp_object_t call_site_cache;
+
+    /** How each `LAMBDA` form `DEFUN` folded was folded, keyed by the form. */
+    lisp_object_t folded_lambdas;
+
+    /** The streams `WITH-OPEN-FILE` has open, innermost first. */
+    lisp_object_t open_streams;
+
+    lisp_object_t SI_TAGBODY_STACK;
+    lisp_object_t SI_TAGBODY_CURRENT;
+    lisp_object_t SI_TAGBODY_SEQEUENCE;
+    lisp_object_t SI_TAGBODY_MAPPING;
+    lisp_object_t SI_TAGBODY_NEXT;
+    lisp_object_t SI_TAGBODY_START;
+    lisp_object_t SI_TAGBODY_END;
+
+    /* MARK: Streams and Printing */
+
+    /** The environment stream designators were last resolved in, the stream epoch then, and the streams. */
+    lisp_object_t stream_designator_environment;
+    uintptr_t stream_designator_epoch;
+    lisp_object_t stream_designator_streams[3];
+
+    lisp_object_t PRINT_CIRCLE;
+    lisp_object_t PRINT_LENGTH;
+    lisp_object_t PRINT_LEVEL;
+};
+
+/**
+ The calling thread's current virtual machine, or `NULL` if it has none.
+ */
+LISP_EXTERN LISP_THREAD_LOCAL lisp_vm_t lisp_vm_current;
+
+/**
+ Create a virtual machine, with its own heap and root environment, and
+ make it the calling thread's current virtual machine.
+
+ Without the C library, a process can have only one virtual machine at
+ a time, since there's nothing to allocate another from.
+
+ - Parameters:
+   - heap_size: The size of the new virtual machine's heap.
+ - Returns: The new virtual machine, or `NULL` if it can't be created.
+ */
+LISP_EXTERN lisp_vm_t lisp_vm_create(uintptr_t heap_size);
+
+/**
+ Create a virtual machine that shares a frozen one, and make it the
+ calling thread's current virtual machine. Its environment is a child of
+ the frozen virtual machine's, and reading a name interned there yields
+ the same atom.
+
+ - Parameters:
+   - heap_size: The size of the new virtual machine's heap.
+   - shared: The frozen virtual machine to share, which must not be
+             disposed of before the new one is.
+ - Returns: The new virtual machine, or `NULL` if it can't be created.
+ */
+LISP_EXTERN lisp_vm_t lisp_vm_create_sharing(uintptr_t heap_size, lisp_vm_t shared);
+
+/**
+ Freeze a virtual machine, so that it can be shared by any number of
+ others in any thread. Nothing more can be allocated in it, and where
+ the system supports it, its heap is protected from writes, so it must
+ not be current in any thread again; it can only be shared or disposed
+ of. If it's the calling thread's current virtual machine, the thread
+ no longer has one.
+ */
+LISP_EXTERN void lisp_vm_freeze(lisp_vm_t vm);
+
+/**
+ Dispose of a virtual machine, including its heap and so every object
+ allocated in it. If it's the calling thread's current virtual machine,
+ the thread no longer has one.
+ */
+LISP_EXTERN void lisp_vm_dispose(lisp_vm_t vm);
+
+/**
+ Make a virtual machine the calling thread's current one.
+
+ - Parameters:
+   - vm: The virtual machine to make current, or `NULL` for none.
+ - Returns: The virtual machine that was current before.
+ */
+LISP_EXTERN lisp_vm_t lisp_vm_set_current(lisp_vm_t vm);
+
+#if LISP_USE_STDLIB
+/**
+ Set where a virtual machine jumps, as by `longjmp`, when its heap runs
+ out, instead of exiting the process. Whatever was running when it ran
+ out can't be resumed, and the heap is full, so after the jump the
+ virtual machine can only be disposed of.
+
+ - Parameters:
+   - vm: The virtual machine.
+   - out_of_memory: Where to jump, or `NULL` to exit instead.
+ */
+LISP_EXTERN void lisp_vm_set_out_of_memory(lisp_vm_t vm, jmp_buf *out_of_memory);
+#endif
+
+/**
+ Get the environment created for a virtual machine, which is a child of
+ the static root environment that holds its well-known mutable symbols.
+ */
+LISP_EXTERN lisp_object_t lisp_vm_get_environment(lisp_vm_t vm);
+
+
+#endif  /* __lisp_vm__ */
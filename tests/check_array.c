@@ -0,0 +1,183 @@
+/*
+    File:       check_array.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include <check.h>
+
+#include "genericlisp.h"
+
+#include "tests_support.h"
+
+
+/* MARK: - Arrays */
+
+START_TEST(test_creation)
+{
+    lisp_object_t array = lisp_array_create(lisp_array_type_i32, 3);
+    ck_assert_int_eq(lisp_tag_struct, lisp_object_get_tag(array));
+    ck_assert_ptr_eq(lisp_T, lisp_arrayp(array));
+    ck_assert_int_eq(lisp_array_type_i32, lisp_array_get_type(array));
+    ck_assert_int_eq(3, lisp_array_count(array));
+
+    ck_assert_ptr_eq(lisp_fixnum_create(0), lisp_array_ref(array, 0));
+    ck_assert_ptr_eq(lisp_fixnum_create(0), lisp_array_ref(array, 2));
+    ck_assert_ptr_eq(lisp_NIL, lisp_array_ref(array, 3));
+
+    /* Other structs and vectors aren't arrays. */
+    ck_assert_ptr_eq(lisp_NIL, lisp_arrayp(lisp_struct_create(NULL, 0, 0)));
+    ck_assert_ptr_eq(lisp_NIL, lisp_arrayp(lisp_vector_create(1, lisp_NIL)));
+}
+END_TEST
+
+START_TEST(test_element_types)
+{
+    lisp_object_t u8 = lisp_array_create(lisp_array_type_u8, 1);
+    lisp_array_set(u8, 0, lisp_fixnum_create(257));
+    ck_assert_ptr_eq(lisp_fixnum_create(1), lisp_array_ref(u8, 0));
+
+    lisp_object_t i32 = lisp_array_create(lisp_array_type_i32, 1);
+    lisp_array_set(i32, 0, lisp_fixnum_create(-5));
+    ck_assert_ptr_eq(lisp_fixnum_create(-5), lisp_array_ref(i32, 0));
+
+    lisp_object_t i64 = lisp_array_create(lisp_array_type_i64, 1);
+    lisp_array_set(i64, 0, lisp_fixnum_create(100000));
+    ck_assert_ptr_eq(lisp_fixnum_create(100000), lisp_array_ref(i64, 0));
+
+    lisp_object_t f64 = lisp_array_create(lisp_array_type_f64, 1);
+    lisp_array_set(f64, 0, lisp_fixnum_create(-7));
+    ck_assert_ptr_eq(lisp_fixnum_create(-7), lisp_array_ref(f64, 0));
+
+    /* Setting out of range or to a non-fixnum does nothing. */
+    ck_assert_ptr_eq(lisp_NIL, lisp_array_set(i32, 1, lisp_fixnum_create(1)));
+    ck_assert_ptr_eq(lisp_NIL, lisp_array_set(i32, 0, lisp_T));
+    ck_assert_ptr_eq(lisp_fixnum_create(-5), lisp_array_ref(i32, 0));
+}
+END_TEST
+
+START_TEST(test_bulk_operations)
+{
+    lisp_object_t a = lisp_array_create(lisp_array_type_i64, 1000);
+    lisp_array_fill(a, 3);
+    ck_assert_int_eq(3000, lisp_array_sum(a));
+
+    lisp_object_t b = lisp_array_create(lisp_array_type_i64, 10);
+    for (uintptr_t i = 0; i < 10; i++) {
+        lisp_array_set(b, i, lisp_fixnum_create(i));
+    }
+    ck_assert_int_eq(45, lisp_array_sum(b));
+
+    /* Replacement copies as much as fits. */
+    ck_assert_int_eq(10, lisp_array_replace(a, b));
+    ck_assert_ptr_eq(lisp_fixnum_create(9), lisp_array_ref(a, 9));
+    ck_assert_ptr_eq(lisp_fixnum_create(3), lisp_array_ref(a, 10));
+    ck_assert_int_eq(10, lisp_array_replace(b, a));
+
+    /* Mapping produces an array as long as the shorter one. */
+    lisp_object_t sum = lisp_array_map(lisp_array_operation_add, a, b);
+    ck_assert_int_eq(10, lisp_array_count(sum));
+    ck_assert_ptr_eq(lisp_fixnum_create(18), lisp_array_ref(sum, 9));
+    lisp_object_t product = lisp_array_map(lisp_array_operation_multiply, b, b);
+    ck_assert_ptr_eq(lisp_fixnum_create(81), lisp_array_ref(product, 9));
+    lisp_object_t difference = lisp_array_map(lisp_array_operation_subtract, sum, product);
+    ck_assert_ptr_eq(lisp_fixnum_create(-63), lisp_array_ref(difference, 9));
+
+    /* Arrays of different types don't mix. */
+    lisp_object_t c = lisp_array_create(lisp_array_type_u8, 10);
+    ck_assert_int_eq(0, lisp_array_replace(a, c));
+    ck_assert_ptr_eq(lisp_NIL, lisp_array_map(lisp_array_operation_add, a, c));
+}
+END_TEST
+
+START_TEST(test_printing)
+{
+    lisp_object_t array = lisp_array_create(lisp_array_type_u8, 16);
+
+    lisp_print(tests_root_environment, tests_write_stream, array);
+    ck_assert_str_eq("#<ARRAY :U8 16>", tests_write_buffer);
+}
+END_TEST
+
+START_TEST(test_equality)
+{
+    lisp_object_t a = lisp_array_create(lisp_array_type_i32, 4);
+    lisp_object_t b = lisp_array_create(lisp_array_type_i32, 4);
+    lisp_object_t c = lisp_array_create(lisp_array_type_u8, 16);
+
+    ck_assert_ptr_eq(lisp_T, lisp_equal(a, b));
+    ck_assert_ptr_eq(lisp_NIL, lisp_equal(a, c));
+
+    lisp_array_set(b, 3, lisp_fixnum_create(1));
+    ck_assert_ptr_eq(lisp_NIL, lisp_equal(a, b));
+}
+END_TEST
+
+
+/* MARK: - Evaluation */
+
+START_TEST(test_evaluating_array_SUBRs)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer("(setq a (make-array 100 :i32 2))\n"
+                          "(aset a 0 10)\n"
+                          "(reduce + a)\n"
+                          "(setq b (map * a a))\n"
+                          "(aref b 0)\n"
+                          "(length (fill b 1))\n"
+                          "(reduce + (replace a b))\n"
+                          "(map + '(1 2 3) (vector 10 20))\n"
+                          "(reduce * (make-array 3 nil 2))\n");
+
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+
+    lisp_object_t sum = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(208), sum);
+
+    lisp_object_t product = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_T, lisp_arrayp(product));
+
+    lisp_object_t element = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(100), element);
+
+    lisp_object_t length = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(100), length);
+
+    lisp_object_t replaced_sum = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(100), replaced_sum);
+
+    lisp_object_t mapped = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_print(environment, tests_write_stream, mapped);
+    ck_assert_str_eq("(11 22)", tests_write_buffer);
+
+    lisp_object_t reduced = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(8), reduced);
+}
+END_TEST
+
+
+/* MARK: - Test Infrastructure */
+
+Suite *array_suite(void)
+{
+    Suite *s = suite_create("Array");
+
+    TCase *tc_arrays = tcase_create("Arrays");
+    tcase_add_checked_fixture(tc_arrays, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_arrays, test_creation);
+    tcase_add_test(tc_arrays, test_element_types);
+    tcase_add_test(tc_arrays, test_bulk_operations);
+    tcase_add_test(tc_arrays, test_printing);
+    tcase_add_test(tc_arrays, test_equality);
+    suite_add_tcase(s, tc_arrays);
+
+    TCase *tc_evaluation = tcase_create("Evaluation");
+    tcase_add_checked_fixture(tc_evaluation, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_evaluation, test_evaluating_array_SUBRs);
+    suite_add_tcase(s, tc_evaluation);
+
+    return s;
+}
@@ -40,6 +40,15 @@ START_TEST(test_atom_printing)
     lisp_char_print_quoted(tests_write_stream, Y_char_value, lisp_NIL);
 
     ck_assert_str_eq("XY", tests_write_buffer);
+    tests_clear_write_buffer();
+
+    /* Printing an atom doesn't allocate anything. */
+    lisp_object_t atom = lisp_atom_create_c("SYMBOL");
+    lisp_object_t before = lisp_cell_cons(lisp_NIL, lisp_NIL);
+    lisp_print(tests_root_environment, tests_write_stream, atom);
+    lisp_object_t after = lisp_cell_cons(lisp_NIL, lisp_NIL);
+    ck_assert_str_eq("SYMBOL", tests_write_buffer);
+    ck_assert_uint_eq(sizeof(struct lisp_cell), (uintptr_t)after - (uintptr_t)before);
 }
 END_TEST
 
@@ -0,0 +1,306 @@
+/*
+    File:       check_batch.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include <check.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "genericlisp.h"
+
+#include "tests_support.h"
+
+
+/* MARK: - Batches */
+
+/** Write text to a new temporary file, whose path is put in the given buffer. */
+static void check_batch_write_file(char *path, const char *text)
+{
+    strcpy(path, "/tmp/check_batch.XXXXXX");
+    int fd = mkstemp(path);
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq((ssize_t)strlen(text), write(fd, text, strlen(text)));
+    close(fd);
+}
+
+/** Read everything written to a temporary file into the given buffer. */
+static void check_batch_read_output(FILE *file, char *buffer, size_t size)
+{
+    rewind(file);
+    size_t length = fread(buffer, 1, size - 1, file);
+    buffer[length] = '\0';
+    fclose(file);
+}
+
+START_TEST(test_batch_files)
+{
+    char paths[4][32];
+    check_batch_write_file(paths[0], "(defun f (x) (* x x))\n(prin1 (f 1))\n");
+    check_batch_write_file(paths[1], "(defun f (x) (* x x x))\n(prin1 (f 2))\n");
+    check_batch_write_file(paths[2], "(prin1 (f 3))\n\n");
+    strcpy(paths[3], "/nonexistent/check_batch");
+    const char *path_list[] = { paths[0], paths[1], paths[2], paths[3], paths[0] };
+
+    /* Each file's output is in order, and no file sees another's functions. */
+    FILE *output = tmpfile();
+    FILE *errors = tmpfile();
+    ck_assert_uint_eq(1, lisp_batch_evaluate(lisp_batch_mode_files, path_list, 5, 3, 1048576, NULL, output, errors));
+    ck_assert_ptr_eq(tests_vm, lisp_vm_current);
+
+    char buffer[256];
+    check_batch_read_output(output, buffer, sizeof(buffer));
+    ck_assert_str_eq("18NIL1", buffer);
+    check_batch_read_output(errors, buffer, sizeof(buffer));
+    ck_assert_str_eq("/nonexistent/check_batch: can't be read\n", buffer);
+
+    for (int i = 0; i < 3; i++) {
+        unlink(paths[i]);
+    }
+}
+END_TEST
+
+START_TEST(test_batch_forms)
+{
+    char path[32];
+    check_batch_write_file(path, "(+ 1 2)\n(prin1 'a)\n(setq x 5)\nx\n(* 6 7)\n; The end.\n");
+    const char *path_list[] = { path };
+
+    /* Each form's output and value are in order, whatever worker evaluated it, and nothing follows the last. */
+    for (uintptr_t workers = 1; workers <= 4; workers++) {
+        FILE *output = tmpfile();
+        ck_assert_uint_eq(0, lisp_batch_evaluate(lisp_batch_mode_forms, path_list, 1, workers, 1048576, NULL, output, stderr));
+
+        char buffer[256];
+        check_batch_read_output(output, buffer, sizeof(buffer));
+        ck_assert_str_eq("3\nAA\n5\nNIL\n42\n", buffer);
+    }
+
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_batch_many_forms)
+{
+    /* More forms than one small heap could read, let alone evaluate. */
+    const int form_count = 5000;
+    static char text[5000 * 32];
+    static char expected[5000 * 16];
+    size_t text_length = 0;
+    size_t expected_length = 0;
+    for (int i = 0; i < form_count; i++) {
+        text_length += (size_t)snprintf(text + text_length, sizeof(text) - text_length, "(list %d 'form) ; %d\n", i, i);
+        expected_length += (size_t)snprintf(expected + expected_length, sizeof(expected) - expected_length, "(%d FORM)\n", i);
+    }
+    char path[32];
+    check_batch_write_file(path, text);
+    const char *path_list[] = { path };
+
+    FILE *output = tmpfile();
+    ck_assert_uint_eq(0, lisp_batch_evaluate(lisp_batch_mode_forms, path_list, 1, 2, 262144, NULL, output, stderr));
+
+    static char buffer[5000 * 16];
+    check_batch_read_output(output, buffer, sizeof(buffer));
+    ck_assert_uint_eq(expected_length, strlen(buffer));
+    ck_assert_int_eq(0, strcmp(expected, buffer));
+
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_batch_out_of_memory)
+{
+    char path[32];
+    check_batch_write_file(path, "(prin1 1)\n");
+    const char *path_list[] = { path };
+
+    /* A job whose virtual machine can't be created fails, and says why. */
+    FILE *output = tmpfile();
+    FILE *errors = tmpfile();
+    ck_assert_uint_eq(1, lisp_batch_evaluate(lisp_batch_mode_files, path_list, 1, 1, UINTPTR_MAX / 2, NULL, output, errors));
+    ck_assert_ptr_eq(tests_vm, lisp_vm_current);
+
+    char buffer[256];
+    check_batch_read_output(output, buffer, sizeof(buffer));
+    ck_assert_str_eq("", buffer);
+    check_batch_read_output(errors, buffer, sizeof(buffer));
+    char expected[64];
+    snprintf(expected, sizeof(expected), "%s: out of memory\n", path);
+    ck_assert_str_eq(expected, buffer);
+
+    /* So does a batch of forms whose forms can't be found. */
+    output = tmpfile();
+    errors = tmpfile();
+    ck_assert_uint_eq(1, lisp_batch_evaluate(lisp_batch_mode_forms, path_list, 1, 1, UINTPTR_MAX / 2, NULL, output, errors));
+    check_batch_read_output(output, buffer, sizeof(buffer));
+    ck_assert_str_eq("", buffer);
+    check_batch_read_output(errors, buffer, sizeof(buffer));
+    ck_assert_str_eq(expected, buffer);
+
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_batch_heap_exhaustion)
+{
+    char paths[2][32];
+    check_batch_write_file(paths[0], "(prin1 1)\n");
+    check_batch_write_file(paths[1], "(prin1 2)\n(make-array 100000)\n(prin1 3)\n");
+    const char *path_list[] = { paths[0], paths[1], paths[0] };
+
+    /* A job that runs out of heap fails, and the others still finish. */
+    for (uintptr_t workers = 1; workers <= 2; workers++) {
+        FILE *output = tmpfile();
+        FILE *errors = tmpfile();
+        ck_assert_uint_eq(1, lisp_batch_evaluate(lisp_batch_mode_files, path_list, 3, workers, 262144, NULL, output, errors));
+        ck_assert_ptr_eq(tests_vm, lisp_vm_current);
+
+        char buffer[256];
+        check_batch_read_output(output, buffer, sizeof(buffer));
+        ck_assert_str_eq("11", buffer);
+        check_batch_read_output(errors, buffer, sizeof(buffer));
+        char expected[64];
+        snprintf(expected, sizeof(expected), "%s: out of memory\n", paths[1]);
+        ck_assert_str_eq(expected, buffer);
+    }
+
+    /* So does a form that does. */
+    char path[32];
+    check_batch_write_file(path, "(prin1 1)\n(make-array 100000)\n(+ 1 2)\n");
+    const char *form_path_list[] = { path };
+    FILE *output = tmpfile();
+    FILE *errors = tmpfile();
+    ck_assert_uint_eq(1, lisp_batch_evaluate(lisp_batch_mode_forms, form_path_list, 1, 2, 262144, NULL, output, errors));
+
+    char buffer[256];
+    check_batch_read_output(output, buffer, sizeof(buffer));
+    ck_assert_str_eq("11\n3\n", buffer);
+    check_batch_read_output(errors, buffer, sizeof(buffer));
+    char expected[64];
+    snprintf(expected, sizeof(expected), "%s: out of memory\n", path);
+    ck_assert_str_eq(expected, buffer);
+
+    /* A form too big to read fails the whole batch, since its forms can't be found. */
+    static char text[2 + (40000 * 2) + 3];
+    strcpy(text, "'(");
+    for (int i = 0; i < 40000; i++) {
+        strcat(text + 2 + (i * 2), "0 ");
+    }
+    strcat(text, ")\n");
+    unlink(path);
+    check_batch_write_file(path, text);
+    snprintf(expected, sizeof(expected), "%s: out of memory\n", path);
+    output = tmpfile();
+    errors = tmpfile();
+    ck_assert_uint_eq(1, lisp_batch_evaluate(lisp_batch_mode_forms, form_path_list, 1, 2, 262144, NULL, output, errors));
+    ck_assert_ptr_eq(tests_vm, lisp_vm_current);
+    check_batch_read_output(output, buffer, sizeof(buffer));
+    ck_assert_str_eq("", buffer);
+    check_batch_read_output(errors, buffer, sizeof(buffer));
+    ck_assert_str_eq(expected, buffer);
+
+    /* Loading a file that doesn't fit fails too. */
+    ck_assert_ptr_eq(NULL, lisp_batch_load_shared(paths[1], 262144));
+    lisp_vm_set_current(tests_vm);
+
+    unlink(path);
+    for (int i = 0; i < 2; i++) {
+        unlink(paths[i]);
+    }
+}
+END_TEST
+
+START_TEST(test_batch_shared)
+{
+    char shared_path[32];
+    char paths[2][32];
+    check_batch_write_file(shared_path, "(defun f (x) (* x 10))\n(setq y 7)\n");
+    check_batch_write_file(paths[0], "(prin1 (f 1))\n");
+    check_batch_write_file(paths[1], "(setq y 8)\n(prin1 (f y))\n");
+    const char *path_list[] = { paths[0], paths[1], paths[0] };
+
+    ck_assert_ptr_eq(NULL, lisp_batch_load_shared("/nonexistent/check_batch", 1048576));
+    lisp_vm_t shared = lisp_batch_load_shared(shared_path, 1048576);
+    ck_assert_ptr_ne(NULL, shared);
+    ck_assert_ptr_eq(NULL, lisp_vm_current);
+
+    /* Every job sees what the shared file defines, and can't change it for the others. */
+    FILE *output = tmpfile();
+    ck_assert_uint_eq(0, lisp_batch_evaluate(lisp_batch_mode_files, path_list, 3, 2, 1048576, shared, output, stderr));
+
+    char buffer[256];
+    check_batch_read_output(output, buffer, sizeof(buffer));
+    ck_assert_str_eq("108010", buffer);
+
+    lisp_vm_dispose(shared);
+    lisp_vm_set_current(tests_vm);
+
+    unlink(shared_path);
+    for (int i = 0; i < 2; i++) {
+        unlink(paths[i]);
+    }
+}
+END_TEST
+
+START_TEST(test_batch_shared_changes)
+{
+    char shared_path[32];
+    char paths[2][32];
+    check_batch_write_file(shared_path,
+                           "(setq tbl (make-hash-table))\n(puthash 1 'one tbl)\n"
+                           "(setq data (list 1 2))\n(setq v (vector 1 2))\n"
+                           "(setq s (make-string-output-stream))\n");
+    check_batch_write_file(paths[0],
+                           "(prin1 (list (puthash 3 'three tbl) (remhash 1 tbl)\n"
+                           "             (rplaca data 99) (rplacd data nil)\n"
+                           "             (aset v 0 9) (vector-push-extend 3 v) (fill v 0) (replace v '(5 6))\n"
+                           "             (prin1 'x s) (get-output-stream-string s)))\n");
+    check_batch_write_file(paths[1], "(prin1 (list (gethash 1 tbl) (gethash 3 tbl) data v))\n");
+    const char *path_list[] = { paths[0], paths[1], paths[0], paths[1] };
+
+    lisp_vm_t shared = lisp_batch_load_shared(shared_path, 1048576);
+    ck_assert_ptr_ne(NULL, shared);
+
+    /* Changing shared objects fails without affecting them, or any other job. */
+    FILE *output = tmpfile();
+    ck_assert_uint_eq(0, lisp_batch_evaluate(lisp_batch_mode_files, path_list, 4, 2, 1048576, shared, output, stderr));
+
+    char buffer[256];
+    check_batch_read_output(output, buffer, sizeof(buffer));
+    ck_assert_str_eq("(NIL NIL NIL NIL NIL NIL NIL NIL X NIL)(ONE NIL (1 2) #(1 2))"
+                     "(NIL NIL NIL NIL NIL NIL NIL NIL X NIL)(ONE NIL (1 2) #(1 2))", buffer);
+
+    lisp_vm_dispose(shared);
+    lisp_vm_set_current(tests_vm);
+
+    unlink(shared_path);
+    for (int i = 0; i < 2; i++) {
+        unlink(paths[i]);
+    }
+}
+END_TEST
+
+
+/* MARK: - Test Infrastructure */
+
+Suite *batch_suite(void)
+{
+    Suite *s = suite_create("Batch");
+
+    TCase *tc_batch = tcase_create("Batch");
+    tcase_add_checked_fixture(tc_batch, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_batch, test_batch_files);
+    tcase_add_test(tc_batch, test_batch_forms);
+    tcase_add_test(tc_batch, test_batch_many_forms);
+    tcase_add_test(tc_batch, test_batch_out_of_memory);
+    tcase_add_test(tc_batch, test_batch_heap_exhaustion);
+    tcase_add_test(tc_batch, test_batch_shared);
+    tcase_add_test(tc_batch, test_batch_shared_changes);
+    suite_add_tcase(s, tc_batch);
+
+    return s;
+}
@@ -0,0 +1,168 @@
+/*
+    File:       check_binary.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include <check.h>
+
+#include <string.h>
+
+#include "genericlisp.h"
+#include "lisp_built_in_streams.h"
+
+#include "tests_support.h"
+
+
+/* MARK: - Binary S-expressions */
+
+/** Read and evaluate the next form in the read buffer. */
+static lisp_object_t check_binary_eval_next(lisp_object_t environment)
+{
+    return lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+}
+
+START_TEST(test_binary_encoding)
+{
+    lisp_object_t A = lisp_symbol_table_intern_bytes("A", 1);
+
+    /* A list of -1, A, A, and NIL is its count, its CARs, and its CDR. */
+    lisp_object_t output = lisp_stream_create_string_output();
+    lisp_object_t list = lisp_cell_list(lisp_fixnum_create(-1), A, A, lisp_NIL);
+    ck_assert_ptr_eq(lisp_T, lisp_binary_write(output, list));
+
+    const char expected[] = { 0x00, 3, 0x02, 1, 0x01, 1, 'A', 0x11, 2, 0x11, 0 };
+    char bytes[32];
+    uintptr_t length = lisp_string_get_c(lisp_stream_get_output_string(output), bytes, sizeof(bytes));
+    ck_assert_uint_eq(sizeof(expected), length);
+    ck_assert_int_eq(0, memcmp(expected, bytes, sizeof(expected)));
+}
+END_TEST
+
+START_TEST(test_binary_round_trip)
+{
+    tests_set_read_buffer("(A \"quote\\\"d\" (B . -300) #(1 #\\x (C)) NIL T A 1152921504606846975)");
+    lisp_object_t object = lisp_read(tests_root_environment, tests_read_stream, lisp_NIL);
+    lisp_object_t wide = lisp_string_create_empty();
+    lisp_string_append_char(wide, lisp_char_create(0x263A));
+    object = lisp_cell_cons(wide, object);
+
+    lisp_object_t output = lisp_stream_create_string_output();
+    ck_assert_ptr_eq(lisp_T, lisp_binary_write(output, object));
+    ck_assert_ptr_eq(lisp_T, lisp_binary_write(output, lisp_fixnum_create(7)));
+
+    /* Objects written one after another are read back one at a time. */
+    lisp_object_t input = lisp_stream_create_string_input(lisp_stream_get_output_string(output));
+    lisp_object_t loaded;
+    ck_assert_ptr_eq(lisp_T, lisp_binary_read(input, &loaded));
+    ck_assert_ptr_eq(lisp_T, lisp_equal(object, loaded));
+    ck_assert_ptr_eq(lisp_cell_car(lisp_cell_cdr(object)), lisp_cell_car(lisp_cell_cdr(loaded)));
+    ck_assert_ptr_eq(lisp_T, lisp_binary_read(input, &loaded));
+    ck_assert_ptr_eq(lisp_fixnum_create(7), loaded);
+    ck_assert_ptr_eq(lisp_NIL, lisp_binary_read(input, &loaded));
+
+    /* A long list is read back with its cells allocated together. */
+    lisp_object_t long_list = lisp_NIL;
+    for (lisp_fixnum_t i = 999; i >= 0; i--) {
+        long_list = lisp_cell_cons(lisp_fixnum_create(i * 1000), long_list);
+    }
+    output = lisp_stream_create_string_output();
+    ck_assert_ptr_eq(lisp_T, lisp_binary_write(output, long_list));
+    input = lisp_stream_create_string_input(lisp_stream_get_output_string(output));
+    ck_assert_ptr_eq(lisp_T, lisp_binary_read(input, &loaded));
+    ck_assert_ptr_eq(lisp_T, lisp_equal(long_list, loaded));
+}
+END_TEST
+
+START_TEST(test_binary_failures)
+{
+    lisp_object_t loaded;
+
+    /* Circular structures and streams can't be written. */
+    lisp_object_t circular = lisp_cell_list(lisp_T, lisp_T, lisp_NIL);
+    lisp_cell_rplacd(lisp_cell_cdr(circular), circular);
+    ck_assert_ptr_eq(lisp_NIL, lisp_binary_write(lisp_stream_create_string_output(), circular));
+    lisp_object_t containing = lisp_cell_list(lisp_T, lisp_NIL);
+    lisp_cell_rplaca(containing, containing);
+    ck_assert_ptr_eq(lisp_NIL, lisp_binary_write(lisp_stream_create_string_output(), containing));
+    ck_assert_ptr_eq(lisp_NIL, lisp_binary_write(lisp_stream_create_string_output(), tests_write_stream));
+
+    /* Truncated and malformed data can't be read. */
+    lisp_object_t truncated = lisp_string_create_bytes("\x00\x05\x02", 3);
+    ck_assert_ptr_eq(lisp_NIL, lisp_binary_read(lisp_stream_create_string_input(truncated), &loaded));
+    lisp_object_t unknown_atom = lisp_string_create_bytes("\x11\x09", 2);
+    ck_assert_ptr_eq(lisp_NIL, lisp_binary_read(lisp_stream_create_string_input(unknown_atom), &loaded));
+}
+END_TEST
+
+START_TEST(test_binary_oversized_input)
+{
+    lisp_object_t loaded;
+
+    /* A length longer than what's left of the stream is rejected before anything is allocated. */
+    const char *oversized[] = {
+        "\x00\xff\xff\xff\xff\x0f",                     /* A list of 2^32 - 1 cells. */
+        "\x04\x80\x89\x7a",                               /* A vector of 2,000,000 values. */
+        "\x06\xff\xff\xff\xff\xff\xff\xff\xff\x7f",    /* A string whose size would overflow. */
+        "\x01\xe8\x07" "ABC",                              /* An atom name of 1,000 bytes. */
+        "\x00\x02\x00\x03\x02\x02\x02",                  /* A list needing more than is left. */
+    };
+    const uintptr_t lengths[] = { 6, 4, 10, 6, 7 };
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        lisp_object_t bytes = lisp_string_create_bytes(oversized[i], lengths[i]);
+        ck_assert_ptr_eq(lisp_NIL, lisp_binary_read(lisp_stream_create_string_input(bytes), &loaded));
+    }
+
+    /* A stream whose length isn't known still can't claim more than the heap has left. */
+    char huge_vector[] = "\x04\xff\xff\xff\xff\x0f";
+    tests_set_read_buffer(huge_vector);
+    ck_assert_uint_eq(UINTPTR_MAX, lisp_stream_remaining(tests_read_stream));
+    ck_assert_ptr_eq(lisp_NIL, lisp_binary_read(tests_read_stream, &loaded));
+
+    /* Lengths that just fit are still read. */
+    lisp_object_t exact = lisp_string_create_bytes("\x00\x02\x02\x02\x02\x04\x11\x00", 8);
+    ck_assert_ptr_eq(lisp_T, lisp_binary_read(lisp_stream_create_string_input(exact), &loaded));
+    ck_assert_ptr_eq(lisp_fixnum_create(1), lisp_cell_car(loaded));
+    ck_assert_ptr_eq(lisp_fixnum_create(2), lisp_cell_car(lisp_cell_cdr(loaded)));
+}
+END_TEST
+
+START_TEST(test_binary_evaluation)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+    tests_set_read_buffer("(setq out (make-string-output-stream))\n"
+                          "(write-binary '(x \"y\" #(z)) out)\n"
+                          "(write-binary 42 out)\n"
+                          "(setq in (make-string-input-stream (get-output-stream-string out)))\n"
+                          "(read-binary in)\n"
+                          "(read-binary in)\n");
+
+    check_binary_eval_next(environment);
+    lisp_object_t written = check_binary_eval_next(environment);
+    ck_assert_ptr_ne(lisp_NIL, written);
+    ck_assert_ptr_eq(lisp_fixnum_create(42), check_binary_eval_next(environment));
+    check_binary_eval_next(environment);
+    ck_assert_ptr_eq(lisp_T, lisp_equal(written, check_binary_eval_next(environment)));
+    ck_assert_ptr_eq(lisp_fixnum_create(42), check_binary_eval_next(environment));
+}
+END_TEST
+
+
+/* MARK: - Test Infrastructure */
+
+Suite *binary_suite(void)
+{
+    Suite *s = suite_create("Binary");
+
+    TCase *tc_binary = tcase_create("Binary");
+    tcase_add_checked_fixture(tc_binary, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_binary, test_binary_encoding);
+    tcase_add_test(tc_binary, test_binary_round_trip);
+    tcase_add_test(tc_binary, test_binary_failures);
+    tcase_add_test(tc_binary, test_binary_oversized_input);
+    tcase_add_test(tc_binary, test_binary_evaluation);
+    suite_add_tcase(s, tc_binary);
+
+    return s;
+}
@@ -8,6 +8,7 @@
 #include <check.h>
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "genericlisp.h"
 #include "lisp_built_in_sforms.h"
@@ -124,6 +125,81 @@ START_TEST(test_list_printing_structural)
 }
 END_TEST
 
+START_TEST(test_list_printing_control)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+    lisp_object_t A = lisp_atom_create_c("A");
+    lisp_object_t B = lisp_atom_create_c("B");
+
+    /* A circular list and a shared list, with *PRINT-CIRCLE*. */
+    lisp_environment_set_symbol_value(environment, lisp_PRINT_CIRCLE, lisp_APVAL, lisp_T, lisp_NIL);
+
+    lisp_object_t circular = lisp_cell_list(A, B, lisp_NIL);
+    lisp_cell_rplacd(lisp_cell_cdr(circular), circular);
+    lisp_print(environment, tests_write_stream, circular);
+    ck_assert_str_eq("#1=(A B . #1#)", tests_write_buffer);
+    tests_clear_write_buffer();
+
+    lisp_object_t shared = lisp_cell_list(A, lisp_NIL);
+    lisp_object_t sharing = lisp_cell_list(shared, shared, lisp_string_create_c("S"), lisp_NIL);
+    lisp_print(environment, tests_write_stream, sharing);
+    ck_assert_str_eq("(#1=(A) #1# \"S\")", tests_write_buffer);
+    tests_clear_write_buffer();
+
+    /* *PRINT-LENGTH* and *PRINT-LEVEL* limit how much is printed. */
+    lisp_environment_set_symbol_value(environment, lisp_PRINT_CIRCLE, lisp_APVAL, lisp_NIL, lisp_NIL);
+    lisp_environment_set_symbol_value(environment, lisp_PRINT_LENGTH, lisp_APVAL, lisp_fixnum_create(2), lisp_NIL);
+    lisp_environment_set_symbol_value(environment, lisp_PRINT_LEVEL, lisp_APVAL, lisp_fixnum_create(1), lisp_NIL);
+
+    lisp_object_t nested = lisp_cell_list(A, shared, B, lisp_NIL);
+    lisp_print(environment, tests_write_stream, nested);
+    ck_assert_str_eq("(A # ...)", tests_write_buffer);
+    tests_clear_write_buffer();
+
+    lisp_environment_set_symbol_value(environment, lisp_PRINT_LEVEL, lisp_APVAL, lisp_NIL, lisp_NIL);
+    lisp_object_t vector = lisp_vector_create(3, A);
+    lisp_print(environment, tests_write_stream, vector);
+    ck_assert_str_eq("#(A A ...)", tests_write_buffer);
+}
+END_TEST
+
+START_TEST(test_list_equality)
+{
+    lisp_object_t A = lisp_atom_create_c("A");
+    lisp_object_t B = lisp_atom_create_c("B");
+
+    /* Long lists are compared without recursing along them. */
+    lisp_object_t long_a = lisp_NIL;
+    lisp_object_t long_b = lisp_NIL;
+    for (lisp_fixnum_t i = 0; i < 5000; i++) {
+        long_a = lisp_cell_cons(lisp_fixnum_create(i), long_a);
+        long_b = lisp_cell_cons(lisp_fixnum_create(i), long_b);
+    }
+    ck_assert_ptr_eq(lisp_T, lisp_equal(long_a, long_b));
+    ck_assert_uint_eq(lisp_hash_table_hash_equal(long_a), lisp_hash_table_hash_equal(long_b));
+    lisp_cell_rplaca(long_b, A);
+    ck_assert_ptr_eq(lisp_NIL, lisp_equal(long_a, long_b));
+
+    /* Circular lists are equal if walking them can't tell them apart. */
+    lisp_object_t once = lisp_cell_list(A, B, lisp_NIL);
+    lisp_cell_rplacd(lisp_cell_cdr(once), once);
+    lisp_object_t twice = lisp_cell_list(A, B, A, B, lisp_NIL);
+    lisp_cell_rplacd(lisp_cell_cdr(lisp_cell_cdr(lisp_cell_cdr(twice))), twice);
+    ck_assert_ptr_eq(lisp_T, lisp_equal(once, twice));
+
+    lisp_object_t other = lisp_cell_list(A, A, lisp_NIL);
+    lisp_cell_rplacd(lisp_cell_cdr(other), other);
+    ck_assert_ptr_eq(lisp_NIL, lisp_equal(once, other));
+
+    /* Lists that contain themselves are handled too. */
+    lisp_object_t self_a = lisp_cell_list(A, lisp_NIL);
+    lisp_cell_rplaca(self_a, self_a);
+    lisp_object_t self_b = lisp_cell_list(A, lisp_NIL);
+    lisp_cell_rplaca(self_b, self_b);
+    ck_assert_ptr_eq(lisp_T, lisp_equal(self_a, self_b));
+}
+END_TEST
+
 START_TEST(test_list_reading)
 {
     lisp_object_t environment = tests_root_environment;
@@ -224,6 +300,53 @@ START_TEST(test_list_reading_quoted_list)
 END_TEST
 
 
+START_TEST(test_list_reading_deeply_nested)
+{
+    lisp_object_t environment = tests_root_environment;
+
+    /* Nesting is limited only by the heap, not by the C stack. */
+    const int depth = 1500;
+    char *buffer = malloc((depth * 2) + 2);
+    memset(buffer, '(', depth);
+    buffer[depth] = 'A';
+    memset(buffer + depth + 1, ')', depth);
+    buffer[(depth * 2) + 1] = '\0';
+    tests_set_read_buffer(buffer);
+    free(buffer);
+
+    lisp_object_t read_object = lisp_read(environment, tests_read_stream, lisp_NIL);
+    ck_assert(tests_eofp_read_buffer());
+    for (int i = 0; i < depth; i++) {
+        ck_assert_int_eq(lisp_tag_cell, lisp_object_get_tag(read_object));
+        ck_assert_ptr_eq(lisp_NIL, lisp_cell_cdr(read_object));
+        read_object = lisp_cell_car(read_object);
+    }
+    ck_assert_str_eq("A", lisp_atom_get_value(read_object));
+}
+END_TEST
+
+START_TEST(test_list_reading_nested_quotes)
+{
+    lisp_object_t environment = tests_root_environment;
+
+    tests_set_read_buffer("(''A () 'B)");
+    lisp_object_t read_object = lisp_read(environment, tests_read_stream, lisp_NIL);
+    lisp_print(environment, tests_write_stream, read_object);
+    ck_assert_str_eq("((QUOTE (QUOTE A)) NIL (QUOTE B))", tests_write_buffer);
+}
+END_TEST
+
+START_TEST(test_list_reading_unterminated)
+{
+    lisp_object_t environment = tests_root_environment;
+
+    tests_set_read_buffer("(A (B");
+    lisp_object_t read_object = lisp_read(environment, tests_read_stream, lisp_NIL);
+    ck_assert_ptr_eq(lisp_NIL, read_object);
+    ck_assert(tests_eofp_read_buffer());
+}
+END_TEST
+
 /* MARK: - Test Infrastructure */
 
 Suite *cell_suite(void)
@@ -242,11 +365,16 @@ Suite *cell_suite(void)
     tcase_add_test(tc_lists, test_list_creation);
     tcase_add_test(tc_lists, test_list_printing);
     tcase_add_test(tc_lists, test_list_printing_structural);
+    tcase_add_test(tc_lists, test_list_printing_control);
+    tcase_add_test(tc_lists, test_list_equality);
     tcase_add_test(tc_lists, test_list_reading);
     tcase_add_test(tc_lists, test_list_reading_nested);
     tcase_add_test(tc_lists, test_list_reading_atom_interning);
     tcase_add_test(tc_lists, test_list_reading_quoted_atom);
     tcase_add_test(tc_lists, test_list_reading_quoted_list);
+    tcase_add_test(tc_lists, test_list_reading_deeply_nested);
+    tcase_add_test(tc_lists, test_list_reading_nested_quotes);
+    tcase_add_test(tc_lists, test_list_reading_unterminated);
     suite_add_tcase(s, tc_lists);
 
     return s;
@@ -8,6 +8,7 @@
 #include <check.h>
 
 #include "genericlisp.h"
+#include "lisp_root.h"
 
 #include "tests_support.h"
 
@@ -50,6 +51,27 @@ START_TEST(test_root_environment_has_t)
 }
 END_TEST
 
+START_TEST(test_root_environment_is_constant)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+    ck_assert_ptr_eq(lisp_root_environment, lisp_environment_parent(tests_root_environment));
+
+    tests_set_read_buffer("(remprop 'car 'subr)\n"
+                          "(makunbound 'quote)\n"
+                          "(car '(1 2))\n");
+
+    /* Nothing can be removed from the root environment. */
+    lisp_object_t removed = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_NIL, removed);
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_object_t value = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(1), value);
+
+    /* Its atoms are the ones the reader returns. */
+    ck_assert_ptr_eq(lisp_SUBR, lisp_symbol_table_intern_bytes("SUBR", 4));
+}
+END_TEST
+
 
 /* MARK: - Nested */
 
@@ -84,6 +106,42 @@ START_TEST(test_nested_environment_gets_t_from_root)
 }
 END_TEST
 
+START_TEST(test_nested_environment_unbinding)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+    lisp_object_t before = lisp_environment_create(tests_root_environment);
+    uintptr_t before_length = 0;
+    for (lisp_object_t iter = before; iter != lisp_NIL; iter = lisp_cell_cdr(iter)) {
+        before_length = before_length + 1;
+    }
+
+    tests_set_read_buffer("(setq x 1)\n"
+                          "(makunbound 'x)\n"
+                          "x\n"
+                          "(setq y 2)\n"
+                          "(remprop 'y 'apval)\n"
+                          "(remprop 'y 'apval)\n");
+
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_object_t unbound = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("X", lisp_atom_get_value(unbound));
+    lisp_object_t value = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_NIL, value);
+
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_object_t removed = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_T, removed);
+    lisp_object_t removed_again = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_NIL, removed_again);
+
+    /* Unbinding removes the symbols from the environment entirely. */
+    uintptr_t length = 0;
+    for (lisp_object_t iter = environment; iter != lisp_NIL; iter = lisp_cell_cdr(iter)) {
+        length = length + 1;
+    }
+    ck_assert_int_eq(before_length, length);
+}
+END_TEST
 
 /* MARK: - Test Infrastructure */
 
@@ -95,11 +153,13 @@ Suite *environment_suite(void)
     tcase_add_checked_fixture(tc_root_environment, tests_shared_setup, tests_shared_teardown);
     tcase_add_test(tc_root_environment, test_root_environment_creation);
     tcase_add_test(tc_root_environment, test_root_environment_has_t);
+    tcase_add_test(tc_root_environment, test_root_environment_is_constant);
     suite_add_tcase(s, tc_root_environment);
 
     TCase *tc_nested_environment = tcase_create("Nested");
     tcase_add_checked_fixture(tc_nested_environment, tests_shared_setup, tests_shared_teardown);
     tcase_add_test(tc_nested_environment, test_nested_environment_gets_t_from_root);
+    tcase_add_test(tc_nested_environment, test_nested_environment_unbinding);
     suite_add_tcase(s, tc_nested_environment);
 
     return s;
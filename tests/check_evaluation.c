@@ -417,6 +417,116 @@ START_TEST(test_evaluating_DEFUN)
 }
 END_TEST
 
+START_TEST(test_evaluating_DEFUN_with_folding)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer(
+     "(defun folded (x)\n"
+     "  (if (< 1 2)\n"
+     "      (cond ((null 'a) 'never)\n"
+     "            ((eq x 1) (+ x (* 2 3)))\n"
+     "            (t (car '(a b)))\n"
+     "            (x 'unreachable))\n"
+     "      (/ 1 0)))\n"
+     "(defun shadowed (car) (car '(a b)))\n"
+     "(folded 1)\n"
+     "(folded 2)\n");
+
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_object_t folded = lisp_atom_create_c("FOLDED");
+    lisp_print(environment, tests_write_stream, lisp_eval(environment, folded));
+    ck_assert_str_eq("(LAMBDA (X) (BLOCK FOLDED (COND ((EQ X 1) (+ X 6)) (T (QUOTE A)))))", tests_write_buffer);
+
+    // A parameter shadows the pure SUBR its name would otherwise refer to.
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_object_t shadowed = lisp_atom_create_c("SHADOWED");
+    tests_clear_write_buffer();
+    lisp_print(environment, tests_write_stream, lisp_eval(environment, shadowed));
+    ck_assert_str_eq("(LAMBDA (CAR) (BLOCK SHADOWED (CAR (QUOTE (A B)))))", tests_write_buffer);
+
+    lisp_object_t folded_1 = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_int_eq(7, lisp_fixnum_get_value(folded_1));
+
+    lisp_object_t folded_2 = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("A", lisp_atom_get_value(folded_2));
+}
+END_TEST
+
+START_TEST(test_evaluating_DEFUN_with_folding_shadowed_by_caller)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer(
+     "(defun first-of-a-b (x) (car '(a b)))\n"
+     "(defun call-with-car (car) (first-of-a-b 1))\n"
+     "(first-of-a-b 1)\n"
+     "(call-with-car (lambda (x) 'three))\n"
+     "(first-of-a-b 1)\n");
+
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+
+    lisp_object_t unshadowed = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("A", lisp_atom_get_value(unshadowed));
+
+    // A caller's parameter shadows the pure SUBR under dynamic scope.
+    lisp_object_t shadowed = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("THREE", lisp_atom_get_value(shadowed));
+
+    lisp_object_t unshadowed_again = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("A", lisp_atom_get_value(unshadowed_again));
+}
+END_TEST
+
+START_TEST(test_evaluating_cached_call_sites)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer(
+     "(defun f (v) 'one)\n"
+     "(defun g (v) (f v))\n"
+     "(g 1)\n"
+     "(g 1)\n"
+     "(defun f (v) 'two)\n"
+     "(g 1)\n"
+     "(defun m (f) (g 1))\n"
+     "(m (lambda (v) 'three))\n"
+     "(g 1)\n");
+
+    const char *expected[] = { "F", "G", "ONE", "ONE", "F", "TWO", "M", "THREE", "TWO" };
+    for (int i = 0; i < 9; i++) {
+        lisp_object_t form = lisp_read(environment, tests_read_stream, lisp_NIL);
+        lisp_object_t result = lisp_eval(environment, form);
+        ck_assert_ptr_eq(lisp_T, lisp_atomp(result));
+        ck_assert_str_eq(expected[i], lisp_atom_get_value(result));
+    }
+}
+END_TEST
+
+START_TEST(test_evaluating_cached_call_sites_bound_in_a_call)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer(
+     "(defun call-inner (a) (inner 1))\n"
+     "(defun mk (a) (defun inner (x) 'inner) (call-inner 1))\n"
+     "(mk 1)\n"
+     "(call-inner 1)\n");
+
+    for (int i = 0; i < 2; i++) {
+        lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    }
+
+    // INNER is only bound in the environment of the call to MK.
+    lisp_object_t inside = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("INNER", lisp_atom_get_value(inside));
+
+    lisp_object_t outside = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_NIL, outside);
+}
+END_TEST
+
 
 /* MARK: - Built-in SUBRs */
 
@@ -644,6 +754,10 @@ Suite *evaluation_suite(void)
     // TODO: Test RETURN
     tcase_add_test(tc_special_forms, test_evaluating_COND);
     tcase_add_test(tc_special_forms, test_evaluating_DEFUN);
+    tcase_add_test(tc_special_forms, test_evaluating_DEFUN_with_folding);
+    tcase_add_test(tc_special_forms, test_evaluating_DEFUN_with_folding_shadowed_by_caller);
+    tcase_add_test(tc_special_forms, test_evaluating_cached_call_sites);
+    tcase_add_test(tc_special_forms, test_evaluating_cached_call_sites_bound_in_a_call);
     tcase_add_test(tc_special_forms, test_evaluating_AND);
     tcase_add_test(tc_special_forms, test_evaluating_AND_with_zero_arguments);
     tcase_add_test(tc_special_forms, test_evaluating_OR);
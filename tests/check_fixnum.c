@@ -87,6 +87,35 @@ START_TEST(test_printing_max_fixnum)
 }
 END_TEST
 
+START_TEST(test_printing_radix)
+{
+    lisp_fixnum_print_radix(tests_write_stream, 255, 16, 0, ' ');
+    ck_assert_str_eq("FF", tests_write_buffer);
+    tests_clear_write_buffer();
+
+    lisp_fixnum_print_radix(tests_write_stream, -5, 2, 8, '0');
+    ck_assert_str_eq("0000-101", tests_write_buffer);
+    tests_clear_write_buffer();
+
+    ck_assert_ptr_eq(lisp_NIL, lisp_fixnum_print_radix(tests_write_stream, 1, 37, 0, ' '));
+}
+END_TEST
+
+START_TEST(test_formatting)
+{
+    lisp_object_t environment = tests_root_environment;
+
+    tests_set_read_buffer("(format nil \"~D items, ~5,'0D~%~X ~B ~8R ~4D|~A~~\" 42 7 255 5 64 -3 'done)");
+    lisp_object_t form = lisp_read(environment, tests_read_stream, lisp_NIL);
+    lisp_object_t result = lisp_eval(environment, form);
+    ck_assert_ptr_eq(lisp_T, lisp_stringp(result));
+
+    char buffer[64];
+    lisp_string_get_c(result, buffer, sizeof(buffer));
+    ck_assert_str_eq("42 items, 00007\nFF 101 100   -3|DONE~", buffer);
+}
+END_TEST
+
 START_TEST(test_equality)
 {
 #if __LP64__
@@ -142,6 +171,8 @@ Suite *fixnum_suite(void)
     tcase_add_test(tc_fixnums, test_printing);
     tcase_add_test(tc_fixnums, test_printing_min_fixnum);
     tcase_add_test(tc_fixnums, test_printing_max_fixnum);
+    tcase_add_test(tc_fixnums, test_printing_radix);
+    tcase_add_test(tc_fixnums, test_formatting);
     tcase_add_test(tc_fixnums, test_equality);
     tcase_add_test(tc_fixnums, test_reading_min_fixnum);
     tcase_add_test(tc_fixnums, test_reading_max_fixnum);
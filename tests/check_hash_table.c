@@ -0,0 +1,184 @@
+/*
+    File:       check_hash_table.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include <check.h>
+
+#include "genericlisp.h"
+
+#include "tests_support.h"
+
+
+/* MARK: - Hash Tables */
+
+START_TEST(test_creation)
+{
+    lisp_object_t table = lisp_hash_table_create(lisp_hash_table_test_eql, 0);
+    ck_assert_int_eq(lisp_tag_hash_table, lisp_object_get_tag(table));
+    ck_assert_ptr_eq(lisp_T, lisp_hash_tablep(table));
+    ck_assert_int_eq(0, lisp_hash_table_count(table));
+    ck_assert_ptr_eq(lisp_T, lisp_hash_table_get(table, lisp_fixnum_create(1), lisp_T));
+
+    /* A size hint leaves room for that many entries without growing. */
+    lisp_object_t sized = lisp_hash_table_create(lisp_hash_table_test_eq, 100);
+    ck_assert_int_ge(lisp_hash_table_get_value(sized)->capacity * 3, 100 * 4);
+
+    lisp_print(tests_root_environment, tests_write_stream, table);
+    ck_assert_str_eq("#<HASH-TABLE :TEST EQL :COUNT 0>", tests_write_buffer);
+}
+END_TEST
+
+START_TEST(test_putting_and_removing)
+{
+    lisp_object_t table = lisp_hash_table_create(lisp_hash_table_test_eql, 0);
+
+    /* Add enough entries to grow several times. */
+    for (lisp_fixnum_t i = 0; i < 2000; i++) {
+        lisp_hash_table_put(table, lisp_fixnum_create(i), lisp_fixnum_create(i * 2));
+    }
+    ck_assert_int_eq(2000, lisp_hash_table_count(table));
+
+    /* Replace some values and remove every third entry. */
+    for (lisp_fixnum_t i = 0; i < 2000; i++) {
+        if ((i % 3) == 0) {
+            ck_assert_ptr_eq(lisp_T, lisp_hash_table_remove(table, lisp_fixnum_create(i)));
+        } else if ((i % 3) == 1) {
+            lisp_hash_table_put(table, lisp_fixnum_create(i), lisp_T);
+        }
+    }
+    ck_assert_int_eq(1333, lisp_hash_table_count(table));
+    ck_assert_ptr_eq(lisp_NIL, lisp_hash_table_remove(table, lisp_fixnum_create(0)));
+
+    for (lisp_fixnum_t i = 0; i < 2000; i++) {
+        lisp_object_t value = lisp_hash_table_get(table, lisp_fixnum_create(i), lisp_NIL);
+        if ((i % 3) == 0) {
+            ck_assert_ptr_eq(lisp_NIL, value);
+        } else if ((i % 3) == 1) {
+            ck_assert_ptr_eq(lisp_T, value);
+        } else {
+            ck_assert_ptr_eq(lisp_fixnum_create(i * 2), value);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_tests)
+{
+    lisp_object_t key = lisp_cell_list(lisp_atom_create_c("A"), lisp_string_create_c("b"), lisp_NIL);
+    lisp_object_t same_key = lisp_cell_list(lisp_atom_create_c("A"), lisp_string_create_c("b"), lisp_NIL);
+    ck_assert_int_eq(lisp_hash_table_hash_equal(key), lisp_hash_table_hash_equal(same_key));
+
+    /* EQUAL tables find equivalent keys. */
+    lisp_object_t equal_table = lisp_hash_table_create(lisp_hash_table_test_equal, 0);
+    lisp_hash_table_put(equal_table, key, lisp_T);
+    ck_assert_ptr_eq(lisp_T, lisp_hash_table_get(equal_table, same_key, lisp_NIL));
+    lisp_hash_table_put(equal_table, same_key, lisp_fixnum_create(1));
+    ck_assert_int_eq(1, lisp_hash_table_count(equal_table));
+
+    /* EQ tables only find identical keys. */
+    lisp_object_t eq_table = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+    lisp_hash_table_put(eq_table, key, lisp_T);
+    ck_assert_ptr_eq(lisp_T, lisp_hash_table_get(eq_table, key, lisp_NIL));
+    ck_assert_ptr_eq(lisp_NIL, lisp_hash_table_get(eq_table, same_key, lisp_NIL));
+}
+END_TEST
+
+/** Count the entries visited, removing those with odd keys. */
+static void test_mapping_entry(lisp_object_t key, lisp_object_t value, void *context)
+{
+    uintptr_t *visits = context;
+    visits[lisp_fixnum_get_value(key)] += 1;
+    if ((lisp_fixnum_get_value(key) % 2) == 1) {
+        lisp_hash_table_remove((lisp_object_t) visits[0], key);
+    }
+}
+
+START_TEST(test_mapping)
+{
+    lisp_object_t table = lisp_hash_table_create(lisp_hash_table_test_eq, 0);
+    for (lisp_fixnum_t i = 1; i <= 300; i++) {
+        lisp_hash_table_put(table, lisp_fixnum_create(i), lisp_T);
+    }
+
+    /* Slot 0 holds the table, since keys start at 1. */
+    uintptr_t visits[301] = { 0 };
+    visits[0] = (uintptr_t) table;
+    lisp_hash_table_map(table, test_mapping_entry, visits);
+
+    for (uintptr_t i = 1; i <= 300; i++) {
+        ck_assert_int_eq(1, visits[i]);
+    }
+    ck_assert_int_eq(150, lisp_hash_table_count(table));
+}
+END_TEST
+
+
+/* MARK: - Evaluation */
+
+START_TEST(test_evaluating_hash_table_SUBRs)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer("(setq h (make-hash-table :test 'equal))\n"
+                          "(puthash \"one\" 1 h)\n"
+                          "(puthash '(2) 2 h)\n"
+                          "(gethash \"one\" h)\n"
+                          "(gethash (list 2) h)\n"
+                          "(gethash 'three h 'none)\n"
+                          "(remhash \"one\" h)\n"
+                          "(hash-table-count h)\n"
+                          "(hash-table-p (make-hash-table :test eq))\n"
+                          "(= (sxhash '(a \"b\" #(3))) (sxhash (list 'a \"b\" (vector 3))))\n");
+
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+
+    lisp_object_t one = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(1), one);
+
+    lisp_object_t two = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(2), two);
+
+    lisp_object_t none = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("NONE", lisp_atom_get_value(none));
+
+    lisp_object_t removed = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_T, removed);
+
+    lisp_object_t count = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(1), count);
+
+    lisp_object_t hash_table_p = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_T, hash_table_p);
+
+    lisp_object_t same_hash = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_T, same_hash);
+}
+END_TEST
+
+
+/* MARK: - Test Infrastructure */
+
+Suite *hash_table_suite(void)
+{
+    Suite *s = suite_create("Hash Table");
+
+    TCase *tc_hash_tables = tcase_create("Hash Tables");
+    tcase_add_checked_fixture(tc_hash_tables, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_hash_tables, test_creation);
+    tcase_add_test(tc_hash_tables, test_putting_and_removing);
+    tcase_add_test(tc_hash_tables, test_tests);
+    tcase_add_test(tc_hash_tables, test_mapping);
+    suite_add_tcase(s, tc_hash_tables);
+
+    TCase *tc_evaluation = tcase_create("Evaluation");
+    tcase_add_checked_fixture(tc_evaluation, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_evaluation, test_evaluating_hash_table_SUBRs);
+    suite_add_tcase(s, tc_evaluation);
+
+    return s;
+}
@@ -0,0 +1,181 @@
+/*
+    File:       check_image.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include <check.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "genericlisp.h"
+#include "lisp_built_in_streams.h"
+
+#include "tests_support.h"
+
+
+/* MARK: - Images */
+
+START_TEST(test_image_round_trip)
+{
+    lisp_object_t environment = tests_root_environment;
+    lisp_object_t A = lisp_symbol_table_intern(lisp_atom_create_c("A"));
+    lisp_object_t CAR = lisp_atom_create_c("CAR");
+    lisp_object_t car_subr = lisp_environment_get_symbol_value(environment, CAR, lisp_SUBR, lisp_T);
+
+    /* A circular list holding a shared vector, with one of everything. */
+    lisp_object_t vector = lisp_vector_create(2, lisp_fixnum_create(-123456789));
+    lisp_vector_set(vector, 1, lisp_char_create(0x263A));
+    lisp_object_t list = lisp_cell_list(A, lisp_string_create_c("say \"hi\""), vector, vector, car_subr, lisp_NIL);
+    lisp_cell_rplacd(lisp_cell_cdr(lisp_cell_cdr(lisp_cell_cdr(lisp_cell_cdr(list)))), list);
+
+    lisp_object_t output = lisp_stream_create_string_output();
+    ck_assert_ptr_eq(lisp_T, lisp_image_write(output, list));
+    lisp_object_t image = lisp_stream_get_output_string(output);
+
+    lisp_object_t input = lisp_stream_create_string_input(image);
+    lisp_object_t loaded = lisp_NIL;
+    ck_assert_ptr_eq(lisp_T, lisp_image_read(environment, input, &loaded));
+    ck_assert_ptr_ne(list, loaded);
+    ck_assert_ptr_eq(lisp_T, lisp_equal(list, loaded));
+
+    /* Atoms are interned, SUBRs found by name, and sharing is kept. */
+    ck_assert_ptr_eq(A, lisp_cell_car(loaded));
+    lisp_object_t rest = lisp_cell_cdr(lisp_cell_cdr(loaded));
+    ck_assert_ptr_eq(lisp_cell_car(rest), lisp_cell_car(lisp_cell_cdr(rest)));
+    ck_assert_ptr_eq(car_subr, lisp_cell_car(lisp_cell_cdr(lisp_cell_cdr(rest))));
+    ck_assert_ptr_eq(loaded, lisp_cell_cdr(lisp_cell_cdr(lisp_cell_cdr(rest))));
+
+    /* Streams can't be stored, and a truncated image can't be read. */
+    ck_assert_ptr_eq(lisp_NIL, lisp_image_write(lisp_stream_create_string_output(),
+                                                lisp_cell_list(tests_write_stream, lisp_NIL)));
+    lisp_object_t truncated = lisp_string_create_c("GLIMAGE");
+    ck_assert_ptr_eq(lisp_NIL, lisp_image_read(environment, lisp_stream_create_string_input(truncated), &loaded));
+}
+END_TEST
+
+START_TEST(test_image_save_and_load)
+{
+    char path[] = "/tmp/check_image.XXXXXX";
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    close(fd);
+
+    char source[256];
+    snprintf(source, sizeof(source),
+             "(defun twice (x) (* x 2))\n"
+             "(setq data '(1 \"two\" #(3)))\n"
+             "(save-image \"%s\")\n"
+             "(load-image \"%s\")\n"
+             "(twice 21)\n"
+             "data\n",
+             path, path);
+    tests_set_read_buffer(source);
+
+    lisp_object_t saving = lisp_environment_create(tests_root_environment);
+    lisp_eval(saving, lisp_read(saving, tests_read_stream, lisp_NIL));
+    lisp_eval(saving, lisp_read(saving, tests_read_stream, lisp_NIL));
+    lisp_object_t saved = lisp_eval(saving, lisp_read(saving, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_T, saved);
+
+    lisp_object_t loading = lisp_environment_create(tests_root_environment);
+    lisp_object_t loaded = lisp_eval(loading, lisp_read(loading, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_T, loaded);
+
+    lisp_object_t result = lisp_eval(loading, lisp_read(loading, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(42), result);
+
+    lisp_object_t data = lisp_eval(loading, lisp_read(loading, tests_read_stream, lisp_NIL));
+    lisp_print(loading, tests_write_stream, data);
+    ck_assert_str_eq("(1 \"two\" #(3))", tests_write_buffer);
+
+    /* Bindings to streams aren't saved, so they aren't shadowed. */
+    ck_assert_ptr_eq(lisp_NIL, lisp_environment_find_symbol(loading, lisp_STANDARD_OUTPUT, lisp_NIL));
+
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_image_corrupt)
+{
+    lisp_object_t environment = tests_root_environment;
+    lisp_object_t loaded;
+
+    /* Every truncation of a valid image is rejected. */
+    lisp_object_t output = lisp_stream_create_string_output();
+    lisp_object_t list = lisp_cell_list(lisp_string_create_c("abc"), lisp_vector_create(2, lisp_T), lisp_NIL);
+    ck_assert_ptr_eq(lisp_T, lisp_image_write(output, list));
+    char image[256];
+    uintptr_t length = lisp_string_get_c(lisp_stream_get_output_string(output), image, sizeof(image));
+    ck_assert(length < sizeof(image));
+    for (uintptr_t i = 0; i < length; i++) {
+        lisp_object_t truncated = lisp_string_create_bytes(image, i);
+        ck_assert_ptr_eq(lisp_NIL, lisp_image_read(environment, lisp_stream_create_string_input(truncated), &loaded));
+    }
+
+    /* Counts and lengths more than the rest of the image could hold are rejected before allocating. */
+    const char *corrupt[] = {
+        "GLIMAGE\0\1\0\0\0\xff\xff\xff\xff",                  /* 2^32 - 1 objects. */
+        "GLIMAGE\0\1\0\0\0\1\0\0\0S\xff\xff\xff\x7f",      /* A string of 2^31 - 1 characters. */
+        "GLIMAGE\0\1\0\0\0\1\0\0\0V\0\0\0\x10",            /* A vector of 2^28 values. */
+        "GLIMAGE\0\1\0\0\0\1\0\0\0A\xff\xff\xff\xff",      /* An atom name of 2^32 - 1 bytes. */
+        "GLIMAGE\0\1\0\0\0\3\0\0\0CCCO\0\0\0\0",           /* Cells without their contents. */
+    };
+    const uintptr_t lengths[] = { 16, 21, 21, 21, 24 };
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        lisp_object_t bytes = lisp_string_create_bytes(corrupt[i], lengths[i]);
+        ck_assert_ptr_eq(lisp_NIL, lisp_image_read(environment, lisp_stream_create_string_input(bytes), &loaded));
+    }
+
+    /* A corrupt image file can't be loaded. */
+    char path[] = "/tmp/check_image.XXXXXX";
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    ck_assert_int_eq(16, write(fd, corrupt[0], 16));
+    close(fd);
+    lisp_object_t loading = lisp_environment_create(tests_root_environment);
+    ck_assert_ptr_eq(lisp_NIL, lisp_image_load(loading, lisp_string_create_c(path)));
+    unlink(path);
+
+    /* Neither can a valid image that doesn't hold a list of bindings, such as a circular one. */
+    const char *unbindable[] = {
+        "GLIMAGE\0\1\0\0\0\0\0\0\0I\5\0\0\0\0\0\0\0",          /* A fixnum. */
+        "GLIMAGE\0\1\0\0\0\4\0\0\0CCA\1\0\0\0XA\3\0\0\0NIL"
+        "O\1\0\0\0O\0\0\0\0O\2\0\0\0O\3\0\0\0O\0\0\0\0",      /* ((X) (X) ...) */
+    };
+    const uintptr_t unbindable_lengths[] = { 25, 57 };
+    for (size_t i = 0; i < sizeof(unbindable_lengths) / sizeof(unbindable_lengths[0]); i++) {
+        lisp_object_t bytes = lisp_string_create_bytes(unbindable[i], unbindable_lengths[i]);
+        ck_assert_ptr_eq(lisp_T, lisp_image_read(environment, lisp_stream_create_string_input(bytes), &loaded));
+
+        strcpy(path, "/tmp/check_image.XXXXXX");
+        fd = mkstemp(path);
+        ck_assert_int_ge(fd, 0);
+        ck_assert_int_eq((int)unbindable_lengths[i], write(fd, unbindable[i], unbindable_lengths[i]));
+        close(fd);
+        ck_assert_ptr_eq(lisp_NIL, lisp_image_load(loading, lisp_string_create_c(path)));
+        unlink(path);
+    }
+    ck_assert_ptr_eq(lisp_NIL, lisp_environment_find_symbol(loading, lisp_symbol_table_intern(lisp_atom_create_c("X")), lisp_NIL));
+}
+END_TEST
+
+
+/* MARK: - Test Infrastructure */
+
+Suite *image_suite(void)
+{
+    Suite *s = suite_create("Image");
+
+    TCase *tc_images = tcase_create("Images");
+    tcase_add_checked_fixture(tc_images, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_images, test_image_round_trip);
+    tcase_add_test(tc_images, test_image_save_and_load);
+    tcase_add_test(tc_images, test_image_corrupt);
+    suite_add_tcase(s, tc_images);
+
+    return s;
+}
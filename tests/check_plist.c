@@ -82,6 +82,48 @@ START_TEST(test_simple_failed_retrieval)
 END_TEST
 
 
+START_TEST(test_first_retrieval)
+{
+    const lisp_object_t c_then_a[] = { _C, _A };
+    ck_assert_ptr_eq(_D, lisp_plist_get_first(_plist, c_then_a, 2));
+
+    const lisp_object_t b_then_a[] = { _B, _A };
+    ck_assert_ptr_eq(_B, lisp_plist_get_first(_plist, b_then_a, 2));
+
+    /* Symbols are compared for equality, not just identity. */
+    const lisp_object_t other_c[] = { lisp_atom_create_c("C") };
+    ck_assert_ptr_eq(_D, lisp_plist_get_first(_plist, other_c, 1));
+
+    /* A NIL value is the same as no value. */
+    lisp_plist_set(_plist, _C, lisp_NIL);
+    ck_assert_ptr_eq(_B, lisp_plist_get_first(_plist, c_then_a, 2));
+    ck_assert_ptr_eq(lisp_NIL, lisp_plist_get_first(_plist, c_then_a, 1));
+}
+END_TEST
+
+START_TEST(test_removal)
+{
+    lisp_object_t _E = lisp_atom_create_c("E");
+    lisp_plist_set(_plist, _E, _A);
+
+    /* Removing from the middle unlinks the entry. */
+    ck_assert_ptr_eq(lisp_T, lisp_plist_remprop(_plist, _C));
+    ck_assert_ptr_eq(lisp_NIL, lisp_plist_get(_plist, _C));
+    ck_assert_ptr_eq(lisp_NIL, lisp_plist_remprop(_plist, _C));
+
+    /* Removing the first entry keeps the plist itself. */
+    ck_assert_ptr_eq(lisp_T, lisp_plist_remprop(_plist, _A));
+    lisp_print(tests_root_environment, tests_write_stream, _plist);
+    ck_assert_str_eq("((E . A))", tests_write_buffer);
+    tests_clear_write_buffer();
+
+    /* The only entry can't be unlinked, so its value is cleared. */
+    ck_assert_ptr_eq(lisp_T, lisp_plist_remprop(_plist, _E));
+    ck_assert_ptr_eq(lisp_NIL, lisp_plist_get(_plist, _E));
+}
+END_TEST
+
+
 /* MARK: - Test Infrastructure */
 
 Suite *plist_suite(void)
@@ -94,6 +136,8 @@ Suite *plist_suite(void)
     tcase_add_test(tc_plists, test_printing);
     tcase_add_test(tc_plists, test_simple_successful_retrieval);
     tcase_add_test(tc_plists, test_simple_failed_retrieval);
+    tcase_add_test(tc_plists, test_first_retrieval);
+    tcase_add_test(tc_plists, test_removal);
     suite_add_tcase(s, tc_plists);
 
     return s;
@@ -8,8 +8,13 @@
 #include <check.h>
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "genericlisp.h"
+#include "lisp_built_in_sforms.h"
+#include "lisp_built_in_streams.h"
 
 #include "tests_support.h"
 
@@ -84,6 +89,421 @@ START_TEST(test_printing_structure)
 END_TEST
 
 
+/* MARK: - Stream Designators */
+
+START_TEST(test_stream_designators)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    // A stream designates itself, and anything else that isn't T or NIL designates nothing.
+    ck_assert_ptr_eq(tests_write_stream, lisp_stream_best_output_stream(environment, tests_write_stream));
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_best_output_stream(environment, lisp_fixnum_create(1)));
+
+    lisp_object_t standard_output = lisp_stream_best_output_stream(environment, lisp_NIL);
+    ck_assert_ptr_eq(lisp_T, lisp_streamp(standard_output));
+    ck_assert_ptr_eq(standard_output, lisp_stream_best_output_stream(environment, lisp_NIL));
+
+    // Rebinding *STANDARD-OUTPUT* in a child environment is seen through the cache.
+    lisp_object_t child = lisp_environment_create(environment);
+    ck_assert_ptr_eq(standard_output, lisp_stream_best_output_stream(child, lisp_NIL));
+    lisp_environment_set_symbol_value(child, lisp_STANDARD_OUTPUT, lisp_APVAL, tests_write_stream, lisp_NIL);
+    ck_assert_ptr_eq(tests_write_stream, lisp_stream_best_output_stream(child, lisp_NIL));
+    ck_assert_ptr_eq(standard_output, lisp_stream_best_output_stream(environment, lisp_NIL));
+
+    lisp_print(child, lisp_NIL, lisp_cell_list(lisp_fixnum_create(1), lisp_fixnum_create(2), lisp_NIL));
+    ck_assert_str_eq("(1 2)", tests_write_buffer);
+
+    // So is removing it again.
+    lisp_environment_remove_symbol_value(child, lisp_STANDARD_OUTPUT, lisp_APVAL, lisp_NIL);
+    ck_assert_ptr_eq(standard_output, lisp_stream_best_output_stream(child, lisp_NIL));
+
+    // Resolving designators in many environments doesn't grow the cache.
+    lisp_object_t environments[100];
+    for (int i = 0; i < 100; i++) {
+        environments[i] = lisp_environment_create(environment);
+    }
+    uintptr_t available = lisp_heap_available();
+    for (int i = 0; i < 100; i++) {
+        ck_assert_ptr_eq(standard_output, lisp_stream_best_output_stream(environments[i], lisp_NIL));
+    }
+    ck_assert(available == lisp_heap_available());
+}
+END_TEST
+
+
+/* MARK: - Pushback */
+
+START_TEST(test_pushback)
+{
+    lisp_object_t stream = tests_read_stream;
+    tests_set_read_buffer("AB");
+
+    lisp_object_t a = lisp_stream_read_char(stream);
+    lisp_object_t b = lisp_stream_read_char(stream);
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_read_char(stream));
+    ck_assert_ptr_eq(lisp_T, lisp_stream_eofp(stream));
+
+    /* Unreading end-of-stream does nothing, unreading characters works. */
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_unread_char(stream, lisp_NIL));
+    ck_assert_ptr_eq(b, lisp_stream_unread_char(stream, b));
+    ck_assert_ptr_eq(a, lisp_stream_unread_char(stream, a));
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_eofp(stream));
+
+    ck_assert_ptr_eq(a, lisp_stream_peek_char(stream));
+    ck_assert_ptr_eq(a, lisp_stream_read_char(stream));
+    ck_assert_ptr_eq(b, lisp_stream_peek_char(stream));
+    ck_assert_ptr_eq(b, lisp_stream_read_char(stream));
+    ck_assert_ptr_eq(lisp_T, lisp_stream_eofp(stream));
+
+    /* The pushback buffer has a fixed size. */
+    for (int i = 0; i < LISP_STREAM_PUSHBACK_SIZE; i++) {
+        ck_assert_ptr_eq(a, lisp_stream_unread_char(stream, a));
+    }
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_unread_char(stream, b));
+}
+END_TEST
+
+START_TEST(test_stdio_pushback)
+{
+    FILE *file = tmpfile();
+    ck_assert_ptr_nonnull(file);
+    fputs("#\\A", file);
+    rewind(file);
+
+    lisp_object_t stream = lisp_stream_create(lisp_stream_functions_stdio(file));
+    lisp_stream_open(stream, lisp_T, lisp_NIL);
+
+    /* More than the single character ungetc(3) guarantees. */
+    lisp_object_t octothorpe = lisp_stream_read_char(stream);
+    lisp_object_t backslash = lisp_stream_read_char(stream);
+    lisp_stream_unread_char(stream, backslash);
+    lisp_stream_unread_char(stream, octothorpe);
+
+    lisp_object_t read_object = lisp_read(tests_root_environment, stream, lisp_NIL);
+    ck_assert_ptr_eq(lisp_char_create('A'), read_object);
+
+    lisp_stream_close(stream);
+}
+END_TEST
+
+
+/* MARK: - String Streams */
+
+START_TEST(test_string_input_stream)
+{
+    lisp_object_t environment = tests_root_environment;
+
+    lisp_object_t input = lisp_stream_create_string_input(lisp_string_create_c("(A 12) \"B\""));
+    ck_assert_ptr_ne(lisp_NIL, input);
+
+    lisp_object_t list = lisp_read(environment, input, lisp_NIL);
+    lisp_object_t string = lisp_read(environment, input, lisp_NIL);
+    ck_assert_ptr_eq(lisp_T, lisp_stream_eofp(input));
+
+    lisp_print(environment, tests_write_stream, list);
+    lisp_print(environment, tests_write_stream, string);
+    ck_assert_str_eq("(A 12)B", tests_write_buffer);
+}
+END_TEST
+
+START_TEST(test_string_input_stream_writing)
+{
+    lisp_object_t source = lisp_string_create_c("AB");
+    lisp_object_t input = lisp_stream_create_string_input(source);
+
+    /* Writing to an input stream fails and leaves its string alone. */
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_write_char(input, lisp_char_create('C')));
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_write_string(input, lisp_string_create_c("DE")));
+    ck_assert_uint_eq(2, lisp_string_get_value(source)->length);
+    ck_assert_ptr_eq(lisp_char_create('A'), lisp_stream_read_char(input));
+}
+END_TEST
+
+START_TEST(test_string_input_stream_reading_until_finished)
+{
+    lisp_object_t environment = tests_root_environment;
+
+    lisp_object_t input = lisp_stream_create_string_input(lisp_string_create_c(" (A) ; one\nB\n; the end\n\n"));
+
+    /* Only the whitespace and comments after the last form are left, so there are just two forms. */
+    ck_assert_ptr_eq(lisp_NIL, lisp_read_finishedp(environment, input));
+    ck_assert_ptr_eq(lisp_T, lisp_equal(lisp_cell_list(lisp_atom_create_c("A"), lisp_NIL), lisp_read(environment, input, lisp_NIL)));
+    ck_assert_ptr_eq(lisp_NIL, lisp_read_finishedp(environment, input));
+    ck_assert_ptr_eq(lisp_symbol_table_intern(lisp_atom_create_c("B")), lisp_read(environment, input, lisp_NIL));
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_eofp(input));
+    ck_assert_ptr_eq(lisp_T, lisp_read_finishedp(environment, input));
+    ck_assert_ptr_eq(lisp_T, lisp_stream_eofp(input));
+}
+END_TEST
+
+START_TEST(test_string_output_stream)
+{
+    lisp_object_t environment = tests_root_environment;
+
+    lisp_object_t output = lisp_stream_create_string_output();
+
+    /* Write enough to force the string to grow several times. */
+    for (int i = 0; i < 100; i++) {
+        lisp_stream_write_char(output, lisp_char_create('x'));
+    }
+    lisp_object_t xs = lisp_stream_get_output_string(output);
+    ck_assert_int_eq(100, lisp_string_get_value(xs)->length);
+
+    /* Getting the string starts over with a new one. */
+    lisp_print(environment, output, lisp_fixnum_create(42));
+    lisp_object_t answer = lisp_stream_get_output_string(output);
+    ck_assert_ptr_eq(lisp_T, lisp_equal(lisp_string_create_c("42"), answer));
+    ck_assert_int_eq(100, lisp_string_get_value(xs)->length);
+
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_get_output_string(tests_write_stream));
+}
+END_TEST
+
+START_TEST(test_evaluating_WITH_OUTPUT_TO_STRING)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer(
+     "(with-output-to-string (s)\n"
+     "  (prin1 'abc s)\n"
+     "  (prin1 (read (make-string-input-stream \"(1 2)\")) s))\n");
+    lisp_object_t form = lisp_read(environment, tests_read_stream, lisp_NIL);
+    lisp_object_t result = lisp_eval(environment, form);
+
+    ck_assert_ptr_eq(lisp_T, lisp_stringp(result));
+    ck_assert_ptr_eq(lisp_T, lisp_equal(lisp_string_create_c("ABC(1 2)"), result));
+}
+END_TEST
+
+
+/* MARK: - File Streams */
+
+START_TEST(test_file_stream_round_trip)
+{
+    char path[] = "/tmp/check_stream.XXXXXX";
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    close(fd);
+
+    lisp_object_t path_string = lisp_string_create_c(path);
+
+    lisp_object_t output = lisp_stream_open_file(path_string, lisp_atom_create_c(":OUTPUT"));
+    ck_assert_ptr_ne(lisp_NIL, output);
+    ck_assert_ptr_eq(lisp_T, lisp_stream_openp(output));
+    lisp_stream_write_string(output, lisp_string_create_c("XY"));
+    lisp_stream_close(output);
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_openp(output));
+
+    lisp_object_t input = lisp_stream_open_file(path_string, lisp_atom_create_c(":INPUT"));
+    ck_assert_ptr_ne(lisp_NIL, input);
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_eofp(input));
+
+    lisp_object_t x = lisp_stream_read_char(input);
+    ck_assert_ptr_eq(lisp_char_create('X'), x);
+    lisp_stream_unread_char(input, x);
+    ck_assert_ptr_eq(lisp_char_create('X'), lisp_stream_peek_char(input));
+    ck_assert_ptr_eq(lisp_char_create('X'), lisp_stream_read_char(input));
+    ck_assert_ptr_eq(lisp_char_create('Y'), lisp_stream_read_char(input));
+    ck_assert_ptr_eq(lisp_NIL, lisp_stream_read_char(input));
+    ck_assert_ptr_eq(lisp_T, lisp_stream_eofp(input));
+    lisp_stream_close(input);
+
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_file_stream_direction_flags)
+{
+    ck_assert_int_eq(lisp_stream_flags_readable,
+                     lisp_stream_flags_for_direction(lisp_NIL));
+    ck_assert_int_eq(lisp_stream_flags_readable,
+                     lisp_stream_flags_for_direction(lisp_atom_create_c(":INPUT")));
+    ck_assert_int_eq(lisp_stream_flags_writable,
+                     lisp_stream_flags_for_direction(lisp_atom_create_c(":OUTPUT")));
+    ck_assert_int_eq(lisp_stream_flags_readable | lisp_stream_flags_writable,
+                     lisp_stream_flags_for_direction(lisp_atom_create_c(":IO")));
+    ck_assert_int_eq(0, lisp_stream_flags_for_direction(lisp_atom_create_c(":SIDEWAYS")));
+
+    lisp_object_t missing = lisp_stream_open_file(lisp_string_create_c("/nonexistent/file"),
+                                                  lisp_atom_create_c(":INPUT"));
+    ck_assert_ptr_eq(lisp_NIL, missing);
+}
+END_TEST
+
+START_TEST(test_mapped_file_stream)
+{
+    char path[] = "/tmp/check_stream.XXXXXX";
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    ck_assert_int_eq(3, write(fd, "#\\A", 3));
+
+    /* An empty file can't be mapped, but this one can. */
+    lisp_object_t functions = lisp_stream_functions_mmap(fd);
+    ck_assert_ptr_ne(lisp_NIL, functions);
+    lisp_object_t input = lisp_stream_create(functions);
+    lisp_stream_open(input, lisp_T, lisp_NIL);
+
+    /* Unreading several characters in a row just backs up the offset. */
+    lisp_object_t octothorpe = lisp_stream_read_char(input);
+    lisp_object_t backslash = lisp_stream_read_char(input);
+    lisp_stream_unread_char(input, backslash);
+    lisp_stream_unread_char(input, octothorpe);
+    ck_assert_ptr_eq(lisp_char_create('#'), lisp_stream_read_char(input));
+    ck_assert_ptr_eq(lisp_char_create('\\'), lisp_stream_read_char(input));
+    ck_assert_ptr_eq(lisp_char_create('A'), lisp_stream_peek_char(input));
+    ck_assert_ptr_eq(lisp_char_create('A'), lisp_stream_read_char(input));
+    ck_assert_ptr_eq(lisp_T, lisp_stream_eofp(input));
+
+    lisp_stream_close(input);
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_reading_buffered_file_streams)
+{
+    char path[] = "/tmp/check_stream.XXXXXX";
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+
+    /* A comment longer than a file buffer forces at least one refill. */
+    const size_t comment_length = 70000;
+    char *comment = malloc(comment_length);
+    memset(comment, 'x', comment_length);
+    comment[0] = ';';
+    comment[comment_length - 1] = '\n';
+    ck_assert_int_eq(comment_length, write(fd, comment, comment_length));
+    free(comment);
+
+    const char *contents = "(abc -12 \"xy\" \"a\\\"b\" +q 12a) tail";
+    ck_assert_int_eq(strlen(contents), write(fd, contents, strlen(contents)));
+
+    /* Read the same file through both kinds of buffered stream, each of which closes its own descriptor. */
+    for (int i = 0; i < 2; i++) {
+        int input_fd = dup(fd);
+        lseek(input_fd, 0, SEEK_SET);
+        lisp_object_t functions = (i == 0) ? lisp_stream_functions_mmap(input_fd) : lisp_stream_functions_fd(input_fd);
+        lisp_object_t input = lisp_stream_create(functions);
+        lisp_stream_open(input, lisp_T, lisp_NIL);
+
+        lisp_object_t list = lisp_read(tests_root_environment, input, lisp_NIL);
+        tests_clear_write_buffer();
+        lisp_print(tests_root_environment, tests_write_stream, list);
+        ck_assert_str_eq("(ABC -12 \"xy\" \"a\\\"b\" +Q 12 A)", tests_write_buffer);
+
+        lisp_object_t tail = lisp_read(tests_root_environment, input, lisp_NIL);
+        ck_assert_str_eq("TAIL", lisp_atom_get_value(tail));
+        ck_assert_ptr_eq(lisp_T, lisp_stream_eofp(input));
+
+        lisp_stream_close(input);
+    }
+
+    close(fd);
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_evaluating_LOAD)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    char path[] = "/tmp/check_stream.XXXXXX";
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    const char *contents = "(setq a 1)\n; comment\n(setq b (+ a 1))\n";
+    ck_assert_int_eq(strlen(contents), write(fd, contents, strlen(contents)));
+    close(fd);
+
+    lisp_object_t loaded = lisp_eval(environment,
+                                     lisp_cell_list(lisp_atom_create_c("LOAD"),
+                                                    lisp_string_create_c(path),
+                                                    lisp_NIL));
+    ck_assert_ptr_eq(lisp_T, loaded);
+
+    lisp_object_t B_value = lisp_environment_get_symbol_value(environment,
+                                                              lisp_atom_create_c("B"),
+                                                              lisp_APVAL,
+                                                              lisp_NIL);
+    ck_assert_ptr_eq(lisp_fixnum_create(2), B_value);
+
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_evaluating_WITH_OPEN_FILE)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    char path[] = "/tmp/check_stream.XXXXXX";
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    close(fd);
+
+    char source[256];
+    snprintf(source, sizeof(source),
+             "(with-open-file (s \"%s\" :direction :output)\n"
+             "  (prin1 '(a (b) 3) s))\n"
+             "(with-open-file (s \"%s\" :direction :input)\n"
+             "  (read s))\n",
+             path, path);
+    tests_set_read_buffer(source);
+
+    lisp_object_t write_form = lisp_read(environment, tests_read_stream, lisp_NIL);
+    lisp_eval(environment, write_form);
+
+    lisp_object_t read_form = lisp_read(environment, tests_read_stream, lisp_NIL);
+    lisp_object_t read_back = lisp_eval(environment, read_form);
+
+    lisp_print(environment, tests_write_stream, read_back);
+    ck_assert_str_eq("(A (B) 3)", tests_write_buffer);
+
+    unlink(path);
+}
+END_TEST
+
+START_TEST(test_evaluating_OPEN)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    char path[] = "/tmp/check_stream.XXXXXX";
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    close(fd);
+
+    /* A path longer than any fixed buffer still names the same file. */
+    char long_path[2048] = "/tmp";
+    while (strlen(long_path) < 1500) {
+        strcat(long_path, "/.");
+    }
+    strcat(long_path, path + 4);
+
+    char source[4096];
+    snprintf(source, sizeof(source),
+             "(setq s (open \"%s\" :direction :output))\n"
+             "(prin1 'written s)\n"
+             "(close s)\n"
+             "(close s)\n"
+             "(open \"%s\" :output)\n"
+             "(setq s (open \"%s\"))\n"
+             "(read s)\n",
+             long_path, path, path);
+    tests_set_read_buffer(source);
+
+    const char *expected[] = { NULL, "WRITTEN", "T", "NIL", "NIL", NULL, "WRITTEN" };
+    for (int i = 0; i < 7; i++) {
+        lisp_object_t form = lisp_read(environment, tests_read_stream, lisp_NIL);
+        lisp_object_t value = lisp_eval(environment, form);
+        if (expected[i] != NULL) {
+            tests_clear_write_buffer();
+            lisp_print(environment, tests_write_stream, value);
+            ck_assert_str_eq(expected[i], tests_write_buffer);
+        }
+    }
+
+    unlink(path);
+}
+END_TEST
+
+
 /* MARK: - Test Infrastructure */
 
 Suite *stream_suite(void)
@@ -99,5 +519,36 @@ Suite *stream_suite(void)
     tcase_add_test(tc_streams, test_printing_structure);
     suite_add_tcase(s, tc_streams);
 
+    TCase *tc_stream_designators = tcase_create("Stream Designators");
+    tcase_add_checked_fixture(tc_stream_designators, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_stream_designators, test_stream_designators);
+    suite_add_tcase(s, tc_stream_designators);
+
+    TCase *tc_pushback = tcase_create("Pushback");
+    tcase_add_checked_fixture(tc_pushback, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_pushback, test_pushback);
+    tcase_add_test(tc_pushback, test_stdio_pushback);
+    suite_add_tcase(s, tc_pushback);
+
+    TCase *tc_string_streams = tcase_create("String Streams");
+    tcase_add_checked_fixture(tc_string_streams, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_string_streams, test_string_input_stream);
+    tcase_add_test(tc_string_streams, test_string_input_stream_writing);
+    tcase_add_test(tc_string_streams, test_string_input_stream_reading_until_finished);
+    tcase_add_test(tc_string_streams, test_string_output_stream);
+    tcase_add_test(tc_string_streams, test_evaluating_WITH_OUTPUT_TO_STRING);
+    suite_add_tcase(s, tc_string_streams);
+
+    TCase *tc_file_streams = tcase_create("File Streams");
+    tcase_add_checked_fixture(tc_file_streams, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_file_streams, test_file_stream_round_trip);
+    tcase_add_test(tc_file_streams, test_file_stream_direction_flags);
+    tcase_add_test(tc_file_streams, test_mapped_file_stream);
+    tcase_add_test(tc_file_streams, test_reading_buffered_file_streams);
+    tcase_add_test(tc_file_streams, test_evaluating_LOAD);
+    tcase_add_test(tc_file_streams, test_evaluating_WITH_OPEN_FILE);
+    tcase_add_test(tc_file_streams, test_evaluating_OPEN);
+    suite_add_tcase(s, tc_file_streams);
+
     return s;
 }
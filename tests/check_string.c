@@ -47,6 +47,33 @@ START_TEST(test_printing)
 }
 END_TEST
 
+START_TEST(test_printing_quoted)
+{
+    lisp_object_t object = lisp_string_create_c("say \"hi\" \\ bye");
+    lisp_string_t string_value = lisp_string_get_value(object);
+    lisp_string_print_quoted(tests_write_stream, string_value, lisp_T);
+    ck_assert_str_eq("\"say \\\"hi\\\" \\\\ bye\"", tests_write_buffer);
+    tests_clear_write_buffer();
+
+    /* Strings longer than a chunk are printed in several runs. */
+    char long_cstring[601];
+    for (int i = 0; i < 600; i++) {
+        long_cstring[i] = (i % 100 == 99) ? '"' : (char)('a' + (i % 26));
+    }
+    long_cstring[600] = '\0';
+    lisp_object_t long_string = lisp_string_create_c(long_cstring);
+    lisp_string_print(tests_write_stream, lisp_string_get_value(long_string));
+    ck_assert_str_eq(long_cstring, tests_write_buffer);
+
+    /* What's printed quoted reads back as the same string. */
+    tests_clear_write_buffer();
+    lisp_print_object(tests_root_environment, tests_write_stream, lisp_cell_list(object, lisp_NIL));
+    tests_set_read_buffer(tests_write_buffer);
+    lisp_object_t read_list = lisp_read(tests_root_environment, tests_read_stream, lisp_NIL);
+    ck_assert_ptr_eq(lisp_T, lisp_string_equal(object, lisp_cell_car(read_list)));
+}
+END_TEST
+
 START_TEST(test_equality)
 {
     lisp_object_t abc = lisp_string_create_c("ABC");
@@ -111,6 +138,7 @@ Suite *string_suite(void)
     tcase_add_checked_fixture(tc_strings, tests_shared_setup, tests_shared_teardown);
     tcase_add_test(tc_strings, test_creation);
     tcase_add_test(tc_strings, test_printing);
+    tcase_add_test(tc_strings, test_printing_quoted);
     tcase_add_test(tc_strings, test_equality);
     tcase_add_test(tc_strings, test_reading);
     tcase_add_test(tc_strings, test_reallocation);
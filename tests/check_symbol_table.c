@@ -0,0 +1,112 @@
+/*
+    File:       check_symbol_table.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include <check.h>
+
+#include <stdio.h>
+
+#include "genericlisp.h"
+#include "lisp_built_in_sforms.h"
+
+#include "tests_support.h"
+
+
+/* MARK: - Symbol Table */
+
+START_TEST(test_interning)
+{
+    lisp_object_t foo = lisp_symbol_table_intern_bytes("foo", 3);
+    ck_assert_int_eq(lisp_tag_atom, lisp_object_get_tag(foo));
+    ck_assert_str_eq("FOO", lisp_atom_get_value(foo));
+
+    /* Names are case-insensitive and need not be terminated. */
+    ck_assert_ptr_eq(foo, lisp_symbol_table_intern_bytes("FOOBAR", 3));
+    ck_assert_ptr_eq(foo, lisp_symbol_table_find_bytes("Foo", 3));
+    ck_assert_ptr_eq(foo, lisp_symbol_table_intern(lisp_atom_create_c("foo")));
+
+    ck_assert_ptr_eq(lisp_NIL, lisp_symbol_table_find_bytes("FO", 2));
+}
+END_TEST
+
+START_TEST(test_well_known_symbols)
+{
+    ck_assert_ptr_eq(lisp_T, lisp_symbol_table_find_bytes("T", 1));
+    ck_assert_ptr_eq(lisp_NIL, lisp_symbol_table_find_bytes("NIL", 3));
+    ck_assert_ptr_eq(lisp_symbol_QUOTE, lisp_symbol_table_find_bytes("quote", 5));
+}
+END_TEST
+
+START_TEST(test_growth)
+{
+    uintptr_t initial_count = lisp_symbol_table_count();
+
+    char name[16];
+    for (int i = 0; i < 1000; i++) {
+        int length = snprintf(name, sizeof(name), "SYMBOL-%d", i);
+        lisp_symbol_table_intern_bytes(name, (uintptr_t) length);
+    }
+    ck_assert_int_eq(initial_count + 1000, lisp_symbol_table_count());
+
+    /* Everything interned before the table grew is still found. */
+    for (int i = 0; i < 1000; i++) {
+        int length = snprintf(name, sizeof(name), "symbol-%d", i);
+        lisp_object_t atom = lisp_symbol_table_find_bytes(name, (uintptr_t) length);
+        ck_assert_ptr_ne(lisp_NIL, atom);
+    }
+    ck_assert_ptr_eq(lisp_T, lisp_symbol_table_find_bytes("T", 1));
+}
+END_TEST
+
+START_TEST(test_reading_does_not_bind)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer("(foo foo quote)");
+    lisp_object_t read_object = lisp_read(environment, tests_read_stream, lisp_NIL);
+    ck_assert(tests_eofp_read_buffer());
+
+    lisp_object_t first = lisp_cell_car(read_object);
+    lisp_object_t second = lisp_cell_car(lisp_cell_cdr(read_object));
+    lisp_object_t third = lisp_cell_car(lisp_cell_cdr(lisp_cell_cdr(read_object)));
+    ck_assert_ptr_eq(first, second);
+    ck_assert_ptr_eq(lisp_symbol_QUOTE, third);
+
+    ck_assert_ptr_eq(lisp_NIL, lisp_environment_find_symbol(environment, first, lisp_T));
+}
+END_TEST
+
+START_TEST(test_reading_bound_symbol)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    lisp_object_t bar = lisp_atom_create_c("BAR");
+    lisp_environment_set_symbol_value(environment, bar, lisp_APVAL, lisp_fixnum_create(1), lisp_NIL);
+
+    tests_set_read_buffer("bar ");
+    lisp_object_t read_object = lisp_read(environment, tests_read_stream, lisp_NIL);
+    ck_assert_ptr_eq(bar, read_object);
+}
+END_TEST
+
+
+/* MARK: - Test Infrastructure */
+
+Suite *symbol_table_suite(void)
+{
+    Suite *s = suite_create("Symbol Table");
+
+    TCase *tc_symbol_table = tcase_create("Symbol Table");
+    tcase_add_checked_fixture(tc_symbol_table, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_symbol_table, test_interning);
+    tcase_add_test(tc_symbol_table, test_well_known_symbols);
+    tcase_add_test(tc_symbol_table, test_growth);
+    tcase_add_test(tc_symbol_table, test_reading_does_not_bind);
+    tcase_add_test(tc_symbol_table, test_reading_bound_symbol);
+    suite_add_tcase(s, tc_symbol_table);
+
+    return s;
+}
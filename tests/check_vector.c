@@ -0,0 +1,171 @@
+/*
+    File:       check_vector.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include <check.h>
+
+#include "genericlisp.h"
+
+#include "tests_support.h"
+
+
+/* MARK: - Vectors */
+
+START_TEST(test_creation)
+{
+    lisp_object_t vector = lisp_vector_create(3, lisp_T);
+    ck_assert_int_eq(lisp_tag_vector, lisp_object_get_tag(vector));
+    ck_assert_ptr_eq(lisp_T, lisp_vectorp(vector));
+
+    lisp_vector_t vector_value = lisp_vector_get_value(vector);
+    ck_assert_int_eq(3, vector_value->count);
+    ck_assert_ptr_eq(lisp_T, lisp_vector_ref(vector, 0));
+    ck_assert_ptr_eq(lisp_T, lisp_vector_ref(vector, 2));
+    ck_assert_ptr_eq(lisp_NIL, lisp_vector_ref(vector, 3));
+}
+END_TEST
+
+START_TEST(test_setting)
+{
+    lisp_object_t vector = lisp_vector_create(2, lisp_NIL);
+
+    ck_assert_ptr_eq(lisp_T, lisp_vector_set(vector, 1, lisp_T));
+    ck_assert_ptr_eq(lisp_NIL, lisp_vector_ref(vector, 0));
+    ck_assert_ptr_eq(lisp_T, lisp_vector_ref(vector, 1));
+
+    /* Setting out of range does nothing. */
+    ck_assert_ptr_eq(lisp_NIL, lisp_vector_set(vector, 2, lisp_T));
+    ck_assert_int_eq(2, lisp_vector_get_value(vector)->count);
+}
+END_TEST
+
+START_TEST(test_push_extend)
+{
+    lisp_object_t vector = lisp_vector_create(0, lisp_NIL);
+    lisp_vector_t vector_value = lisp_vector_get_value(vector);
+
+    for (uintptr_t i = 0; i < 100; i++) {
+        ck_assert_int_eq(i, lisp_vector_push_extend(vector, lisp_fixnum_create(i)));
+    }
+    ck_assert_int_eq(100, vector_value->count);
+    ck_assert_int_ge(vector_value->capacity, 100);
+    ck_assert_int_lt(vector_value->capacity, 200);
+
+    for (uintptr_t i = 0; i < 100; i++) {
+        ck_assert_ptr_eq(lisp_fixnum_create(i), lisp_vector_ref(vector, i));
+    }
+}
+END_TEST
+
+START_TEST(test_printing)
+{
+    lisp_object_t list = lisp_cell_list(lisp_fixnum_create(1), lisp_atom_create_c("A"), lisp_NIL);
+    lisp_object_t vector = lisp_vector_create_from_list(list);
+
+    lisp_print(tests_root_environment, tests_write_stream, vector);
+    ck_assert_str_eq("#(1 A)", tests_write_buffer);
+}
+END_TEST
+
+START_TEST(test_equality)
+{
+    lisp_object_t list = lisp_cell_list(lisp_fixnum_create(1), lisp_fixnum_create(2), lisp_NIL);
+    lisp_object_t a = lisp_vector_create_from_list(list);
+    lisp_object_t b = lisp_vector_create_from_list(list);
+    lisp_object_t c = lisp_vector_create_from_list(lisp_cell_cdr(list));
+
+    ck_assert_ptr_eq(lisp_T, lisp_equal(a, b));
+    ck_assert_ptr_eq(lisp_NIL, lisp_equal(a, c));
+}
+END_TEST
+
+START_TEST(test_reading)
+{
+    tests_set_read_buffer("#(1 a (b) #(2) \"s\")");
+    lisp_object_t read_object = lisp_read(tests_root_environment, tests_read_stream, lisp_NIL);
+    ck_assert(tests_eofp_read_buffer());
+    ck_assert_ptr_eq(lisp_T, lisp_vectorp(read_object));
+    ck_assert_int_eq(5, lisp_vector_get_value(read_object)->count);
+    ck_assert_ptr_eq(lisp_T, lisp_vectorp(lisp_vector_ref(read_object, 3)));
+
+    lisp_print(tests_root_environment, tests_write_stream, read_object);
+    ck_assert_str_eq("#(1 A (B) #(2) \"s\")", tests_write_buffer);
+}
+END_TEST
+
+START_TEST(test_reading_empty)
+{
+    tests_set_read_buffer("(#() x)");
+    lisp_object_t read_object = lisp_read(tests_root_environment, tests_read_stream, lisp_NIL);
+    lisp_object_t vector = lisp_cell_car(read_object);
+    ck_assert_ptr_eq(lisp_T, lisp_vectorp(vector));
+    ck_assert_int_eq(0, lisp_vector_get_value(vector)->count);
+}
+END_TEST
+
+
+/* MARK: - Evaluation */
+
+START_TEST(test_evaluating_vector_SUBRs)
+{
+    lisp_object_t environment = lisp_environment_create(tests_root_environment);
+
+    tests_set_read_buffer("(setq v (make-vector 3 0))\n"
+                          "(aset v 1 'b)\n"
+                          "(vector-push-extend 'd v)\n"
+                          "(aref v 1)\n"
+                          "(length v)\n"
+                          "(aref (vector 'x 'y) 5)\n"
+                          "v\n");
+
+    lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+
+    lisp_object_t set_value = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("B", lisp_atom_get_value(set_value));
+
+    lisp_object_t index = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(3), index);
+
+    lisp_object_t element = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_str_eq("B", lisp_atom_get_value(element));
+
+    lisp_object_t length = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_fixnum_create(4), length);
+
+    lisp_object_t out_of_range = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    ck_assert_ptr_eq(lisp_NIL, out_of_range);
+
+    lisp_object_t vector = lisp_eval(environment, lisp_read(environment, tests_read_stream, lisp_NIL));
+    lisp_print(environment, tests_write_stream, vector);
+    ck_assert_str_eq("#(0 B 0 D)", tests_write_buffer);
+}
+END_TEST
+
+
+/* MARK: - Test Infrastructure */
+
+Suite *vector_suite(void)
+{
+    Suite *s = suite_create("Vector");
+
+    TCase *tc_vectors = tcase_create("Vectors");
+    tcase_add_checked_fixture(tc_vectors, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_vectors, test_creation);
+    tcase_add_test(tc_vectors, test_setting);
+    tcase_add_test(tc_vectors, test_push_extend);
+    tcase_add_test(tc_vectors, test_printing);
+    tcase_add_test(tc_vectors, test_equality);
+    tcase_add_test(tc_vectors, test_reading);
+    tcase_add_test(tc_vectors, test_reading_empty);
+    suite_add_tcase(s, tc_vectors);
+
+    TCase *tc_evaluation = tcase_create("Evaluation");
+    tcase_add_checked_fixture(tc_evaluation, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_evaluation, test_evaluating_vector_SUBRs);
+    suite_add_tcase(s, tc_evaluation);
+
+    return s;
+}
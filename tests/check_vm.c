@@ -0,0 +1,181 @@
+/*
+    File:       check_vm.c
+
+    Copyright:  © 2025 Christopher M. Hanson. All rights reserved.
+                See file COPYING for details.
+ */
+
+#include <check.h>
+
+#include <pthread.h>
+
+#include "genericlisp.h"
+#include "lisp_built_in_streams.h"
+
+#include "tests_support.h"
+
+
+/* MARK: - Virtual Machines */
+
+/**
+ Read and evaluate every form in the given text in a virtual machine,
+ making it current, and return the value of the last one.
+ */
+static lisp_object_t check_vm_eval(lisp_vm_t vm, const char *text)
+{
+    lisp_vm_set_current(vm);
+    lisp_object_t environment = lisp_vm_get_environment(vm);
+    lisp_object_t stream = lisp_stream_create_string_input(lisp_string_create_c(text));
+
+    lisp_object_t value = lisp_NIL;
+    while (lisp_stream_eofp(stream) == lisp_NIL) {
+        lisp_object_t form = lisp_read(environment, stream, lisp_NIL);
+        value = lisp_eval(environment, form);
+    }
+    return value;
+}
+
+START_TEST(test_vm_isolation)
+{
+    lisp_vm_t other_vm = lisp_vm_create(1048576);
+    ck_assert_ptr_eq(other_vm, lisp_vm_current);
+
+    ck_assert_ptr_eq(lisp_fixnum_create(2), check_vm_eval(other_vm, "(setq x 2) x"));
+    lisp_object_t other_x = check_vm_eval(other_vm, "'x");
+
+    /* Each has its own bindings and its own atoms, but the same root. */
+    ck_assert_ptr_eq(lisp_NIL, check_vm_eval(tests_vm, "(setq y 1) x"));
+    lisp_object_t x = check_vm_eval(tests_vm, "'x");
+    ck_assert_ptr_ne(other_x, x);
+    ck_assert_ptr_eq(lisp_T, lisp_equal(other_x, x));
+    ck_assert_ptr_eq(check_vm_eval(tests_vm, "'car"), check_vm_eval(other_vm, "'car"));
+    ck_assert_ptr_eq(lisp_NIL, check_vm_eval(other_vm, "y"));
+
+    lisp_vm_dispose(other_vm);
+    ck_assert_ptr_eq(NULL, lisp_vm_current);
+    lisp_vm_set_current(tests_vm);
+}
+END_TEST
+
+START_TEST(test_vm_creation_failure)
+{
+    /* A heap that can't be allocated means no virtual machine, and no change to the current one. */
+    ck_assert_ptr_eq(NULL, lisp_vm_create(UINTPTR_MAX / 2));
+    ck_assert_ptr_eq(tests_vm, lisp_vm_current);
+}
+END_TEST
+
+/** Run a virtual machine of its own in a thread, and return what it computed. */
+static void *check_vm_thread(void *argument)
+{
+    lisp_vm_t vm = lisp_vm_create(1048576);
+    lisp_object_t value = check_vm_eval(vm,
+                                        "(defun fib (n) (cond ((< n 2) n) (t (+ (fib (- n 1)) (fib (- n 2))))))\n"
+                                        "(fib 15)");
+    lisp_fixnum_t result = (lisp_fixnump(value) != lisp_NIL) ? lisp_fixnum_get_value(value) : -1;
+    lisp_vm_dispose(vm);
+    return (void *)(intptr_t)result;
+}
+
+START_TEST(test_vm_threads)
+{
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        ck_assert_int_eq(0, pthread_create(&threads[i], NULL, check_vm_thread, NULL));
+    }
+    for (int i = 0; i < 4; i++) {
+        void *result = NULL;
+        ck_assert_int_eq(0, pthread_join(threads[i], &result));
+        ck_assert_int_eq(610, (intptr_t)result);
+    }
+
+    /* The virtual machines in other threads don't affect this one. */
+    ck_assert_ptr_eq(tests_vm, lisp_vm_current);
+}
+END_TEST
+
+/** Create and freeze a virtual machine defining a function and some data to share. */
+static lisp_vm_t check_vm_create_shared(void)
+{
+    lisp_vm_t shared_vm = lisp_vm_create(1048576);
+    check_vm_eval(shared_vm,
+                  "(defun fib (n) (cond ((< n 2) n) (t (+ (fib (- n 1)) (fib (- n 2))))))\n"
+                  "(setq data '(1 2 3))");
+    lisp_vm_freeze(shared_vm);
+    return shared_vm;
+}
+
+START_TEST(test_vm_sharing)
+{
+    lisp_vm_t shared_vm = check_vm_create_shared();
+    ck_assert_ptr_eq(NULL, lisp_vm_current);
+
+    /* What the frozen virtual machine defines is shared, not copied. */
+    lisp_vm_t vm = lisp_vm_create_sharing(1048576, shared_vm);
+    ck_assert_ptr_eq(lisp_fixnum_create(55), check_vm_eval(vm, "(fib 10)"));
+    lisp_object_t data = check_vm_eval(vm, "data");
+    ck_assert_int_eq(1, lisp_heap_sharedp(data));
+    ck_assert_int_eq(1, lisp_heap_sharedp(check_vm_eval(vm, "'data")));
+    ck_assert_int_eq(0, lisp_heap_sharedp(check_vm_eval(vm, "'other")));
+
+    /* Setting a shared binding shadows it, and removing one fails. */
+    ck_assert_ptr_eq(lisp_fixnum_create(5), check_vm_eval(vm, "(setq data 5) (makunbound 'fib) data"));
+    ck_assert_ptr_eq(lisp_fixnum_create(8), check_vm_eval(vm, "(fib 6)"));
+
+    lisp_vm_t other_vm = lisp_vm_create_sharing(1048576, shared_vm);
+    ck_assert_ptr_eq(data, check_vm_eval(other_vm, "data"));
+
+    lisp_vm_dispose(other_vm);
+    lisp_vm_dispose(vm);
+    lisp_vm_dispose(shared_vm);
+    lisp_vm_set_current(tests_vm);
+}
+END_TEST
+
+/** Run a virtual machine sharing the given one in a thread, and return what it computed. */
+static void *check_vm_sharing_thread(void *argument)
+{
+    lisp_vm_t vm = lisp_vm_create_sharing(1048576, argument);
+    lisp_object_t value = check_vm_eval(vm, "(fib 15)");
+    lisp_fixnum_t result = (lisp_fixnump(value) != lisp_NIL) ? lisp_fixnum_get_value(value) : -1;
+    lisp_vm_dispose(vm);
+    return (void *)(intptr_t)result;
+}
+
+START_TEST(test_vm_sharing_threads)
+{
+    lisp_vm_t shared_vm = check_vm_create_shared();
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        ck_assert_int_eq(0, pthread_create(&threads[i], NULL, check_vm_sharing_thread, shared_vm));
+    }
+    for (int i = 0; i < 4; i++) {
+        void *result = NULL;
+        ck_assert_int_eq(0, pthread_join(threads[i], &result));
+        ck_assert_int_eq(610, (intptr_t)result);
+    }
+
+    lisp_vm_dispose(shared_vm);
+    lisp_vm_set_current(tests_vm);
+}
+END_TEST
+
+
+/* MARK: - Test Infrastructure */
+
+Suite *vm_suite(void)
+{
+    Suite *s = suite_create("VM");
+
+    TCase *tc_vm = tcase_create("VM");
+    tcase_add_checked_fixture(tc_vm, tests_shared_setup, tests_shared_teardown);
+    tcase_add_test(tc_vm, test_vm_isolation);
+    tcase_add_test(tc_vm, test_vm_creation_failure);
+    tcase_add_test(tc_vm, test_vm_threads);
+    tcase_add_test(tc_vm, test_vm_sharing);
+    tcase_add_test(tc_vm, test_vm_sharing_threads);
+    suite_add_tcase(s, tc_vm);
+
+    return s;
+}
@@ -12,6 +12,7 @@
 #include <string.h>
 
 
+lisp_vm_t tests_vm = NULL;
 lisp_object_t tests_root_environment = NULL;
 
 lisp_object_t tests_read_stream = NULL;
@@ -28,9 +29,8 @@ static lisp_object_t tests_charbuf_stream_functions(char *buf, size_t len);
 
 void tests_shared_setup(void)
 {
-    lisp_heap_initialize(1048576);
-
-    tests_root_environment = lisp_environment_create_root();
+    tests_vm = lisp_vm_create(1048576);
+    tests_root_environment = lisp_vm_get_environment(tests_vm);
 
     tests_read_buffer = calloc(4096, sizeof(char));
     tests_read_buffer_functions = tests_charbuf_stream_functions(tests_read_buffer, 4096);
@@ -55,9 +55,7 @@ void tests_shared_teardown(void)
     lisp_stream_close(tests_write_stream);
     free(tests_write_buffer);
 
-    lisp_environment_dispose(tests_root_environment);
-
-    lisp_heap_finalize();
+    lisp_vm_dispose(tests_vm);
 }
 
 
@@ -134,30 +132,6 @@ static lisp_object_t tests_charbuf_stream_read_char(lisp_object_t stream)
     return character;
 }
 
-static lisp_object_t tests_charbuf_stream_unread_char(lisp_object_t stream, lisp_object_t character)
-{
-    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
-    lisp_interior_t metadata_object = lisp_interior_get_value(functions->metadata);
-    struct tests_charbuf_stream_metadata *metadata = (struct tests_charbuf_stream_metadata *)metadata_object;
-
-    if (metadata->is_open == false) {
-        // TODO: Signal an error
-        return lisp_NIL;
-    }
-
-    if (metadata->is_readable && (metadata->r_pos > 0)) {
-        lisp_char_t character_value = lisp_char_get_value(character);
-        char ch = (char)character_value;
-
-        metadata->r_pos -= 1;
-    } else {
-        // TODO: Raise an error
-        return lisp_NIL;
-    }
-
-    return character;
-}
-
 static lisp_object_t tests_charbuf_stream_write_char(lisp_object_t stream, lisp_object_t character)
 {
     lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
@@ -175,6 +149,7 @@ static lisp_object_t tests_charbuf_stream_write_char(lisp_object_t stream, lisp_
 
         metadata->buf[metadata->w_pos] = ch;
         metadata->w_pos += 1;
+        metadata->buf[metadata->w_pos] = '\0';
     }
 
     return stream;
@@ -202,6 +177,33 @@ static lisp_object_t tests_charbuf_stream_eofp(lisp_object_t stream)
 }
 
 
+static const unsigned char *tests_charbuf_stream_buffer(lisp_object_t stream, uintptr_t *length)
+{
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    lisp_interior_t metadata_object = lisp_interior_get_value(functions->metadata);
+    struct tests_charbuf_stream_metadata *metadata = (struct tests_charbuf_stream_metadata *)metadata_object;
+
+    if ((metadata->is_open == false) || (metadata->is_readable == false)) {
+        return NULL;
+    }
+
+    if (metadata->r_pos == metadata->len) {
+        return NULL;
+    }
+
+    *length = metadata->len - metadata->r_pos;
+    return (const unsigned char *)&metadata->buf[metadata->r_pos];
+}
+
+static void tests_charbuf_stream_consume(lisp_object_t stream, uintptr_t count)
+{
+    lisp_stream_functions_t functions = lisp_stream_get_functions(stream);
+    lisp_interior_t metadata_object = lisp_interior_get_value(functions->metadata);
+    struct tests_charbuf_stream_metadata *metadata = (struct tests_charbuf_stream_metadata *)metadata_object;
+
+    metadata->r_pos += count;
+}
+
 static lisp_object_t tests_charbuf_stream_functions(char *buf, size_t len)
 {
     lisp_stream_functions_t underlying_functions;
@@ -209,9 +211,12 @@ static lisp_object_t tests_charbuf_stream_functions(char *buf, size_t len)
     underlying_functions->open = tests_charbuf_stream_open;
     underlying_functions->close = tests_charbuf_stream_close;
     underlying_functions->read_char = tests_charbuf_stream_read_char;
-    underlying_functions->unread_char = tests_charbuf_stream_unread_char;
     underlying_functions->write_char = tests_charbuf_stream_write_char;
     underlying_functions->eofp = tests_charbuf_stream_eofp;
+    underlying_functions->buffer = tests_charbuf_stream_buffer;
+    underlying_functions->consume = tests_charbuf_stream_consume;
+    underlying_functions->write_bytes = NULL;
+    underlying_functions->remaining = NULL;
     struct tests_charbuf_stream_metadata *metadata;
     underlying_functions->metadata = lisp_interior_create(sizeof(struct tests_charbuf_stream_metadata), (void **)&metadata);
     metadata->buf = buf;
@@ -236,6 +241,9 @@ void tests_set_read_buffer(char *value)
     metadata->r_pos = 0;
     metadata->w_pos = 0;
     metadata->len = strlen(value);
+
+    // Discard anything the previous read left pushed back on the stream.
+    lisp_stream_get_value(tests_read_stream)->pushback_count = 0;
 }
 
 
@@ -249,6 +257,8 @@ void tests_clear_read_buffer(void)
     metadata->r_pos = 0;
     metadata->w_pos = 0;
     metadata->len = 0;
+
+    lisp_stream_get_value(tests_read_stream)->pushback_count = 0;
 }
 
 
@@ -258,7 +268,8 @@ bool tests_eofp_read_buffer(void)
     lisp_interior_t metadata_object = lisp_interior_get_value(functions->metadata);
     struct tests_charbuf_stream_metadata *metadata = (struct tests_charbuf_stream_metadata *)metadata_object;
 
-    return (metadata->r_pos == metadata->len);
+    return (metadata->r_pos == metadata->len)
+        && (lisp_stream_get_value(tests_read_stream)->pushback_count == 0);
 }
 
 
@@ -280,15 +291,23 @@ int main(int argc, char **argv)
     Suite *s = suite_create("genericlisp");
     SRunner *sr = srunner_create(s);
 
+    srunner_add_suite(sr, array_suite());
     srunner_add_suite(sr, atom_suite());
+    srunner_add_suite(sr, batch_suite());
+    srunner_add_suite(sr, binary_suite());
     srunner_add_suite(sr, cell_suite());
     srunner_add_suite(sr, char_suite());
     srunner_add_suite(sr, environment_suite());
     srunner_add_suite(sr, evaluation_suite());
     srunner_add_suite(sr, fixnum_suite());
+    srunner_add_suite(sr, hash_table_suite());
+    srunner_add_suite(sr, image_suite());
     srunner_add_suite(sr, plist_suite());
     srunner_add_suite(sr, stream_suite());
     srunner_add_suite(sr, string_suite());
+    srunner_add_suite(sr, symbol_table_suite());
+    srunner_add_suite(sr, vector_suite());
+    srunner_add_suite(sr, vm_suite());
 
     srunner_run_all(sr, CK_VERBOSE);
     int number_failed = srunner_ntests_failed(sr);
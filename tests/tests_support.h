@@ -15,6 +15,7 @@
 #include "genericlisp.h"
 
 
+LISP_EXTERN lisp_vm_t tests_vm;
 LISP_EXTERN lisp_object_t tests_root_environment;
 
 
@@ -38,15 +39,23 @@ LISP_EXTERN void tests_shared_teardown(void);
 
 /* Test Suites */
 
+LISP_EXTERN Suite *array_suite(void);
 LISP_EXTERN Suite *atom_suite(void);
+LISP_EXTERN Suite *batch_suite(void);
+LISP_EXTERN Suite *binary_suite(void);
 LISP_EXTERN Suite *cell_suite(void);
 LISP_EXTERN Suite *char_suite(void);
 LISP_EXTERN Suite *environment_suite(void);
 LISP_EXTERN Suite *evaluation_suite(void);
 LISP_EXTERN Suite *fixnum_suite(void);
+LISP_EXTERN Suite *hash_table_suite(void);
+LISP_EXTERN Suite *image_suite(void);
 LISP_EXTERN Suite *plist_suite(void);
 LISP_EXTERN Suite *stream_suite(void);
 LISP_EXTERN Suite *string_suite(void);
+LISP_EXTERN Suite *symbol_table_suite(void);
+LISP_EXTERN Suite *vector_suite(void);
+LISP_EXTERN Suite *vm_suite(void);
 
 
 #endif /* __tests_support__ */